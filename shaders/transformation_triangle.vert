@@ -4,6 +4,7 @@ layout (set = 0, binding = 0) uniform UniformBuffer {
     mat4 model;       // glm::mat4
     mat4 view;        // glm::mat4
     mat4 projection;  // glm::mat4
+    vec4 textureRect; // glm::vec4 - offset (xy) and scale (zw) of the UVs
 } transformation;
 
 layout (location = 0) in vec3 inPosition;   // Vertex attributes
@@ -16,5 +17,5 @@ layout (location = 1) out vec2 outTexCoord; // Texture coordinates
 void main() {
     gl_Position = transformation.projection * transformation.view * transformation.model * vec4(inPosition, 1.0);
     outFragment = inColor;
-    outTexCoord = inTexCoord;
+    outTexCoord = transformation.textureRect.xy + inTexCoord * transformation.textureRect.zw;
 }
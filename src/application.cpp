@@ -6,13 +6,23 @@
 //
 
 #include "application.hpp"
+#include "engine/asset_archive.hpp"
+#include "engine/asset_manifest.hpp"
+#include "engine/graphics/texture_file.hpp"
 #include "engine/graphics/transform.hpp" // Should be elsewhere
+#include "engine/graphics/upload_batch.hpp"
 #include "ftstd/debug_tools.h"
+#include "ftstd/mapped_file.hpp"
 #include "ftstd/profile_tools.h"
+#include "ftstd/thread_pool.hpp"
 #include "project.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <iterator>
 #include <stdio.h>
+#include <vector>
 
 #ifdef IMGUI
 #include "backends/imgui_impl_glfw.h"
@@ -26,6 +36,9 @@ extern char S_APP_VERSION[18];
 extern char S_ENGINE_VERSION[18];
 #endif
 
+/// @brief Folder of the meshes - watched for hot-reload with the asset folders
+static constexpr const char* MODELS_FOLDER = "MODELS";
+
 frametech::Application* frametech::Application::m_instance{nullptr};
 
 frametech::Application::Application(const char* app_title)
@@ -249,6 +262,28 @@ void frametech::Application::drawDebugToolImGui()
             ImGui::TreePop();
             ImGui::Separator();
         }
+        if (ImGui::TreeNode("Startup"))
+        {
+            if (m_time_to_first_frame.has_value())
+                ImGui::Text("Time to first frame: %llu ms", m_time_to_first_frame.value());
+            if (m_time_to_game_assets.has_value())
+                ImGui::Text("Time to game assets: %llu ms", m_time_to_game_assets.value());
+            else if (m_game_assets_loading.m_in_progress)
+                ImGui::Text("Loading game assets: %zu / %zu", m_game_assets_loading.m_nb_registered_entries, m_game_assets_loading.m_decoded.size());
+            ImGui::TreePop();
+            ImGui::Separator();
+        }
+        if (ImGui::TreeNode("Texture streaming"))
+        {
+            const frametech::engine::graphics::TextureResidencyStats residency_stats = m_world.getTextureResidency().getStats();
+            ImGui::Text("Resident textures: %u / %u", residency_stats.m_resident, residency_stats.m_registered);
+            ImGui::Text("Video memory: %llu / %llu MB", residency_stats.m_resident_size >> 20, residency_stats.m_budget >> 20);
+            ImGui::Text("Loads: %llu", residency_stats.m_loads);
+            ImGui::Text("Evictions: %llu", residency_stats.m_evictions);
+            ImGui::Text("Pending destructions: %u", residency_stats.m_pending_destructions);
+            ImGui::TreePop();
+            ImGui::Separator();
+        }
 #ifdef PROFILE
         if (ImGui::TreeNode("Timers"))
         {
@@ -309,40 +344,78 @@ void frametech::Application::drawDebugToolImGui()
         }
         // Only one object (mesh) for the moment, so should be ok
         // But this could be way better if the World object handles itself the objects / meshes
-        const frametech::graphics::Mesh c_mesh = m_engine->m_render->getGraphicsPipeline()->getMesh();
+        const frametech::graphics::Mesh& c_mesh = m_engine->m_render->getGraphicsPipeline()->getMesh();
         if (ImGui::TreeNode(c_mesh.m_name))
         {
             ImGui::Text("Name: '%s'", c_mesh.m_name);
-            ImGui::Text("%llu vertices", c_mesh.m_vertices.size());
+            ImGui::Text("%llu vertices", c_mesh.getVerticesCount());
+            if (c_mesh.m_source != nullptr)
+                ImGui::Text("Mapped from its binary mesh file");
             if (ImGui::TreeNode("Vertices"))
             {
-                const auto vertices = m_engine->m_render->getGraphicsPipeline()->getVertices();
-                size_t i = 0;
-                for (const auto vertex : vertices)
+                const frametech::engine::graphics::shaders::Vertex* vertices = c_mesh.getVertexData();
+                for (size_t i = 0; i < c_mesh.getVerticesCount(); ++i)
                 {
                     char vertex_str[80];
-                    frametech::engine::graphics::shaders::VertexUtils::toString(vertex_str, vertex);
+                    frametech::engine::graphics::shaders::VertexUtils::toString(vertex_str, vertices[i]);
                     ImGui::Text("%zu:", i);
                     ImGui::SameLine(50);
                     ImGui::Text("%s", vertex_str);
-                    ++i;
                 }
                 ImGui::TreePop();
                 ImGui::Separator();
             }
-            ImGui::Text("%llu indices", c_mesh.m_indices.size());
+            ImGui::Text("%llu indices (%s)", c_mesh.getIndicesCount(), m_engine->m_render->getGraphicsPipeline()->getIndexType() == VK_INDEX_TYPE_UINT16 ? "16 bits" : "32 bits");
             if (ImGui::TreeNode("Indices"))
             {
-                const auto indices = m_engine->m_render->getGraphicsPipeline()->getIndices();
-                u32 i = 0;
-                for (const auto index : indices)
+                const u32* indices = c_mesh.getIndexData();
+                for (u32 i = 0; i < c_mesh.getIndicesCount(); ++i)
                 {
-                    ImGui::Text("%u: vertex %d", i, index);
-                    ++i;
+                    ImGui::Text("%u: vertex %d", i, indices[i]);
                 }
                 ImGui::TreePop();
                 ImGui::Separator();
             }
+            ImGui::Text("%llu submeshes, %llu materials", c_mesh.getSubmeshesCount(), c_mesh.getMaterialsCount());
+            if (ImGui::TreeNode("Submeshes"))
+            {
+                const auto pipeline = m_engine->m_render->getGraphicsPipeline();
+                for (u64 i = 0; i < c_mesh.getSubmeshesCount(); ++i)
+                {
+                    const frametech::graphics::Submesh submesh = c_mesh.getSubmesh(i);
+                    const frametech::graphics::MeshLod lod = c_mesh.getLod(submesh, pipeline->getLod(i));
+                    ImGui::Text("%llu: material '%s', %u vertices from %d", i, c_mesh.getMaterialName(submesh.m_material), submesh.m_vertices_count, submesh.m_vertex_offset);
+                    ImGui::SameLine();
+                    ImGui::Text("- level of detail %u / %llu (%u triangles, error %g)", pipeline->getLod(i), c_mesh.getLodsCount(submesh) - 1, lod.m_indices_count / 3, static_cast<f64>(lod.m_error));
+                }
+                ImGui::TreePop();
+                ImGui::Separator();
+            }
+            if (c_mesh.getMaxLodsCount() > 1)
+            {
+                const auto pipeline = m_engine->m_render->getGraphicsPipeline();
+                bool automatic_lod = !pipeline->getLodOverride().has_value();
+                if (ImGui::Checkbox("Automatic level of detail", &automatic_lod))
+                    pipeline->setLodOverride(automatic_lod ? std::nullopt : std::optional<u32>(pipeline->getLod(0)));
+                if (!automatic_lod)
+                {
+                    int forced_lod = static_cast<int>(pipeline->getLodOverride().value_or(0));
+                    if (ImGui::SliderInt("Forced level of detail", &forced_lod, 0, static_cast<int>(c_mesh.getMaxLodsCount() - 1)))
+                        pipeline->setLodOverride(static_cast<u32>(forced_lod));
+                }
+            }
+            if (c_mesh.getMeshletsCount() > 0)
+            {
+                const auto pipeline = m_engine->m_render->getGraphicsPipeline();
+                bool meshlet_culling = pipeline->isMeshletCullingEnabled();
+                if (ImGui::Checkbox("Cull the meshlets", &meshlet_culling))
+                    pipeline->setMeshletCulling(meshlet_culling);
+                const frametech::graphics::MeshletCullingStatistics& culling_statistics = pipeline->getMeshletCullingStatistics();
+                ImGui::Text("Visible meshlets: %u / %llu", culling_statistics.m_visible_meshlets, c_mesh.getMeshletsCount());
+                ImGui::Text("Drawn triangles: %llu / %llu", culling_statistics.m_visible_triangles, culling_statistics.m_triangles);
+                ImGui::Text("Culled triangles: %.1f %%", 100.0f * culling_statistics.getCulledTriangleRatio());
+                ImGui::Text("Draw calls: %zu", pipeline->getDrawRanges().size());
+            }
             ImGui::TreePop();
             ImGui::Separator();
         }
@@ -380,7 +453,7 @@ void frametech::Application::drawMeshSelectionImGui()
                 {
                     previously_selected_idx = item_current_idx;
                     ImGui::SetItemDefaultFocus();
-                    m_engine->m_render->getGraphicsPipeline()->setMesh2D(frametech::graphics::Mesh2D(item_current_idx));
+                    selectMesh(frametech::graphics::Mesh2D(item_current_idx));
                 }
             }
             ImGui::EndListBox();
@@ -479,69 +552,511 @@ bool frametech::Application::initEngine()
 void frametech::Application::initDescriptorSets()
 {
     assert(nullptr != m_engine);
+    // Sampled until the game textures are loaded
+    if (m_world.createPlaceholderTexture().IsError())
+        LogE("Cannot create the placeholder texture");
     m_engine->m_render->getGraphicsPipeline()->createDescriptorSets();
 }
 
 ftstd::VResult frametech::Application::loadGameAssets() noexcept
 {
-    // The game world **should not** be loaded
-    assert(!m_world.hasBeenSetup());
+    // The game assets **should not** be loaded twice
+    assert(!m_game_assets_loading.m_in_progress && m_game_assets_loading.m_entries.empty());
     if (GAME_APPLICATION_SETTINGS->asset_folders.empty())
     {
         LogW("No assets have been set for this application");
         return ftstd::VResult::Ok();
     }
-    for (const std::string& asset_lib_name : GAME_APPLICATION_SETTINGS->asset_folders)
+    ftstd::profile::ScopedProfileMarker scope((char*)"frametech::Application::loadGameAssets");
+    m_world.getTextureResidency().setBudget(GAME_APPLICATION_SETTINGS->texture_budget_mb.has_value()
+                                                ? static_cast<u64>(GAME_APPLICATION_SETTINGS->texture_budget_mb.value()) * 1024 * 1024
+                                                : frametech::engine::graphics::TextureResidency::DEFAULT_VRAM_BUDGET);
+    GameAssetsLoading& loading = m_game_assets_loading;
+    loading.m_timer.reset();
+    loading.m_in_progress = true;
+
+    // Scan the asset folders and archives on a worker, one folder per job
+    loading.m_scanned = ftstd::ThreadPool::getInstance()->submit([&entries = loading.m_entries]() {
+        const std::vector<std::string>& asset_folders = GAME_APPLICATION_SETTINGS->asset_folders;
+        std::vector<std::vector<AssetEntry>> folders_entries(asset_folders.size());
+        ftstd::ThreadPool::getInstance()->parallelFor(asset_folders.size(), [&asset_folders, &folders_entries](const size_t folder_index) {
+            const std::string& asset_lib_name = asset_folders[folder_index];
+            std::error_code error;
+            if (!std::filesystem::exists(asset_lib_name, error))
+            {
+                LogE("Error checking for asset folder '%s' : does not exists", asset_lib_name.c_str());
+                return;
+            }
+            // An archive is listed from its table of contents, without opening any other file
+            if (frametech::engine::AssetArchive::isAssetArchive(asset_lib_name.c_str()))
+            {
+                auto archive = std::make_shared<frametech::engine::AssetArchive>();
+                if (archive->open(asset_lib_name.c_str()).IsError())
+                {
+                    LogE("Error opening the asset archive '%s'", asset_lib_name.c_str());
+                    return;
+                }
+                for (u32 entry_index = 0; entry_index < archive->size(); ++entry_index)
+                {
+                    const frametech::engine::AssetArchiveEntry& archive_entry = archive->getEntry(entry_index);
+                    const std::string name = std::string(archive->getName(archive_entry));
+                    if (frametech::engine::graphics::TextureFile::isTextureFile(name.c_str()))
+                        continue;
+                    AssetEntry asset_entry{
+                        .m_path = name,
+                        .m_filename = std::filesystem::path(name).filename().string(),
+                        .m_archive = archive,
+                        .m_size = archive_entry.m_size,
+                    };
+                    folders_entries[folder_index].push_back(std::move(asset_entry));
+                }
+                return;
+            }
+            if (!std::filesystem::is_directory(asset_lib_name, error))
+            {
+                LogE("Error checking for asset folder '%s' : is not a directory", asset_lib_name.c_str());
+                return;
+            }
+            // A cooked folder (see ftcook) is listed from its manifest, without touching the files
+            const std::filesystem::path manifest_path = std::filesystem::path(asset_lib_name) / frametech::engine::AssetManifest::ASSET_MANIFEST_FILENAME;
+            if (std::filesystem::exists(manifest_path, error))
+            {
+                frametech::engine::AssetManifest manifest;
+                if (const auto result = manifest.read(manifest_path.string().c_str()); result.IsError())
+                {
+                    LogE("Error reading the manifest of the asset folder '%s'", asset_lib_name.c_str());
+                    return;
+                }
+                for (const frametech::engine::AssetManifestEntry& manifest_entry : manifest.getEntries())
+                {
+                    if (frametech::engine::CookedAssetType::TEXTURE != manifest_entry.m_type)
+                        continue;
+                    AssetEntry asset_entry{
+                        .m_path = (std::filesystem::path(asset_lib_name) / manifest_entry.m_output).string(),
+                        .m_filename = std::filesystem::path(manifest_entry.m_source).filename().string(),
+                        .m_size = manifest_entry.m_file_size,
+                    };
+                    folders_entries[folder_index].push_back(std::move(asset_entry));
+                }
+                return;
+            }
+            for (const auto& entry : std::filesystem::directory_iterator(asset_lib_name, error))
+            {
+                // Texture files are cache entries, not assets
+                if (!entry.is_regular_file(error) || frametech::engine::graphics::TextureFile::isTextureFile(entry.path().string().c_str()))
+                    continue;
+                AssetEntry asset_entry{
+                    .m_path = entry.path().string(),
+                    .m_filename = entry.path().filename().string(),
+                    .m_size = static_cast<u64>(entry.file_size(error)),
+                };
+                folders_entries[folder_index].push_back(std::move(asset_entry));
+            }
+        });
+        for (std::vector<AssetEntry>& folder_entries : folders_entries)
+            std::move(folder_entries.begin(), folder_entries.end(), std::back_inserter(entries));
+    });
+    return ftstd::VResult::Ok();
+}
+
+void frametech::Application::applyGameAssetLoads() noexcept
+{
+    GameAssetsLoading& loading = m_game_assets_loading;
+    if (!loading.m_in_progress)
+        return;
+    ftstd::profile::ScopedProfileMarker scope((char*)"frametech::Application::applyGameAssetLoads");
+    ftstd::ThreadPool* thread_pool = ftstd::ThreadPool::getInstance();
+    const bool compress_textures = m_engine->m_graphics_device.supportsTextureCompressionBC();
+
+    if (loading.m_scanned.valid())
     {
-        if (!std::filesystem::exists(asset_lib_name))
+        if (std::future_status::ready != loading.m_scanned.wait_for(std::chrono::seconds(0)))
+            return;
+        loading.m_scanned.get();
+        loading.m_scan_time = loading.m_timer.diff();
+        // Map, decode and compress the files on the workers, one job per file - no Vulkan call in there
+        loading.m_decoded.reserve(loading.m_entries.size());
+        for (AssetEntry& entry : loading.m_entries)
         {
-            LogE("Error checking for asset folder '%s' : does not exists", asset_lib_name.c_str());
-            continue;
+            loading.m_decoded.push_back(thread_pool->submit([&entry, compress_textures]() {
+                Log("Checking for asset file with name '%s'", entry.m_path.c_str());
+
+                // A cooked texture file (see ftcook) is mapped as is: decoded, mipmapped and compressed offline
+                if (nullptr == entry.m_archive && frametech::engine::graphics::TextureFile::isTextureFile(entry.m_path.c_str()))
+                {
+                    entry.m_texture = new frametech::engine::graphics::Texture();
+                    if (entry.m_texture->readTextureFile(entry.m_path.c_str(), entry.m_filename).IsError())
+                    {
+                        LogE("Error reading the cooked texture with path '%s'", entry.m_path.c_str());
+                        return;
+                    }
+                    if (entry.m_texture->isCompressed() && !compress_textures)
+                    {
+                        LogE("The device cannot sample the compressed texture '%s' - cook the assets with --no-compress", entry.m_path.c_str());
+                        return;
+                    }
+                    entry.m_packed = !entry.m_texture->isCompressed() &&
+                                     frametech::engine::graphics::TextureAtlas::accepts(entry.m_texture->getWidth(), entry.m_texture->getHeight());
+                    entry.m_decode_settings = frametech::engine::graphics::TextureDecodeSettings{
+                        .m_supports_alpha = true,
+                        .m_srgb = true,
+                        .m_compress = entry.m_texture->isCompressed(),
+                    };
+                    entry.m_decoded = true;
+                    return;
+                }
+                frametech::engine::AssetContent contents;
+                const auto opened = nullptr != entry.m_archive ? contents.open(entry.m_archive, entry.m_path)
+                                                               : contents.open(entry.m_path.c_str());
+                if (opened.IsError())
+                {
+                    LogE("Error opening file with path '%s'", entry.m_path.c_str());
+                    return;
+                }
+                if (contents.isEmpty())
+                {
+                    LogW("Asset file with path '%s' is empty", entry.m_path.c_str());
+                    return;
+                }
+
+                // The texture is deleted by the main thread if the decoding fails,
+                // as its destructor goes through the engine
+                entry.m_texture = new frametech::engine::graphics::Texture();
+                // Small textures keep their texels, to be copied in an atlas page
+                int width = 0;
+                int height = 0;
+                entry.m_packed = frametech::engine::graphics::Texture::getImageSize(contents.data(), static_cast<int>(contents.size()), width, height) &&
+                                 frametech::engine::graphics::TextureAtlas::accepts(static_cast<u32>(width), static_cast<u32>(height));
+                // Goes through the texture cache: a warm start only maps the cached mip chains.
+                // If the compression fails, the decoded texels are uploaded as they are.
+                entry.m_decode_settings = frametech::engine::graphics::TextureDecodeSettings{
+                    .m_supports_alpha = true,
+                    .m_srgb = true,
+                    .m_compress = compress_textures && !entry.m_packed,
+                };
+                entry.m_decoded = !entry.m_texture->load(contents.data(),
+                                                         static_cast<int>(contents.size()),
+                                                         entry.m_decode_settings,
+                                                         entry.m_filename)
+                                       .IsError();
+            }));
         }
+    }
 
-        if (!std::filesystem::is_directory(asset_lib_name)) {
-            LogE("Error checking for asset folder '%s' : is not a directory", asset_lib_name.c_str());
+    // Registrations stay on the main thread, in the scan order
+    frametech::engine::graphics::TextureResidency& texture_residency = m_world.getTextureResidency();
+    const std::string previously_selected_texture = m_world.getSelectedTexture();
+    for (; loading.m_nb_registered_entries < loading.m_entries.size(); ++loading.m_nb_registered_entries)
+    {
+        std::future<void>& decoded = loading.m_decoded[loading.m_nb_registered_entries];
+        if (std::future_status::ready != decoded.wait_for(std::chrono::seconds(0)))
+            break;
+        decoded.get();
+        AssetEntry& entry = loading.m_entries[loading.m_nb_registered_entries];
+        if (nullptr == entry.m_texture || !entry.m_decoded)
+            continue;
+        if (entry.m_packed && !loading.m_atlas.add(entry.m_filename, entry.m_texture).IsError())
+            continue;
+        // Standalone textures are streamed: the decoded texture is in the texture cache, and
+        // is uploaded once requested
+        delete entry.m_texture;
+        entry.m_texture = nullptr;
+        const frametech::engine::graphics::TextureHandle texture_handle = texture_residency.add(entry.m_path, entry.m_decode_settings, entry.m_filename, entry.m_archive);
+        // Two asset folders can hold a file with the same name: the last one wins
+        m_world.setTextureRegion(entry.m_filename, frametech::engine::graphics::TextureRegion{.m_texture = texture_handle});
+        m_world.setSelectedTexture(entry.m_filename);
+        ++loading.m_nb_loaded_textures;
+    }
+    if (loading.m_nb_registered_entries < loading.m_entries.size())
+    {
+        // The frame that used the previous descriptors is done
+        if (previously_selected_texture != m_world.getSelectedTexture())
+            m_engine->m_render->getGraphicsPipeline()->updateDescriptorSets(false);
+        return;
+    }
+    const u64 decode_time = loading.m_timer.diff() - loading.m_scan_time;
+
+    // Pack the small textures together, then upload the pages like any other texture
+    const size_t nb_packed_textures = loading.m_atlas.size();
+    std::vector<frametech::engine::graphics::Texture*> atlas_pages;
+    std::map<std::string, frametech::engine::graphics::TextureRegion> atlas_regions;
+    if (nb_packed_textures > 0 && loading.m_atlas.build(atlas_pages, atlas_regions).IsError())
+        LogE("Cannot build the texture atlas pages");
+    // The pages are built from the packed textures: they cannot be streamed
+    std::vector<frametech::engine::graphics::TextureHandle> atlas_page_handles(atlas_pages.size(), frametech::engine::graphics::INVALID_TEXTURE_HANDLE);
+    // All the pages are uploaded with one submission
+    frametech::graphics::UploadBatch upload_batch(*m_engine->m_render->getTransfertCommand()->getPool());
+    const bool is_batch_recording = !atlas_pages.empty() && !upload_batch.begin().IsError();
+    for (size_t page_index = 0; page_index < atlas_pages.size(); ++page_index)
+    {
+        frametech::engine::graphics::Texture* atlas_page = atlas_pages[page_index];
+        if (compress_textures)
+            atlas_page->compressCached();
+        if (!is_batch_recording || atlas_page->upload(upload_batch, frametech::engine::graphics::Texture::Type::T2D, VK_FORMAT_R8G8B8A8_SRGB).IsError())
+        {
+            delete atlas_page;
+            atlas_pages[page_index] = nullptr;
+        }
+    }
+    const bool is_batch_submitted = is_batch_recording && !upload_batch.submit().IsError();
+    if (is_batch_recording && !is_batch_submitted)
+        LogE("Cannot submit the upload of the texture atlas pages");
+    // Not waited for: the graphics queue waits for the upload before sampling a page
+    for (size_t page_index = 0; page_index < atlas_pages.size(); ++page_index)
+    {
+        if (nullptr == atlas_pages[page_index])
+            continue;
+        if (!is_batch_submitted)
+        {
+            delete atlas_pages[page_index];
             continue;
         }
+        atlas_page_handles[page_index] = texture_residency.addResident(atlas_pages[page_index]);
+    }
+    for (auto& [texture_name, texture_region] : atlas_regions)
+    {
+        texture_region.m_texture = atlas_page_handles[texture_region.m_texture];
+        if (frametech::engine::graphics::INVALID_TEXTURE_HANDLE == texture_region.m_texture)
+            continue;
+        // Also streamed on its own, for the meshes with UVs out of [0, 1] - loaded on request only
+        for (const AssetEntry& entry : loading.m_entries)
+        {
+            if (entry.m_packed && entry.m_filename == texture_name)
+                texture_region.m_standalone_texture = texture_residency.add(entry.m_path, entry.m_decode_settings, entry.m_filename, entry.m_archive);
+        }
+        m_world.setTextureRegion(texture_name, texture_region);
+        m_world.setSelectedTexture(texture_name);
+        ++loading.m_nb_loaded_textures;
+    }
+    // The texels of the packed textures have been copied in the pages
+    for (AssetEntry& entry : loading.m_entries)
+    {
+        delete entry.m_texture;
+        entry.m_texture = nullptr;
+    }
+    const u64 total_time = loading.m_timer.diff();
+    loading.m_in_progress = false;
+    m_time_to_game_assets = m_app_timer->diff();
+
+    Log("> Loaded %u textures (%zu packed in %zu atlas pages) out of %zu asset files in %llu ms (scan: %llu ms, decode and compress on %u threads: %llu ms, atlas upload: %llu ms) - %llu ms after the start",
+        loading.m_nb_loaded_textures,
+        nb_packed_textures,
+        atlas_pages.size(),
+        loading.m_entries.size(),
+        total_time,
+        loading.m_scan_time,
+        thread_pool->size(),
+        decode_time,
+        total_time - decode_time - loading.m_scan_time,
+        m_time_to_game_assets.value());
+    // Samples the last registered texture instead of the placeholder
+    m_engine->m_render->getGraphicsPipeline()->updateDescriptorSets(false);
+    watchGameAssets();
+}
 
-        for (const auto& entry : std::filesystem::directory_iterator(asset_lib_name)) {
-            const std::string entry_string = entry.path().string();
-            const std::string entry_filename = entry.path().filename().string();
-            const char* entry_name = entry_string.c_str();
-            const auto entry_size = entry.file_size();
-            Log("Checking for asset file with name '%s'", entry_name);
+void frametech::Application::waitAssetLoads() noexcept
+{
+    GameAssetsLoading& loading = m_game_assets_loading;
+    if (loading.m_scanned.valid())
+        loading.m_scanned.wait();
+    for (std::future<void>& decoded : loading.m_decoded)
+    {
+        if (decoded.valid())
+            decoded.wait();
+    }
+    for (AssetEntry& entry : loading.m_entries)
+    {
+        delete entry.m_texture;
+        entry.m_texture = nullptr;
+    }
+    loading.m_in_progress = false;
+    // The reloads write in their texture and mesh
+    for (AssetReload& reload : m_asset_reloads)
+    {
+        reload.m_loaded.wait();
+        delete reload.m_texture;
+    }
+    m_asset_reloads.clear();
+}
 
-            char* contents = new char[entry_size];
+void frametech::Application::selectMesh(const frametech::graphics::Mesh2D mesh_type) noexcept
+{
+    m_selected_mesh = mesh_type;
+    if (frametech::graphics::Mesh2D::FROM_FILE != mesh_type)
+    {
+        m_engine->m_render->getGraphicsPipeline()->setMesh2D(mesh_type);
+        return;
+    }
+    // Already loading
+    for (const AssetReload& reload : m_asset_reloads)
+    {
+        if (reload.m_is_mesh_selection)
+            return;
+    }
+    Log("> Loading the mesh '%s' in the background...", frametech::graphics::DEFAULT_MESH_FILE);
+    AssetReload reload{
+        .m_path = frametech::graphics::DEFAULT_MESH_FILE,
+        .m_mesh = std::make_unique<frametech::graphics::Mesh>(),
+        .m_is_mesh_selection = true,
+    };
+    reload.m_loaded = ftstd::ThreadPool::getInstance()->submit([mesh = reload.m_mesh.get()]() {
+        const auto result = frametech::graphics::MeshUtils::loadFromFile(frametech::graphics::DEFAULT_MESH_FILE);
+        if (result.IsError())
+            return false;
+        *mesh = result.GetValue();
+        return true;
+    });
+    m_asset_reloads.push_back(std::move(reload));
+}
 
-            FILE* pFile = fopen(entry_name, "rb");
-            if (NULL == pFile) {
-                fclose(pFile);
-                delete[] contents;
-                LogE("Error opening file with path '%s'", entry_name);
-            }
-            fread(contents, 1, entry_size, pFile);
-
-            m_world.m_textures_cache[entry_filename.c_str()] = new frametech::engine::graphics::Texture();
-            if (m_world.m_textures_cache[entry_filename.c_str()]->setup(contents,
-                (int)entry_size,
-                true,
-                frametech::engine::graphics::Texture::Type::T2D,
-                VK_FORMAT_R8G8B8A8_SRGB,
-                entry_filename.c_str())
-                .IsError())
-            {
-                m_world.m_textures_cache.erase(entry_filename.c_str());
-            }
-            else
-            {
-                m_world.setSelectedTexture(entry_filename.c_str());
-            }
+void frametech::Application::watchGameAssets() noexcept
+{
+    if (!ftstd::FileWatcher::isSupported())
+    {
+        LogW("Asset hot-reload is not supported on this platform");
+        return;
+    }
+    // The meshes are loaded from the models folder, even if it is not an asset folder
+    std::vector<std::string> watched_folders = GAME_APPLICATION_SETTINGS->asset_folders;
+    watched_folders.emplace_back(MODELS_FOLDER);
+    std::vector<std::filesystem::path> watched_paths;
+    for (const std::string& folder : watched_folders)
+    {
+        const std::filesystem::path folder_path = std::filesystem::path(folder).lexically_normal();
+        std::error_code error;
+        if (!std::filesystem::is_directory(folder_path, error) ||
+            std::find(watched_paths.begin(), watched_paths.end(), folder_path) != watched_paths.end())
+            continue;
+        if (m_asset_watcher.watch(folder).IsError())
+            continue;
+        watched_paths.push_back(folder_path);
+        Log("> Watching the asset folder '%s'", folder.c_str());
+    }
+}
 
-            fclose(pFile);
-            delete[] contents;
+void frametech::Application::reloadChangedAssets() noexcept
+{
+    std::vector<std::string> changed_paths;
+    m_asset_watcher.poll(changed_paths);
+    if (changed_paths.empty())
+        return;
+    ftstd::ThreadPool* thread_pool = ftstd::ThreadPool::getInstance();
+    const bool compress_textures = m_engine->m_graphics_device.supportsTextureCompressionBC();
+    const std::filesystem::path mesh_path = std::filesystem::path(m_engine->m_render->getGraphicsPipeline()->getMeshPath()).lexically_normal();
+    for (const std::string& changed_path : changed_paths)
+    {
+        const std::filesystem::path path = std::filesystem::path(changed_path).lexically_normal();
+        // A cooked texture file (see ftcook) is named after its source file: 'name.png.ftex' for 'name.png'
+        const bool is_texture_file = frametech::engine::graphics::TextureFile::isTextureFile(changed_path.c_str());
+        const std::string filename = is_texture_file ? path.stem().string() : path.filename().string();
+        // The textures are named after their file
+        if (m_world.m_textures_cache.count(filename) > 0)
+        {
+            Log("> Texture file '%s' changed, reloading it...", changed_path.c_str());
+            AssetReload reload{
+                .m_path = changed_path,
+                .m_name = filename,
+                .m_decode_settings = frametech::engine::graphics::TextureDecodeSettings{
+                    .m_supports_alpha = true,
+                    .m_srgb = true,
+                    .m_compress = compress_textures,
+                },
+                .m_texture = new frametech::engine::graphics::Texture(),
+            };
+            reload.m_loaded = thread_pool->submit([texture = reload.m_texture, changed_path, filename, decode_settings = reload.m_decode_settings, is_texture_file, compress_textures]() {
+                // Mapped as is: decoded, mipmapped and compressed offline
+                if (is_texture_file)
+                {
+                    if (texture->readTextureFile(changed_path.c_str(), filename).IsError())
+                        return false;
+                    if (texture->isCompressed() && !compress_textures)
+                    {
+                        LogE("The device cannot sample the compressed texture '%s' - cook the assets with --no-compress", changed_path.c_str());
+                        return false;
+                    }
+                    return true;
+                }
+                ftstd::MappedFile contents;
+                if (contents.open(changed_path.c_str(), ftstd::MappedFile::Access::SEQUENTIAL).IsError() || !contents.isMapped())
+                    return false;
+                return !texture->load(contents.data(), static_cast<int>(contents.size()), decode_settings, filename).IsError();
+            });
+            m_asset_reloads.push_back(std::move(reload));
+            continue;
         }
+        // The full path of the mesh file: the name of the mesh is truncated
+        if (!mesh_path.empty() && path == mesh_path)
+        {
+            Log("> Mesh file '%s' changed, reloading it...", changed_path.c_str());
+            AssetReload reload{
+                .m_path = changed_path,
+                .m_mesh = std::make_unique<frametech::graphics::Mesh>(),
+            };
+            reload.m_loaded = thread_pool->submit([mesh = reload.m_mesh.get(), changed_path]() {
+                const auto result = frametech::graphics::MeshUtils::loadFromFile(changed_path.c_str());
+                if (result.IsError())
+                    return false;
+                *mesh = result.GetValue();
+                return true;
+            });
+            m_asset_reloads.push_back(std::move(reload));
+        }
+        // Other files (caches, new assets...) are ignored
     }
-    return ftstd::VResult::Error((char*)"Unimplemented loadGameAssets function");
+}
+
+void frametech::Application::applyAssetReloads() noexcept
+{
+    bool update_descriptor_sets = false;
+    // In the order of the changes: the last version of a file wins
+    while (!m_asset_reloads.empty() &&
+           std::future_status::ready == m_asset_reloads.front().m_loaded.wait_for(std::chrono::seconds(0)))
+    {
+        AssetReload reload = std::move(m_asset_reloads.front());
+        m_asset_reloads.pop_front();
+        const bool loaded = reload.m_loaded.get();
+        if (nullptr != reload.m_mesh)
+        {
+            const auto pipeline = m_engine->m_render->getGraphicsPipeline();
+            // The mesh may have been switched in the meantime
+            const bool is_still_used = reload.m_is_mesh_selection
+                                           ? frametech::graphics::Mesh2D::FROM_FILE == m_selected_mesh
+                                           : std::filesystem::path(pipeline->getMeshPath()).lexically_normal() == std::filesystem::path(reload.m_path).lexically_normal();
+            if (!loaded || !is_still_used)
+                continue;
+            const bool had_uvs_in_unit_square = pipeline->hasUVsInUnitSquare();
+            if (pipeline->replaceMesh(std::move(*reload.m_mesh), reload.m_path).IsError())
+                LogE("Cannot swap the reloaded mesh '%s'", reload.m_path.c_str());
+            // A packed texture is sampled from its atlas page or on its own, depending on the UVs
+            update_descriptor_sets = update_descriptor_sets || had_uvs_in_unit_square != pipeline->hasUVsInUnitSquare();
+            continue;
+        }
+
+        const auto texture_region = m_world.m_textures_cache.find(reload.m_name);
+        if (!loaded || texture_region == m_world.m_textures_cache.end())
+        {
+            LogE("Cannot reload the texture '%s'", reload.m_path.c_str());
+            delete reload.m_texture;
+            continue;
+        }
+        frametech::engine::graphics::TextureResidency& texture_residency = m_world.getTextureResidency();
+        if (texture_region->second.m_is_atlas_page)
+        {
+            // The atlas page is left as is: the texture is streamed on its own from now on.
+            // Its new version is in the texture cache, ready to be requested.
+            delete reload.m_texture;
+            const frametech::engine::graphics::TextureHandle texture_handle = texture_residency.add(reload.m_path, reload.m_decode_settings, reload.m_name);
+            m_world.setTextureRegion(reload.m_name, frametech::engine::graphics::TextureRegion{.m_texture = texture_handle});
+            update_descriptor_sets = update_descriptor_sets || reload.m_name == m_world.getSelectedTexture();
+            continue;
+        }
+        // Only uploaded if the previous version is resident
+        if (texture_residency.replace(texture_region->second.m_texture, reload.m_texture))
+            update_descriptor_sets = update_descriptor_sets || reload.m_name == m_world.getSelectedTexture();
+    }
+    // The frame that used the previous descriptors is done
+    if (update_descriptor_sets)
+        m_engine->m_render->getGraphicsPipeline()->updateDescriptorSets(false);
 }
 
 void frametech::Application::forceRendererFPSLimit(u8 new_limit)
@@ -558,6 +1073,8 @@ void frametech::Application::forceRendererFPSLimit(u8 new_limit)
 void frametech::Application::drawFrame()
 {
     ftstd::profile::ScopedProfileMarker scope((char*)"frametech::Application::drawFrame");
+    // Destroy the evicted textures that are not used by the frames in flight anymore
+    m_world.getTextureResidency().beginFrame(m_current_frame);
     // Update the UBOs
     const u32 current_frame_index = m_engine->m_render->getFrameIndex();
     {
@@ -571,7 +1088,17 @@ void frametech::Application::drawFrame()
             delta_time,
             swapchain_extent.height,
             swapchain_extent.width);
+        // Sample the region of the selected texture, if it lives in an atlas page
+        const bool has_uvs_in_unit_square = m_engine->m_render->getGraphicsPipeline()->hasUVsInUnitSquare();
+        if (const auto texture_region = m_world.getSampledRegion(m_world.getSelectedTexture(), has_uvs_in_unit_square); texture_region.has_value())
+        {
+            mvp.texture_rect = texture_region->m_uv_rect;
+            // Keeps the sampled texture the most recently used one
+            m_world.getTextureResidency().request(texture_region->m_texture);
+        }
 
+        m_engine->m_render->getGraphicsPipeline()->selectLod(mvp, static_cast<f32>(swapchain_extent.height));
+        m_engine->m_render->getGraphicsPipeline()->cullMeshlets(mvp);
         m_engine->m_render->getGraphicsPipeline()->updateUniformBuffer(current_frame_index, mvp);
     }
 
@@ -584,6 +1111,8 @@ void frametech::Application::drawFrame()
         // Real rendering time
         auto begin_real_rendering_timer = ftstd::Timer();
         m_engine->m_render->getGraphicsPipeline()->acquireImage();
+        applyGameAssetLoads();
+        applyAssetReloads();
         m_engine->m_render->getGraphicsPipeline()->draw();
         {
             ftstd::profile::ScopedProfileMarker scope((char*)"graphics::present");
@@ -605,6 +1134,8 @@ void frametech::Application::drawFrame()
     // Real rendering time
     auto begin_real_rendering_timer = ftstd::Timer();
     m_engine->m_render->getGraphicsPipeline()->acquireImage();
+    applyGameAssetLoads();
+    applyAssetReloads();
     m_engine->m_render->getGraphicsPipeline()->draw();
     m_engine->m_render->getGraphicsPipeline()->present();
     const uint64_t rendering_time_diff = begin_real_rendering_timer.diff();
@@ -726,6 +1257,7 @@ void frametech::Application::run()
                 glfwPollEvents();
                 m_key_events_handler.poll(false);
                 m_cursor_events_handler.poll(false);
+                reloadChangedAssets();
 #ifdef IMGUI
                 // Log(">> Rendering ImGui");
                 // Start the Dear ImGui frame
@@ -738,9 +1270,17 @@ void frametech::Application::run()
                 if (m_state == frametech::Application::State::RUNNING) {
                     // drawFrame includes the acquisition, draw, and present processes
                     drawFrame();
+                    // The game assets are loaded in the background once the first frame is on screen
+                    if (!m_time_to_first_frame.has_value())
+                    {
+                        m_time_to_first_frame = m_app_timer->diff();
+                        Log("> First frame presented %llu ms after the start", m_time_to_first_frame.value());
+                        loadGameAssets();
+                    }
                 }
             }
             Log("< ...Application loop");
+            waitAssetLoads();
             vkDeviceWaitIdle(m_engine->m_graphics_device.getLogicalDevice());
 #ifdef IMGUI
             cleanImGui();
@@ -12,10 +12,14 @@
 #include "engine/engine.hpp"
 #include "engine/graphics/monitor.hpp"
 #include "engine/inputs/inputs.hpp"
+#include "ftstd/file_watcher.hpp"
 #include "ftstd/timer.h"
 #include "gameframework/world.hpp"
 #include "project.hpp"
 #include <GLFW/glfw3.h>
+#include <deque>
+#include <future>
+#include <memory>
 #include <optional>
 
 #ifdef IMGUI
@@ -104,6 +108,95 @@ namespace frametech
         frametech::graphics::Monitor m_monitor;
         /// @brief The world, nothing less, nothing more
         frametech::gameframework::World m_world;
+        /// @brief Watches the asset folders, to reload the assets that changed
+        ftstd::FileWatcher m_asset_watcher;
+        /// @brief An asset reloaded (or a selected mesh loaded) on a worker
+        struct AssetReload
+        {
+            /// @brief Path of the changed file
+            std::string m_path;
+            /// @brief Name of the texture (file name) - empty for a mesh
+            std::string m_name;
+            /// @brief How the texture is decoded
+            frametech::engine::graphics::TextureDecodeSettings m_decode_settings{};
+            /// @brief The reloaded texture, not uploaded - owned by the reload until swapped in
+            frametech::engine::graphics::Texture* m_texture = nullptr;
+            /// @brief The reloaded mesh
+            std::unique_ptr<frametech::graphics::Mesh> m_mesh = nullptr;
+            /// @brief The mesh has been selected, not changed on disk: it replaces the current
+            /// mesh if it is still the selected one once loaded
+            bool m_is_mesh_selection = false;
+            /// @brief Set by the worker - true if the asset has been loaded
+            std::future<bool> m_loaded;
+        };
+        /// @brief Reloads in progress, in the order of the changes
+        std::deque<AssetReload> m_asset_reloads;
+        /// @brief Starts to watch the asset folders and the models folder (Linux only)
+        void watchGameAssets() noexcept;
+        /// @brief Starts to reload the changed assets on the workers - the other assets
+        /// are not touched
+        void reloadChangedAssets() noexcept;
+        /// @brief Swaps the reloaded assets in place. Must be called once the in-flight fence
+        /// has been waited: the previous buffers and descriptors are not used by the GPU anymore.
+        void applyAssetReloads() noexcept;
+        /// @brief The selected mesh - the rendered one may still be loading
+        frametech::graphics::Mesh2D m_selected_mesh = frametech::graphics::Mesh2D::BASIC_TRIANGLE;
+        /// @brief Selects the mesh to render. A mesh file is loaded on a worker: the current
+        /// mesh is rendered until it is ready.
+        void selectMesh(const frametech::graphics::Mesh2D mesh_type) noexcept;
+        /// @brief An asset file found in the asset folders (or archives)
+        struct AssetEntry
+        {
+            /// @brief Path of the file, or name of the entry if the asset is in an archive
+            std::string m_path;
+            std::string m_filename;
+            /// @brief The archive of the asset, if any
+            std::shared_ptr<const frametech::engine::AssetArchive> m_archive = nullptr;
+            u64 m_size = 0;
+            /// @brief Owned by the entry until the texture lands in the cache
+            frametech::engine::graphics::Texture* m_texture = nullptr;
+            bool m_decoded = false;
+            /// @brief Small enough to be packed in an atlas page
+            bool m_packed = false;
+            /// @brief How the texture has been decoded - to reload it the same way
+            frametech::engine::graphics::TextureDecodeSettings m_decode_settings{};
+        };
+        /// @brief The game assets, loaded in the background while the frames are rendered
+        struct GameAssetsLoading
+        {
+            /// @brief The asset files, in the scan order - written by the scan job only
+            std::vector<AssetEntry> m_entries;
+            /// @brief Set once the asset folders have been scanned
+            std::future<void> m_scanned;
+            /// @brief Set once each entry has been decoded, in the scan order
+            std::vector<std::future<void>> m_decoded;
+            /// @brief Number of entries registered in the world, in the scan order
+            size_t m_nb_registered_entries = 0;
+            /// @brief The small textures, packed once all the entries have been decoded
+            frametech::engine::graphics::TextureAtlas m_atlas;
+            /// @brief Number of textures registered in the world
+            u32 m_nb_loaded_textures = 0;
+            /// @brief Starts with the loading
+            ftstd::Timer m_timer;
+            /// @brief Time to scan the asset folders, in ms
+            u64 m_scan_time = 0;
+            /// @brief If the assets are being loaded
+            bool m_in_progress = false;
+        };
+        /// @brief The game assets being loaded
+        GameAssetsLoading m_game_assets_loading;
+        /// @brief Time between the creation of the application and the first presented frame, in ms
+        std::optional<u64> m_time_to_first_frame = std::nullopt;
+        /// @brief Time between the creation of the application and the registration of all the
+        /// game assets, in ms
+        std::optional<u64> m_time_to_game_assets = std::nullopt;
+        /// @brief Registers the game assets decoded since the last call, and updates the
+        /// descriptors if the selected texture changed. Must be called once the in-flight
+        /// fence has been waited, like `applyAssetReloads`.
+        void applyGameAssetLoads() noexcept;
+        /// @brief Waits for the jobs of the asset loads and reloads, and releases what they
+        /// loaded - before the engine is destroyed
+        void waitAssetLoads() noexcept;
 
     public:
         /// @brief Private destructor
@@ -122,10 +215,11 @@ namespace frametech
         /// @brief Initialize the app's engine
         /// @return A boolean value to indicate if the engine has been initialized or not
         bool initEngine();
-        /// @brief Initialize the app's engine descriptor sets
+        /// @brief Initialize the app's engine descriptor sets, with the placeholder texture
         void initDescriptorSets();
-        /// @brief Load all assets for the game - should be called
-        /// **after** initializing the engine
+        /// @brief Starts to load all assets for the game on the workers - called by `run`
+        /// once the first frame has been presented. The world is filled frame after frame
+        /// (see `applyGameAssetLoads`), the placeholders are rendered in the meantime.
         ftstd::VResult loadGameAssets() noexcept;
         /// @brief Run the app and wait until the user close it
         void run();
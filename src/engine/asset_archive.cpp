@@ -0,0 +1,264 @@
+//
+//  asset_archive.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#include "asset_archive.hpp"
+#include "../ftstd/debug_tools.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <stdio.h>
+
+#include <stb/stb_image.h>
+// Only the zlib compressor is used, kept private to this file
+#define STB_IMAGE_WRITE_STATIC
+#define STBI_WRITE_NO_STDIO
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb/stb_image_write.h>
+
+/// @brief Returns `offset`, rounded up to the next multiple of `alignment`
+static u64 alignUp(const u64 offset, const u64 alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+bool frametech::engine::AssetArchive::isAssetArchive(const char* path) noexcept
+{
+    return std::filesystem::path(path).extension() == ASSET_ARCHIVE_EXTENSION;
+}
+
+ftstd::VResult frametech::engine::AssetArchive::open(const char* path) noexcept
+{
+    m_entries = nullptr;
+    m_entries_count = 0;
+    m_names = nullptr;
+    m_path = path;
+    // The table of contents is searched, the entries are read one by one
+    if (m_file.open(path, ftstd::MappedFile::Access::RANDOM).IsError())
+        return ftstd::VResult::Error((char*)"cannot map the asset archive");
+
+    const u64 file_size = m_file.size();
+    if (file_size < sizeof(AssetArchiveHeader))
+        return ftstd::VResult::Error((char*)"truncated asset archive");
+    AssetArchiveHeader header{};
+    memcpy(&header, m_file.data(), sizeof(AssetArchiveHeader));
+
+    if (0 != memcmp(header.m_magic, ASSET_ARCHIVE_MAGIC, sizeof(ASSET_ARCHIVE_MAGIC)))
+        return ftstd::VResult::Error((char*)"not an asset archive");
+    if (ASSET_ARCHIVE_VERSION != header.m_version)
+    {
+        LogW("asset archive '%s' has version %u, expected version %u", path, header.m_version, ASSET_ARCHIVE_VERSION);
+        return ftstd::VResult::Error((char*)"unsupported asset archive version");
+    }
+    if (header.m_entries_count > (file_size - sizeof(AssetArchiveHeader)) / sizeof(AssetArchiveEntry) ||
+        header.m_names_offset < sizeof(AssetArchiveHeader) + header.m_entries_count * sizeof(AssetArchiveEntry) ||
+        header.m_names_offset > file_size ||
+        header.m_names_size > file_size - header.m_names_offset)
+        return ftstd::VResult::Error((char*)"corrupted asset archive");
+
+    // The header is 32 bytes long: the table of contents is aligned in the mapping
+    const AssetArchiveEntry* entries = reinterpret_cast<const AssetArchiveEntry*>(m_file.data() + sizeof(AssetArchiveHeader));
+    for (u32 entry_index = 0; entry_index < header.m_entries_count; ++entry_index)
+    {
+        const AssetArchiveEntry& entry = entries[entry_index];
+        if (entry.m_name_offset > header.m_names_size ||
+            entry.m_name_size > header.m_names_size - entry.m_name_offset ||
+            entry.m_offset > file_size ||
+            entry.m_stored_size > file_size - entry.m_offset ||
+            (0 == (entry.m_flags & ASSET_ARCHIVE_ENTRY_ZLIB) && entry.m_stored_size != entry.m_size))
+            return ftstd::VResult::Error((char*)"corrupted asset archive entry");
+    }
+    m_entries = entries;
+    m_entries_count = header.m_entries_count;
+    m_names = m_file.data() + header.m_names_offset;
+    Log("> Asset archive '%s': %u entries", path, m_entries_count);
+    return ftstd::VResult::Ok();
+}
+
+std::string_view frametech::engine::AssetArchive::getName(const AssetArchiveEntry& entry) const noexcept
+{
+    return std::string_view(m_names + entry.m_name_offset, entry.m_name_size);
+}
+
+const frametech::engine::AssetArchiveEntry* frametech::engine::AssetArchive::find(std::string_view name) const noexcept
+{
+    const AssetArchiveEntry* entries_end = m_entries + m_entries_count;
+    const AssetArchiveEntry* entry = std::lower_bound(m_entries, entries_end, name, [this](const AssetArchiveEntry& entry, std::string_view name) {
+        return getName(entry) < name;
+    });
+    if (entry == entries_end || getName(*entry) != name)
+        return nullptr;
+    return entry;
+}
+
+ftstd::VResult frametech::engine::AssetArchive::inflate(const AssetArchiveEntry& entry, std::vector<char>& content) const noexcept
+{
+    if (entry.m_size > INT_MAX || entry.m_stored_size > INT_MAX)
+        return ftstd::VResult::Error((char*)"compressed asset archive entry too big");
+    content.resize(entry.m_size);
+    const int inflated_size = stbi_zlib_decode_buffer(content.data(),
+                                                      static_cast<int>(entry.m_size),
+                                                      m_file.data() + entry.m_offset,
+                                                      static_cast<int>(entry.m_stored_size));
+    if (inflated_size < 0 || static_cast<u64>(inflated_size) != entry.m_size)
+    {
+        LogE("Cannot inflate the entry '%.*s' of the asset archive '%s'", static_cast<int>(entry.m_name_size), m_names + entry.m_name_offset, m_path.c_str());
+        return ftstd::VResult::Error((char*)"cannot inflate the asset archive entry");
+    }
+    return ftstd::VResult::Ok();
+}
+
+ftstd::VResult frametech::engine::AssetArchive::write(const char* path, std::vector<AssetArchiveSource> sources, const bool compress) noexcept
+{
+    // Sorted for the binary search - the stable sort keeps the last duplicate last
+    std::stable_sort(sources.begin(), sources.end(), [](const AssetArchiveSource& a, const AssetArchiveSource& b) {
+        return a.m_name < b.m_name;
+    });
+    std::vector<AssetArchiveSource> unique_sources;
+    unique_sources.reserve(sources.size());
+    for (AssetArchiveSource& source : sources)
+    {
+        if (!unique_sources.empty() && unique_sources.back().m_name == source.m_name)
+        {
+            LogW("Asset archive entry '%s': '%s' replaces '%s'", source.m_name.c_str(), source.m_path.c_str(), unique_sources.back().m_path.c_str());
+            unique_sources.back() = std::move(source);
+            continue;
+        }
+        unique_sources.push_back(std::move(source));
+    }
+    if (unique_sources.size() > UINT32_MAX)
+        return ftstd::VResult::Error((char*)"too many asset archive entries");
+
+    std::vector<AssetArchiveEntry> entries(unique_sources.size());
+    std::string names;
+    for (size_t entry_index = 0; entry_index < unique_sources.size(); ++entry_index)
+    {
+        entries[entry_index].m_name_offset = names.size();
+        entries[entry_index].m_name_size = static_cast<u32>(unique_sources[entry_index].m_name.size());
+        names += unique_sources[entry_index].m_name;
+    }
+    AssetArchiveHeader header{
+        .m_version = ASSET_ARCHIVE_VERSION,
+        .m_entries_count = static_cast<u32>(entries.size()),
+        .m_alignment = static_cast<u32>(ASSET_ARCHIVE_ALIGNMENT),
+        .m_names_offset = sizeof(AssetArchiveHeader) + entries.size() * sizeof(AssetArchiveEntry),
+        .m_names_size = names.size(),
+    };
+    memcpy(header.m_magic, ASSET_ARCHIVE_MAGIC, sizeof(ASSET_ARCHIVE_MAGIC));
+
+    const std::string temporary_path = std::string(path) + ".tmp";
+    FILE* pFile = fopen(temporary_path.c_str(), "wb");
+    if (NULL == pFile)
+        return ftstd::VResult::Error((char*)"cannot open the asset archive to write");
+
+    // The content goes first, after the space of the table of contents: the offsets and
+    // the sizes are known once each entry has been compressed
+    static const char padding[ASSET_ARCHIVE_ALIGNMENT] = {};
+    u64 offset = alignUp(header.m_names_offset + header.m_names_size, ASSET_ARCHIVE_ALIGNMENT);
+    bool written = 0 == fseek(pFile, static_cast<long>(offset), SEEK_SET);
+    u64 stored_size = 0;
+    u64 total_size = 0;
+    for (size_t entry_index = 0; written && entry_index < unique_sources.size(); ++entry_index)
+    {
+        const AssetArchiveSource& source = unique_sources[entry_index];
+        AssetArchiveEntry& entry = entries[entry_index];
+        ftstd::MappedFile contents;
+        if (contents.open(source.m_path.c_str(), ftstd::MappedFile::Access::SEQUENTIAL).IsError())
+        {
+            written = false;
+            break;
+        }
+        const char* data = contents.data();
+        entry.m_size = contents.size();
+        entry.m_stored_size = contents.size();
+        unsigned char* compressed_data = nullptr;
+        if (compress && contents.size() > 0 && contents.size() <= INT_MAX)
+        {
+            int compressed_size = 0;
+            compressed_data = stbi_zlib_compress(reinterpret_cast<unsigned char*>(const_cast<char*>(contents.data())),
+                                                 static_cast<int>(contents.size()),
+                                                 &compressed_size,
+                                                 8);
+            if (nullptr != compressed_data && static_cast<u64>(compressed_size) < contents.size() - contents.size() / 8)
+            {
+                data = reinterpret_cast<const char*>(compressed_data);
+                entry.m_stored_size = static_cast<u64>(compressed_size);
+                entry.m_flags |= ASSET_ARCHIVE_ENTRY_ZLIB;
+            }
+        }
+        entry.m_offset = offset;
+        const u64 entry_padding = alignUp(entry.m_stored_size, ASSET_ARCHIVE_ALIGNMENT) - entry.m_stored_size;
+        written = entry.m_stored_size == fwrite(data, 1, entry.m_stored_size, pFile) &&
+                  entry_padding == fwrite(padding, 1, entry_padding, pFile);
+        STBIW_FREE(compressed_data);
+        offset += entry.m_stored_size + entry_padding;
+        stored_size += entry.m_stored_size;
+        total_size += entry.m_size;
+    }
+    written = written &&
+              0 == fseek(pFile, 0, SEEK_SET) &&
+              1 == fwrite(&header, sizeof(AssetArchiveHeader), 1, pFile) &&
+              entries.size() == fwrite(entries.data(), sizeof(AssetArchiveEntry), entries.size(), pFile) &&
+              names.size() == fwrite(names.data(), 1, names.size(), pFile);
+    if (0 != fclose(pFile) || !written)
+    {
+        remove(temporary_path.c_str());
+        return ftstd::VResult::Error((char*)"cannot write the asset archive");
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary_path, path, error);
+    if (error)
+    {
+        remove(temporary_path.c_str());
+        return ftstd::VResult::Error((char*)"cannot move the asset archive");
+    }
+    Log("> Asset archive '%s' written (%zu entries, %llu kB stored for %llu kB)", path, entries.size(), stored_size >> 10, total_size >> 10);
+    return ftstd::VResult::Ok();
+}
+
+ftstd::VResult frametech::engine::AssetContent::open(const char* path, const ftstd::MappedFile::Access access_hint) noexcept
+{
+    m_archive = nullptr;
+    m_inflated.clear();
+    if (const auto result = m_file.open(path, access_hint); result.IsError())
+    {
+        m_data = nullptr;
+        m_size = 0;
+        return result;
+    }
+    m_data = m_file.data();
+    m_size = m_file.size();
+    return ftstd::VResult::Ok();
+}
+
+ftstd::VResult frametech::engine::AssetContent::open(const std::shared_ptr<const AssetArchive>& archive, const std::string& name) noexcept
+{
+    m_file.close();
+    m_archive = nullptr;
+    m_inflated.clear();
+    m_data = nullptr;
+    m_size = 0;
+    const AssetArchiveEntry* entry = nullptr == archive ? nullptr : archive->find(name);
+    if (nullptr == entry)
+    {
+        LogE("Cannot find the entry '%s' in the asset archive", name.c_str());
+        return ftstd::VResult::Error((char*)"cannot find the asset archive entry");
+    }
+    if (0 != (entry->m_flags & AssetArchive::ASSET_ARCHIVE_ENTRY_ZLIB))
+    {
+        if (const auto result = archive->inflate(*entry, m_inflated); result.IsError())
+            return result;
+        m_data = m_inflated.data();
+        m_size = m_inflated.size();
+        return ftstd::VResult::Ok();
+    }
+    m_archive = archive;
+    m_data = archive->getStoredData(*entry);
+    m_size = entry->m_size;
+    return ftstd::VResult::Ok();
+}
@@ -0,0 +1,170 @@
+//
+//  asset_archive.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _asset_archive_hpp
+#define _asset_archive_hpp
+
+#include "../ftstd/mapped_file.hpp"
+#include "../ftstd/result.hpp"
+#include "platform.hpp"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace frametech
+{
+    namespace engine
+    {
+        /// @brief Header of an asset archive (.ftpak).
+        /// The table of contents follows (m_entries_count AssetArchiveEntry, sorted by name),
+        /// then the names, then the content of the entries, each one starting on a
+        /// m_alignment boundary.
+        struct AssetArchiveHeader
+        {
+            /// @brief Always ASSET_ARCHIVE_MAGIC
+            char m_magic[4];
+            /// @brief Version of the format - archives with another version are rejected
+            u32 m_version;
+            /// @brief Number of entries in the table of contents
+            u32 m_entries_count;
+            /// @brief Alignment of the content of the entries, in bytes
+            u32 m_alignment;
+            /// @brief Offset of the names, from the beginning of the archive
+            u64 m_names_offset;
+            /// @brief Size of the names, in bytes
+            u64 m_names_size;
+        };
+
+        /// @brief An entry of the table of contents of an asset archive
+        struct AssetArchiveEntry
+        {
+            /// @brief Offset of the name (not NULL terminated), from the beginning of the names
+            u64 m_name_offset;
+            /// @brief Size of the name, in bytes
+            u32 m_name_size;
+            /// @brief ASSET_ARCHIVE_ENTRY_* flags
+            u32 m_flags;
+            /// @brief Offset of the content, from the beginning of the archive
+            u64 m_offset;
+            /// @brief Size of the content in the archive, in bytes
+            u64 m_stored_size;
+            /// @brief Size of the content once inflated, in bytes
+            u64 m_size;
+        };
+
+        /// @brief A file to write in an asset archive
+        struct AssetArchiveSource
+        {
+            /// @brief Name of the entry - a relative path, with '/' separators
+            std::string m_name;
+            /// @brief Path of the file to copy
+            std::string m_path;
+        };
+
+        /// @brief Single-file bundle of assets, mapped once: looking for an entry is a binary
+        /// search in the table of contents, and reading it does not open any other file.
+        /// Entries can be stored as they are, or compressed with zlib.
+        class AssetArchive
+        {
+        public:
+            /// @brief Magic number of the asset archives
+            static constexpr char ASSET_ARCHIVE_MAGIC[4] = {'F', 'T', 'P', 'K'};
+            /// @brief Current version of the format
+            static constexpr u32 ASSET_ARCHIVE_VERSION = 1;
+            /// @brief Alignment of the content of the entries: each entry starts on its own page,
+            /// so reading it only faults its own pages in
+            static constexpr u64 ASSET_ARCHIVE_ALIGNMENT = 4096;
+            /// @brief Extension of the asset archives
+            static constexpr const char* ASSET_ARCHIVE_EXTENSION = ".ftpak";
+            /// @brief The content of the entry is compressed with zlib
+            static constexpr u32 ASSET_ARCHIVE_ENTRY_ZLIB = 1u << 0;
+
+            AssetArchive() = default;
+            AssetArchive(AssetArchive const&) = delete;
+            AssetArchive& operator=(AssetArchive const&) = delete;
+
+            /// @brief Returns if `path` names an asset archive (by extension)
+            static bool isAssetArchive(const char* path) noexcept;
+            /// @brief Maps the asset archive at `path`, and checks its table of contents
+            /// @return A VResult type - an error if the archive is missing or invalid
+            ftstd::VResult open(const char* path) noexcept;
+            /// @brief Returns the path of the mapped archive
+            const std::string& getPath() const noexcept { return m_path; }
+            /// @brief Returns the number of entries
+            u32 size() const noexcept { return m_entries_count; }
+            /// @brief Returns the entry at `index` - the entries are sorted by name
+            const AssetArchiveEntry& getEntry(const u32 index) const noexcept { return m_entries[index]; }
+            /// @brief Returns the name of `entry`
+            std::string_view getName(const AssetArchiveEntry& entry) const noexcept;
+            /// @brief Returns the entry named `name`, or nullptr if the archive does not have it
+            const AssetArchiveEntry* find(std::string_view name) const noexcept;
+            /// @brief Returns the content of a stored (not compressed) `entry`, in the mapping
+            const char* getStoredData(const AssetArchiveEntry& entry) const noexcept { return m_file.data() + entry.m_offset; }
+            /// @brief Inflates the content of a compressed `entry` in `content`
+            /// @return A VResult type
+            ftstd::VResult inflate(const AssetArchiveEntry& entry, std::vector<char>& content) const noexcept;
+            /// @brief Writes the asset archive at `path`, with the files of `sources`.
+            /// Two sources with the same name: the last one wins.
+            /// The archive is written aside, then moved: a reader never sees a partial archive.
+            /// @param compress Compress each entry with zlib - only kept if it saves an eighth of
+            /// the size (encoded images are already compressed)
+            /// @return A VResult type
+            static ftstd::VResult write(const char* path, std::vector<AssetArchiveSource> sources, const bool compress) noexcept;
+
+        private:
+            /// @brief The mapped archive
+            ftstd::MappedFile m_file;
+            /// @brief Path of the archive
+            std::string m_path;
+            /// @brief The table of contents, in the mapping
+            const AssetArchiveEntry* m_entries = nullptr;
+            /// @brief Number of entries
+            u32 m_entries_count = 0;
+            /// @brief The names, in the mapping
+            const char* m_names = nullptr;
+        };
+
+        /// @brief Content of an asset, mapped from its own file or read from an asset archive.
+        /// Stored archive entries are not copied: the content keeps the archive alive.
+        class AssetContent
+        {
+        public:
+            AssetContent() = default;
+            AssetContent(AssetContent const&) = delete;
+            AssetContent& operator=(AssetContent const&) = delete;
+
+            /// @brief Maps the file at `path`
+            /// @return A VResult type
+            ftstd::VResult open(const char* path, const ftstd::MappedFile::Access access_hint = ftstd::MappedFile::Access::SEQUENTIAL) noexcept;
+            /// @brief Reads the entry `name` of `archive` - inflated if compressed
+            /// @return A VResult type - an error if the archive does not have the entry
+            ftstd::VResult open(const std::shared_ptr<const AssetArchive>& archive, const std::string& name) noexcept;
+            /// @brief Returns the first byte of the content
+            const char* data() const noexcept { return m_data; }
+            /// @brief Returns the size of the content, in bytes
+            u64 size() const noexcept { return m_size; }
+            /// @brief Returns if the content is empty
+            bool isEmpty() const noexcept { return 0 == m_size; }
+
+        private:
+            /// @brief The asset file, if the asset is not in an archive
+            ftstd::MappedFile m_file;
+            /// @brief The archive of the asset, if any
+            std::shared_ptr<const AssetArchive> m_archive = nullptr;
+            /// @brief The inflated content of a compressed archive entry
+            std::vector<char> m_inflated;
+            /// @brief First byte of the content
+            const char* m_data = nullptr;
+            /// @brief Size of the content, in bytes
+            u64 m_size = 0;
+        };
+    } // namespace engine
+} // namespace frametech
+
+#endif // _asset_archive_hpp
@@ -0,0 +1,152 @@
+//
+//  asset_manifest.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#include "asset_manifest.hpp"
+#include "../ftstd/debug_tools.h"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdio.h>
+
+namespace
+{
+    /// @brief Names of the CookedAssetType values, in the manifest
+    constexpr const char* COOKED_ASSET_TYPE_NAMES[] = {"file", "texture", "mesh"};
+
+    /// @brief Splits `line` on the tabulations
+    std::vector<std::string> splitFields(const std::string& line) noexcept
+    {
+        std::vector<std::string> fields;
+        size_t field_start = 0;
+        while (true)
+        {
+            const size_t field_end = line.find('\t', field_start);
+            fields.push_back(line.substr(field_start, field_end - field_start));
+            if (std::string::npos == field_end)
+                return fields;
+            field_start = field_end + 1;
+        }
+    }
+
+    /// @brief Parses the whole `field` as an unsigned integer in `base`
+    bool parseNumber(const std::string& field, const int base, u64& value) noexcept
+    {
+        if (field.empty())
+            return false;
+        char* end = nullptr;
+        value = strtoull(field.c_str(), &end, base);
+        return end == field.c_str() + field.size();
+    }
+} // namespace
+
+ftstd::VResult frametech::engine::AssetManifest::read(const char* path) noexcept
+{
+    std::ifstream manifest_file(path);
+    if (!manifest_file.is_open())
+        return ftstd::VResult::Error((char*)"cannot open the asset manifest");
+
+    m_entries.clear();
+    bool has_version = false;
+    std::string line;
+    while (std::getline(manifest_file, line))
+    {
+        if (line.empty() || '#' == line[0])
+            continue;
+        const std::vector<std::string> fields = splitFields(line);
+        if (!has_version)
+        {
+            u64 version = 0;
+            if (2 != fields.size() || "version" != fields[0] || !parseNumber(fields[1], 10, version))
+                return ftstd::VResult::Error((char*)"not an asset manifest");
+            if (ASSET_MANIFEST_VERSION != version)
+            {
+                LogW("asset manifest '%s' has version %llu, expected version %u", path, version, ASSET_MANIFEST_VERSION);
+                return ftstd::VResult::Error((char*)"unsupported asset manifest version");
+            }
+            has_version = true;
+            continue;
+        }
+        if (6 != fields.size())
+            return ftstd::VResult::Error((char*)"corrupted asset manifest");
+        AssetManifestEntry entry{};
+        u32 type = 0;
+        while (type < std::size(COOKED_ASSET_TYPE_NAMES) && fields[0] != COOKED_ASSET_TYPE_NAMES[type])
+            ++type;
+        if (type == std::size(COOKED_ASSET_TYPE_NAMES) ||
+            fields[1].empty() || fields[2].empty() ||
+            !parseNumber(fields[3], 16, entry.m_source_hash) ||
+            !parseNumber(fields[4], 10, entry.m_file_size) ||
+            !parseNumber(fields[5], 10, entry.m_memory_size))
+            return ftstd::VResult::Error((char*)"corrupted asset manifest entry");
+        entry.m_type = static_cast<CookedAssetType>(type);
+        entry.m_source = fields[1];
+        entry.m_output = fields[2];
+        m_entries.push_back(std::move(entry));
+    }
+    if (!has_version)
+        return ftstd::VResult::Error((char*)"not an asset manifest");
+    return ftstd::VResult::Ok();
+}
+
+ftstd::VResult frametech::engine::AssetManifest::write(const char* path) const noexcept
+{
+    const std::string temporary_path = std::string(path) + ".tmp";
+    FILE* pFile = fopen(temporary_path.c_str(), "w");
+    if (NULL == pFile)
+        return ftstd::VResult::Error((char*)"cannot open the asset manifest to write");
+
+    bool written = fprintf(pFile, "# FrameTech cooked assets - written by ftcook\nversion\t%u\n# type\tsource\toutput\tsource hash\tfile size\tmemory size\n", ASSET_MANIFEST_VERSION) > 0;
+    for (const AssetManifestEntry& entry : m_entries)
+    {
+        written = written && fprintf(pFile,
+                                     "%s\t%s\t%s\t%016llx\t%llu\t%llu\n",
+                                     COOKED_ASSET_TYPE_NAMES[static_cast<u32>(entry.m_type)],
+                                     entry.m_source.c_str(),
+                                     entry.m_output.c_str(),
+                                     entry.m_source_hash,
+                                     entry.m_file_size,
+                                     entry.m_memory_size) > 0;
+    }
+    if (0 != fclose(pFile) || !written)
+    {
+        remove(temporary_path.c_str());
+        return ftstd::VResult::Error((char*)"cannot write the asset manifest");
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary_path, path, error);
+    if (error)
+    {
+        remove(temporary_path.c_str());
+        return ftstd::VResult::Error((char*)"cannot move the asset manifest");
+    }
+    return ftstd::VResult::Ok();
+}
+
+const frametech::engine::AssetManifestEntry* frametech::engine::AssetManifest::find(const std::string& source) const noexcept
+{
+    for (const AssetManifestEntry& entry : m_entries)
+    {
+        if (entry.m_source == source)
+            return &entry;
+    }
+    return nullptr;
+}
+
+void frametech::engine::AssetManifest::add(AssetManifestEntry entry) noexcept
+{
+    for (AssetManifestEntry& existing_entry : m_entries)
+    {
+        if (existing_entry.m_source == entry.m_source)
+        {
+            existing_entry = std::move(entry);
+            return;
+        }
+    }
+    m_entries.push_back(std::move(entry));
+}
@@ -0,0 +1,84 @@
+//
+//  asset_manifest.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _asset_manifest_hpp
+#define _asset_manifest_hpp
+
+#include "../ftstd/result.hpp"
+#include "platform.hpp"
+#include <string>
+#include <vector>
+
+namespace frametech
+{
+    namespace engine
+    {
+        /// @brief What a cooked asset has been converted to
+        enum struct CookedAssetType : u32
+        {
+            /// @brief Copied as is
+            FILE = 0,
+            /// @brief Decoded (and compressed) mip chain, in a texture file (see TextureFile)
+            TEXTURE = 1,
+            /// @brief Imported mesh, in a binary mesh file (see MeshFile)
+            MESH = 2,
+        };
+
+        /// @brief An asset of a cooked asset folder
+        struct AssetManifestEntry
+        {
+            /// @brief What the source has been converted to
+            CookedAssetType m_type = CookedAssetType::FILE;
+            /// @brief Path of the source, relative to the asset folder ('/' separators)
+            std::string m_source;
+            /// @brief Path of the cooked file, relative to the asset folder ('/' separators)
+            std::string m_output;
+            /// @brief Hash of the source content and of the cooking settings - the asset is
+            /// cooked again once it changes
+            u64 m_source_hash = 0;
+            /// @brief Size of the cooked file, in bytes
+            u64 m_file_size = 0;
+            /// @brief Size of the data to upload to the GPU, in bytes (the mip chain of a texture,
+            /// the vertices and 32 bits indices of a mesh) - 0 for the copied files
+            u64 m_memory_size = 0;
+        };
+
+        /// @brief List of the assets of a cooked asset folder, written by ftcook next to them.
+        /// The runtime lists a cooked folder from its manifest, without touching the files.
+        /// Text file, one asset per line: type, source, output, hash, file size and memory size,
+        /// separated by tabulations - lines starting with '#' are comments.
+        class AssetManifest
+        {
+        public:
+            /// @brief Name of the manifest file, in a cooked asset folder
+            static constexpr const char* ASSET_MANIFEST_FILENAME = "ftcook.manifest";
+            /// @brief Current version of the format - manifests with another version are rejected
+            static constexpr u32 ASSET_MANIFEST_VERSION = 1;
+
+            /// @brief Reads the manifest at `path` - replaces the entries
+            /// @return A VResult type - an error if the manifest is missing or invalid
+            ftstd::VResult read(const char* path) noexcept;
+            /// @brief Writes the entries in the manifest at `path`.
+            /// The manifest is written aside, then moved: a reader never sees a partial manifest.
+            /// @return A VResult type
+            ftstd::VResult write(const char* path) const noexcept;
+            /// @brief Returns the entry of `source`, or nullptr if there is none
+            const AssetManifestEntry* find(const std::string& source) const noexcept;
+            /// @brief Adds `entry` - replaces the entry with the same source, if any
+            void add(AssetManifestEntry entry) noexcept;
+            /// @brief Returns the entries
+            const std::vector<AssetManifestEntry>& getEntries() const noexcept { return m_entries; }
+
+        private:
+            /// @brief The entries, in the order of the manifest
+            std::vector<AssetManifestEntry> m_entries;
+        };
+    } // namespace engine
+} // namespace frametech
+
+#endif // _asset_manifest_hpp
@@ -75,10 +75,17 @@ frametech::Engine::Engine()
 frametech::Engine::~Engine()
 {
     Log("< Closing the Engine object...");
+    // Waits for the pending uploads, before their command pool is destroyed with the renderer
+    if (m_transfer_queue)
+        m_transfer_queue->destroy();
     m_swapchain = nullptr;
     m_render = nullptr;
     if (m_descriptor_pool)
         vkDestroyDescriptorPool(m_graphics_device.getLogicalDevice(), m_descriptor_pool, nullptr);
+    // Releases the geometry and the staging memory before the allocator - the meshes
+    // have been freed with the renderer
+    m_geometry_pool = nullptr;
+    m_transfer_queue = nullptr;
     if (VK_NULL_HANDLE != m_allocator)
         vmaDestroyAllocator(m_allocator);
     m_graphics_device.Destroy();
@@ -122,6 +129,16 @@ void frametech::Engine::initialize()
         m_state = State::ERROR;
         return;
     }
+    if (const auto result = createTransferQueue(); result.IsError())
+    {
+        m_state = State::ERROR;
+        return;
+    }
+    if (const auto result = createGeometryPool(); result.IsError())
+    {
+        m_state = State::ERROR;
+        return;
+    }
     if (const auto result = createDescriptorPool(); result.IsError())
     {
         m_state = State::ERROR;
@@ -199,6 +216,34 @@ ftstd::VResult frametech::Engine::createAllocator()
     return ftstd::VResult::Error((char*)"Failed to initialize the internal allocator");
 }
 
+ftstd::VResult frametech::Engine::createTransferQueue()
+{
+    m_transfer_queue = std::make_unique<frametech::graphics::TransferQueue>();
+    if (const auto result = m_transfer_queue->create(m_allocator); result.IsError())
+    {
+        m_transfer_queue = nullptr;
+        return ftstd::VResult::Error((char*)"Failed to create the transfer queue");
+    }
+    return ftstd::VResult::Ok();
+}
+
+ftstd::VResult frametech::Engine::createGeometryPool()
+{
+    m_geometry_pool = std::make_unique<frametech::graphics::GeometryPool>();
+    const u64 vertex_pool_size = GAME_APPLICATION_SETTINGS->vertex_pool_mb.has_value()
+                                     ? static_cast<u64>(GAME_APPLICATION_SETTINGS->vertex_pool_mb.value()) * 1024 * 1024
+                                     : frametech::graphics::GeometryPool::DEFAULT_VERTEX_POOL_SIZE;
+    const u64 index_pool_size = GAME_APPLICATION_SETTINGS->index_pool_mb.has_value()
+                                    ? static_cast<u64>(GAME_APPLICATION_SETTINGS->index_pool_mb.value()) * 1024 * 1024
+                                    : frametech::graphics::GeometryPool::DEFAULT_INDEX_POOL_SIZE;
+    if (const auto result = m_geometry_pool->create(m_allocator, vertex_pool_size, index_pool_size); result.IsError())
+    {
+        m_geometry_pool = nullptr;
+        return ftstd::VResult::Error((char*)"Failed to create the geometry pool");
+    }
+    return ftstd::VResult::Ok();
+}
+
 ftstd::VResult frametech::Engine::createGraphicsInstance()
 {
     listSupportedExtensions();
@@ -11,9 +11,11 @@
 
 #include "../ftstd/result.hpp"
 #include "graphics/device.hpp"
+#include "graphics/geometry_pool.hpp"
 #include "graphics/pipeline.hpp"
 #include "graphics/render.hpp"
 #include "graphics/swapchain.hpp"
+#include "graphics/transfer_queue.hpp"
 #include "project.hpp"
 #include <cstdlib>
 #include <vk_mem_alloc.h>
@@ -54,6 +56,10 @@ namespace frametech
         ftstd::VResult pickPhysicalDevice();
         /// @brief Creates the custom allocator
         ftstd::VResult createAllocator();
+        /// @brief Creates the transfer queue of the uploads
+        ftstd::VResult createTransferQueue();
+        /// @brief Creates the geometry pool of the meshes, sized from the game settings (or the pool defaults)
+        ftstd::VResult createGeometryPool();
         /// @brief Creates the render device
         ftstd::VResult createRenderDevice();
         /// @brief Creates the swapchain
@@ -89,6 +95,10 @@ namespace frametech
         std::unique_ptr<frametech::graphics::Render> m_render;
         /// @brief The swapchain of the engine
         std::unique_ptr<frametech::graphics::SwapChain> m_swapchain;
+        /// @brief The asynchronous uploads to the GPU, and their staging memory
+        std::unique_ptr<frametech::graphics::TransferQueue> m_transfer_queue;
+        /// @brief The vertex and index buffers shared by the meshes
+        std::unique_ptr<frametech::graphics::GeometryPool> m_geometry_pool;
         /// @brief Returns a VkDescriptorPool object, associated to the current object
         VkDescriptorPool getDescriptorPool() const noexcept;
         /// @brief Returns the current name / tag of the rendering engine
@@ -81,7 +81,7 @@ ftstd::VResult frametech::graphics::Command::begin()
     return ftstd::VResult::Error((char*)"> Error calling vkBeginCommandBuffer");
 }
 
-ftstd::VResult frametech::graphics::Command::end(const VkQueue& queue, const u32 submit_count)
+ftstd::VResult frametech::graphics::Command::end(const VkQueue& queue, const u32 submit_count, const VkFence fence)
 {
     ftstd::profile::ScopedProfileMarker scope((char*)"frametech::graphics::Command::end");
     assert(CommandState::S_BEGAN == m_state);
@@ -93,7 +93,7 @@ ftstd::VResult frametech::graphics::Command::end(const VkQueue& queue, const u32
         .pCommandBuffers = &m_buffer,
     };
 
-    vkQueueSubmit(queue, submit_count, &submitInfo, VK_NULL_HANDLE);
+    vkQueueSubmit(queue, submit_count, &submitInfo, fence);
     vkQueueWaitIdle(queue);
 
     vkFreeCommandBuffers(
@@ -106,12 +106,46 @@ ftstd::VResult frametech::graphics::Command::end(const VkQueue& queue, const u32
     return ftstd::VResult::Ok();
 }
 
+ftstd::VResult frametech::graphics::Command::submit(const VkQueue& queue, const VkSemaphore timeline, const u64 value)
+{
+    ftstd::profile::ScopedProfileMarker scope((char*)"frametech::graphics::Command::submit");
+    assert(CommandState::S_BEGAN == m_state);
+    if (VK_SUCCESS != vkEndCommandBuffer(m_buffer))
+    {
+        m_state = CommandState::S_ERROR;
+        return ftstd::VResult::Error((char*)"> Error calling vkEndCommandBuffer");
+    }
+
+    VkTimelineSemaphoreSubmitInfo timeline_info{
+        .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+        .signalSemaphoreValueCount = 1,
+        .pSignalSemaphoreValues = &value,
+    };
+    VkSubmitInfo submit_info{
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .pNext = &timeline_info,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &m_buffer,
+        .signalSemaphoreCount = 1,
+        .pSignalSemaphores = &timeline,
+    };
+    if (VK_SUCCESS != vkQueueSubmit(queue, 1, &submit_info, VK_NULL_HANDLE))
+    {
+        m_state = CommandState::S_ERROR;
+        return ftstd::VResult::Error((char*)"> Error calling vkQueueSubmit");
+    }
+
+    m_state = CommandState::S_ENDED;
+    return ftstd::VResult::Ok();
+}
+
 void frametech::graphics::Command::transition(
     const VkImage& image,
     const VkImageLayout new_layout,
     const VkImageLayout old_layout,
     const u32 src_queue_family_index,
-    const u32 dst_queue_family_index) const noexcept
+    const u32 dst_queue_family_index,
+    const u32 level_count) const noexcept
 {
     assert(CommandState::S_BEGAN == m_state);
 
@@ -163,7 +197,7 @@ void frametech::graphics::Command::transition(
         .subresourceRange = {
             .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
             .baseMipLevel = 0,
-            .levelCount = 1,
+            .levelCount = level_count,
             .baseArrayLayer = 0,
             .layerCount = 1,
         },
@@ -192,6 +226,9 @@ ftstd::VResult frametech::graphics::Command::record()
         return ftstd::VResult::Error((char*)"< Error creating the command buffer");
     }
 
+    // The resources uploaded since the previous frames are acquired outside of the render pass
+    frametech::Engine::getInstance()->m_render->getGraphicsPipeline()->acquireUploads(m_buffer);
+
     const std::vector<VkFramebuffer> framebuffers = frametech::Engine::getInstance()->m_render->getFramebuffers();
     if (current_frame_index >= framebuffers.size())
     {
@@ -238,7 +275,7 @@ ftstd::VResult frametech::graphics::Command::record()
     };
     vkCmdSetScissor(m_buffer, 0, 1, &scissor);
 
-    // Bind the vertex buffer
+    // Bind the vertex and index buffers of the geometry pool - shared by all the meshes
     std::vector<VkBuffer> vertex_buffers = {frametech::Engine::getInstance()->m_render->getGraphicsPipeline()->getVertexBuffer()};
     // // TODO: check to include this information getting the vertex buffer
     std::vector<VkDeviceSize> memory_offsets(vertex_buffers.size());
@@ -246,7 +283,7 @@ ftstd::VResult frametech::graphics::Command::record()
     for (int i = 0; i < vertex_buffers.size(); ++i)
         memory_offsets[i] = i;
     vkCmdBindVertexBuffers(m_buffer, 0, (u32)vertex_buffers.size(), vertex_buffers.data(), memory_offsets.data());
-    vkCmdBindIndexBuffer(m_buffer, index_buffer, 0, VK_INDEX_TYPE_UINT32);
+    vkCmdBindIndexBuffer(m_buffer, index_buffer, 0, frametech::Engine::getInstance()->m_render->getGraphicsPipeline()->getIndexType());
 
     // Bind the right descriptor set to the descriptors in the shaders
     std::optional<VkDescriptorSet*> current_descriptor_set = frametech::Engine::getInstance()->m_render->getGraphicsPipeline()->getDescriptorSet(current_frame_index);
@@ -263,8 +300,13 @@ ftstd::VResult frametech::graphics::Command::record()
             nullptr);
     }
 
-    u32 indices_size = static_cast<u32>(frametech::Engine::getInstance()->m_render->getGraphicsPipeline()->getIndices().size());
-    vkCmdDrawIndexed(m_buffer, indices_size, 1, 0, 0, 0);
+    // One draw per range of meshlets left by the culling, sorted by material with the submeshes -
+    // they all share the vertex and index buffers bound above, from the ranges of the mesh
+    const auto graphics_pipeline = frametech::Engine::getInstance()->m_render->getGraphicsPipeline();
+    const u32 first_index = graphics_pipeline->getFirstIndex();
+    const i32 first_vertex = graphics_pipeline->getFirstVertex();
+    for (const frametech::graphics::IndexRange& range : graphics_pipeline->getDrawRanges())
+        vkCmdDrawIndexed(m_buffer, range.m_indices_count, 1, first_index + range.m_first_index, first_vertex + range.m_vertex_offset, 0);
 
 #ifdef IMGUI
     ImGui::Render();
@@ -51,17 +51,27 @@ namespace frametech
             /// @brief Initializes the command buffer
             /// @return A VResult type
             ftstd::VResult begin();
-            /// @brief Ends the record of the current command buffer
+            /// @brief Ends the record of the current command buffer, submits it, and waits for the
+            /// queue to be idle to free it
+            /// @param fence Signaled once the command buffer has been executed (optional)
             /// @return A VResult type
-            ftstd::VResult end(const VkQueue& queue, const u32 submit_count);
+            ftstd::VResult end(const VkQueue& queue, const u32 submit_count, const VkFence fence = VK_NULL_HANDLE);
+            /// @brief Ends the record of the current command buffer, and submits it without waiting:
+            /// the buffer must be freed by the caller once `timeline` has reached `value`
+            /// @param timeline Timeline semaphore, signaled once the command buffer has been executed
+            /// @param value The value `timeline` is signaled with
+            /// @return A VResult type
+            ftstd::VResult submit(const VkQueue& queue, const VkSemaphore timeline, const u64 value);
             /// @brief Transition barrier for an image
             /// @param memory_barrier Image memory barrier for the memory transition
+            /// @param level_count The number of mip levels to transition, from the first one
             void transition(
                 const VkImage& image,
                 const VkImageLayout new_layout,
                 const VkImageLayout old_layout = VK_IMAGE_LAYOUT_UNDEFINED,
                 const u32 src_queue_family_index = VK_QUEUE_FAMILY_IGNORED,
-                const u32 dst_queue_family_index = VK_QUEUE_FAMILY_IGNORED) const noexcept;
+                const u32 dst_queue_family_index = VK_QUEUE_FAMILY_IGNORED,
+                const u32 level_count = 1) const noexcept;
             /// @brief Writes the commands we want to execute into a command buffer
             ftstd::VResult record();
             /// @brief The queue family index the command pool
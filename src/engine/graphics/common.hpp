@@ -19,6 +19,9 @@ typedef struct ModelViewProjection
     glm::mat4 model;
     glm::mat4 view;
     glm::mat4 projection;
+    // Offset (xy) and scale (zw) of the texture coordinates,
+    // to sample a region of an atlas page
+    glm::vec4 texture_rect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
 } ModelViewProjection;
 
 #endif // common_hpp
@@ -306,9 +306,49 @@ ftstd::VResult frametech::graphics::Device::createLogicalDevice()
     VkPhysicalDeviceFeatures device_features{};
     device_features.samplerAnisotropy = VK_TRUE;
 
+    // Enable BC compressed textures if the device can sample them - the textures
+    // are uploaded uncompressed otherwise
+    {
+        VkPhysicalDeviceFeatures supported_features{};
+        vkGetPhysicalDeviceFeatures(m_physical_device, &supported_features);
+        bool supports_bc_formats = VK_TRUE == supported_features.textureCompressionBC;
+        for (const VkFormat bc_format : {VK_FORMAT_BC1_RGB_SRGB_BLOCK, VK_FORMAT_BC3_SRGB_BLOCK})
+        {
+            VkFormatProperties format_properties{};
+            vkGetPhysicalDeviceFormatProperties(m_physical_device, bc_format, &format_properties);
+            supports_bc_formats = supports_bc_formats && (format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) != 0;
+        }
+        device_features.textureCompressionBC = supports_bc_formats ? VK_TRUE : VK_FALSE;
+        m_supports_texture_compression_bc = supports_bc_formats;
+        Log("> BC compressed textures %s", supports_bc_formats ? "enabled" : "not supported, falling back to RGBA8");
+    }
+
+    // Timeline semaphores, to synchronize the transfer queue with the graphics queue
+    // without blocking the CPU (see TransferQueue)
+    VkPhysicalDeviceVulkan12Features vulkan_12_features{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+    };
+    {
+        VkPhysicalDeviceFeatures2 supported_features{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+            .pNext = &vulkan_12_features,
+        };
+        vkGetPhysicalDeviceFeatures2(m_physical_device, &supported_features);
+        if (VK_TRUE != vulkan_12_features.timelineSemaphore)
+        {
+            LogE("> The physical device does not support timeline semaphores");
+            return ftstd::VResult::Error((char*)"Timeline semaphores are not supported");
+        }
+        vulkan_12_features = VkPhysicalDeviceVulkan12Features{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+            .timelineSemaphore = VK_TRUE,
+        };
+    }
+
     // Initializes the logical device
     VkDeviceCreateInfo logical_device_create_info{
         .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+        .pNext = &vulkan_12_features,
         .queueCreateInfoCount = static_cast<u32>(queues.size()),
         .pQueueCreateInfos = queues.data(),
         .enabledExtensionCount = static_cast<u32>(REQUIRED_EXTENSIONS.size()),
@@ -92,6 +92,13 @@ namespace frametech
             /// @brief Returns the Transfert queue of the logical device
             /// @return The Transfert queue of the logical device
             VkQueue& getTransfertQueue();
+            /// @brief Returns if the logical device has been created with the textureCompressionBC
+            /// feature, and can sample the BC1 / BC3 sRGB formats
+            /// @return If compressed textures can be uploaded as they are
+            bool supportsTextureCompressionBC() const noexcept
+            {
+                return m_supports_texture_compression_bc;
+            }
 
         private:
             /// @brief The physical device that has been picked
@@ -113,6 +120,8 @@ namespace frametech
             /// The transfert queue can be the same queue than
             /// the presents / graphics one
             VkQueue m_transfert_queue = VK_NULL_HANDLE;
+            /// @brief If BC compressed textures are enabled on the logical device
+            bool m_supports_texture_compression_bc = false;
         };
     } // namespace graphics
 } // namespace frametech
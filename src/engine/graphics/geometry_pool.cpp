@@ -0,0 +1,150 @@
+//
+//  geometry_pool.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#include "geometry_pool.hpp"
+#include "../../ftstd/debug_tools.h"
+#include "../engine.hpp"
+#include "memory.hpp"
+
+frametech::graphics::GeometryPool::~GeometryPool()
+{
+    destroy();
+}
+
+ftstd::VResult frametech::graphics::GeometryPool::create(VmaAllocator resources_allocator, const u64 vertex_pool_size, const u64 index_pool_size) noexcept
+{
+    destroy();
+    m_allocator = resources_allocator;
+    if (const auto result = createBuffer(vertex_pool_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, m_vertex_buffer, m_vertex_buffer_allocation); result.IsError())
+    {
+        destroy();
+        return result;
+    }
+    if (const auto result = createBuffer(index_pool_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, m_index_16_buffer, m_index_16_buffer_allocation); result.IsError())
+    {
+        destroy();
+        return result;
+    }
+    if (const auto result = createBuffer(index_pool_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, m_index_32_buffer, m_index_32_buffer_allocation); result.IsError())
+    {
+        destroy();
+        return result;
+    }
+    m_vertices.reset(vertex_pool_size);
+    m_indices_16.reset(index_pool_size);
+    m_indices_32.reset(index_pool_size);
+    Log("> Geometry pool created (%llu MB of vertices, 2 x %llu MB of indices)", vertex_pool_size >> 20, index_pool_size >> 20);
+    return ftstd::VResult::Ok();
+}
+
+void frametech::graphics::GeometryPool::destroy() noexcept
+{
+    if (VK_NULL_HANDLE == m_allocator)
+        return;
+    destroyBuffer(m_vertex_buffer, m_vertex_buffer_allocation);
+    destroyBuffer(m_index_16_buffer, m_index_16_buffer_allocation);
+    destroyBuffer(m_index_32_buffer, m_index_32_buffer_allocation);
+    releaseFreed();
+    m_vertices.reset(0);
+    m_indices_16.reset(0);
+    m_indices_32.reset(0);
+    m_allocator = VK_NULL_HANDLE;
+    Log("< Geometry pool destroyed");
+}
+
+ftstd::Result<frametech::graphics::OffsetAllocation> frametech::graphics::GeometryPool::allocateVertices(const u64 vertices_count, const u64 vertex_stride) noexcept
+{
+    // Aligned on the stride: the range starts at a vertex of the buffer
+    auto vertices = m_vertices.allocate(vertices_count * vertex_stride, vertex_stride);
+    if (vertices.IsError())
+    {
+        LogE("Cannot allocate %llu vertices in the geometry pool (%llu bytes used of %llu)", vertices_count, m_vertices.getUsedSize(), m_vertices.getSize());
+        return ftstd::Result<OffsetAllocation>::Error((char*)"The vertices do not fit in the geometry pool");
+    }
+    return vertices;
+}
+
+ftstd::Result<frametech::graphics::OffsetAllocation> frametech::graphics::GeometryPool::allocateIndices(const u64 indices_count, const VkIndexType index_type) noexcept
+{
+    OffsetAllocator& allocator = VK_INDEX_TYPE_UINT16 == index_type ? m_indices_16 : m_indices_32;
+    const u64 index_size = getIndexSize(index_type);
+    auto indices = allocator.allocate(indices_count * index_size, index_size);
+    if (indices.IsError())
+    {
+        LogE("Cannot allocate %llu indices in the geometry pool (%llu bytes used of %llu)", indices_count, allocator.getUsedSize(), allocator.getSize());
+        return ftstd::Result<OffsetAllocation>::Error((char*)"The indices do not fit in the geometry pool");
+    }
+    return indices;
+}
+
+void frametech::graphics::GeometryPool::freeVertices(const OffsetAllocation& vertices) noexcept
+{
+    if (0 != vertices.m_size)
+        m_freed_ranges.push_back(FreedRange{.m_allocator = &m_vertices, .m_range = vertices});
+}
+
+void frametech::graphics::GeometryPool::freeIndices(const OffsetAllocation& indices, const VkIndexType index_type) noexcept
+{
+    if (0 != indices.m_size)
+        m_freed_ranges.push_back(FreedRange{.m_allocator = VK_INDEX_TYPE_UINT16 == index_type ? &m_indices_16 : &m_indices_32, .m_range = indices});
+}
+
+ftstd::VResult frametech::graphics::GeometryPool::createDedicatedBuffer(const u64 size, const VkBufferUsageFlags usage, VkBuffer& buffer, VmaAllocation& allocation) noexcept
+{
+    if (const auto result = createBuffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | usage, buffer, allocation); result.IsError())
+        return result;
+    LogW("Dedicated geometry buffer of %llu bytes created, out of the geometry pool", size);
+    return ftstd::VResult::Ok();
+}
+
+void frametech::graphics::GeometryPool::freeDedicatedBuffer(VkBuffer& buffer, VmaAllocation& allocation) noexcept
+{
+    if (VK_NULL_HANDLE != buffer)
+        m_freed_buffers.push_back(FreedBuffer{.m_buffer = buffer, .m_allocation = allocation});
+    buffer = VK_NULL_HANDLE;
+    allocation = VK_NULL_HANDLE;
+}
+
+void frametech::graphics::GeometryPool::releaseFreed() noexcept
+{
+    for (const FreedRange& freed_range : m_freed_ranges)
+        freed_range.m_allocator->free(freed_range.m_range);
+    m_freed_ranges.clear();
+    for (FreedBuffer& freed_buffer : m_freed_buffers)
+        destroyBuffer(freed_buffer.m_buffer, freed_buffer.m_allocation);
+    m_freed_buffers.clear();
+}
+
+ftstd::VResult frametech::graphics::GeometryPool::createBuffer(const u64 size, const VkBufferUsageFlags usage, VkBuffer& buffer, VmaAllocation& allocation) noexcept
+{
+    const frametech::graphics::Device& graphics_device = frametech::Engine::getInstance()->m_graphics_device;
+    // Written by the transfer queue while the graphics queue draws the other ranges: the
+    // buffer cannot change of queue family at each upload
+    const u32 transfert_queue_family_index = graphics_device.m_transfert_queue_family_index;
+    const u32 graphics_queue_family_index = graphics_device.m_graphics_queue_family_index;
+    const bool is_shared = transfert_queue_family_index != graphics_queue_family_index;
+    return Memory::initBuffer(
+        m_allocator,
+        &allocation,
+        size,
+        buffer,
+        usage,
+        MemoryUsage::STATIC,
+        is_shared ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+        is_shared ? std::vector<u32>{transfert_queue_family_index, graphics_queue_family_index} : std::vector<u32>{});
+}
+
+void frametech::graphics::GeometryPool::destroyBuffer(VkBuffer& buffer, VmaAllocation& allocation) noexcept
+{
+    if (VK_NULL_HANDLE == buffer)
+        return;
+    if (auto& transfer_queue = frametech::Engine::getInstance()->m_transfer_queue; transfer_queue)
+        transfer_queue->wait(transfer_queue->forgetBuffer(buffer));
+    vmaDestroyBuffer(m_allocator, buffer, allocation);
+    buffer = VK_NULL_HANDLE;
+    allocation = VK_NULL_HANDLE;
+}
@@ -0,0 +1,135 @@
+//
+//  geometry_pool.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _geometry_pool_hpp
+#define _geometry_pool_hpp
+
+#include "../../ftstd/result.hpp"
+#include "../platform.hpp"
+#include "offset_allocator.hpp"
+#include <vector>
+#include <vk_mem_alloc.h>
+#include <vulkan/vulkan.h>
+
+namespace frametech
+{
+    namespace graphics
+    {
+        /// @brief The geometry of the engine: one vertex buffer, and one index buffer per index type,
+        /// shared by all the meshes. Each mesh gets a range of vertices and a range of indices
+        /// (see OffsetAllocator), drawn with the vertexOffset / firstIndex of vkCmdDrawIndexed: the
+        /// buffers are bound once per frame, and a mesh costs no allocation of device memory.
+        /// The buffers are device local, written by the transfer queue, and shared by the transfer and
+        /// the graphics queue families: the uploads do not transfer their ownership.
+        /// A mesh that does not fit in the pool gets dedicated buffers instead (see `createDedicatedBuffer`).
+        /// Not thread safe: used by the thread that owns the transfer queue.
+        class GeometryPool
+        {
+        public:
+            /// @brief Default size of the vertex buffer
+            static constexpr u64 DEFAULT_VERTEX_POOL_SIZE = 64ull * 1024 * 1024;
+            /// @brief Default size of each index buffer
+            static constexpr u64 DEFAULT_INDEX_POOL_SIZE = 32ull * 1024 * 1024;
+
+            GeometryPool() = default;
+            ~GeometryPool();
+            GeometryPool(GeometryPool const&) = delete;
+            GeometryPool& operator=(GeometryPool const&) = delete;
+
+            /// @brief Creates the vertex and index buffers
+            /// @param resources_allocator The allocator of the buffers
+            /// @param vertex_pool_size The size of the vertex buffer, in bytes
+            /// @param index_pool_size The size of each index buffer, in bytes
+            /// @return A VResult type
+            ftstd::VResult create(VmaAllocator resources_allocator,
+                                  const u64 vertex_pool_size = DEFAULT_VERTEX_POOL_SIZE,
+                                  const u64 index_pool_size = DEFAULT_INDEX_POOL_SIZE) noexcept;
+            /// @brief Releases the buffers - the draws and the uploads using them must be done
+            void destroy() noexcept;
+            /// @brief Allocates a range of `vertices_count` vertices of `vertex_stride` bytes
+            /// @return The range, in bytes - its first vertex is `m_offset / vertex_stride`
+            ftstd::Result<OffsetAllocation> allocateVertices(const u64 vertices_count, const u64 vertex_stride) noexcept;
+            /// @brief Allocates a range of `indices_count` indices of `index_type`
+            /// @return The range, in bytes - its first index is `m_offset / getIndexSize(index_type)`
+            ftstd::Result<OffsetAllocation> allocateIndices(const u64 indices_count, const VkIndexType index_type) noexcept;
+            /// @brief Frees a range of vertices, once the frame in flight is done (see `releaseFreed`)
+            void freeVertices(const OffsetAllocation& vertices) noexcept;
+            /// @brief Frees a range of indices of `index_type`, once the frame in flight is done (see `releaseFreed`)
+            void freeIndices(const OffsetAllocation& indices, const VkIndexType index_type) noexcept;
+            /// @brief Creates a buffer of `size` bytes outside of the pool, with the same usage and sharing
+            /// as the pool ones - for the geometry that does not fit in the pool
+            /// @param usage VK_BUFFER_USAGE_VERTEX_BUFFER_BIT or VK_BUFFER_USAGE_INDEX_BUFFER_BIT
+            /// @return A VResult type
+            ftstd::VResult createDedicatedBuffer(const u64 size, const VkBufferUsageFlags usage, VkBuffer& buffer, VmaAllocation& allocation) noexcept;
+            /// @brief Destroys a dedicated buffer, once the frame in flight is done (see `releaseFreed`) - no-op for a null buffer
+            void freeDedicatedBuffer(VkBuffer& buffer, VmaAllocation& allocation) noexcept;
+            /// @brief Releases the ranges and the dedicated buffers freed so far - to call once the frames that may draw them are done
+            void releaseFreed() noexcept;
+            /// @brief Returns the vertex buffer
+            const VkBuffer& getVertexBuffer() const noexcept { return m_vertex_buffer; }
+            /// @brief Returns the index buffer of `index_type`
+            const VkBuffer& getIndexBuffer(const VkIndexType index_type) const noexcept
+            {
+                return VK_INDEX_TYPE_UINT16 == index_type ? m_index_16_buffer : m_index_32_buffer;
+            }
+            /// @brief Returns the size of an index of `index_type`, in bytes
+            static u64 getIndexSize(const VkIndexType index_type) noexcept
+            {
+                return VK_INDEX_TYPE_UINT16 == index_type ? sizeof(u16) : sizeof(u32);
+            }
+
+        private:
+            /// @brief A range freed, not released yet
+            struct FreedRange
+            {
+                /// @brief The allocator of the range
+                OffsetAllocator* m_allocator;
+                /// @brief The range
+                OffsetAllocation m_range;
+            };
+            /// @brief A dedicated buffer freed, not destroyed yet
+            struct FreedBuffer
+            {
+                /// @brief The buffer
+                VkBuffer m_buffer;
+                /// @brief Allocation of the buffer
+                VmaAllocation m_allocation;
+            };
+            /// @brief Creates a buffer of the pool
+            ftstd::VResult createBuffer(const u64 size, const VkBufferUsageFlags usage, VkBuffer& buffer, VmaAllocation& allocation) noexcept;
+            /// @brief Destroys a buffer of the pool, once its uploads are done
+            void destroyBuffer(VkBuffer& buffer, VmaAllocation& allocation) noexcept;
+            /// @brief The allocator of the buffers
+            VmaAllocator m_allocator = VK_NULL_HANDLE;
+            /// @brief The vertex buffer
+            VkBuffer m_vertex_buffer = VK_NULL_HANDLE;
+            /// @brief Allocation of the vertex buffer
+            VmaAllocation m_vertex_buffer_allocation = {};
+            /// @brief Ranges of the vertex buffer
+            OffsetAllocator m_vertices;
+            /// @brief The index buffer of 16 bits indices
+            VkBuffer m_index_16_buffer = VK_NULL_HANDLE;
+            /// @brief Allocation of the 16 bits index buffer
+            VmaAllocation m_index_16_buffer_allocation = {};
+            /// @brief Ranges of the 16 bits index buffer
+            OffsetAllocator m_indices_16;
+            /// @brief The index buffer of 32 bits indices
+            VkBuffer m_index_32_buffer = VK_NULL_HANDLE;
+            /// @brief Allocation of the 32 bits index buffer
+            VmaAllocation m_index_32_buffer_allocation = {};
+            /// @brief Ranges of the 32 bits index buffer
+            OffsetAllocator m_indices_32;
+            /// @brief The ranges freed since the last `releaseFreed`
+            std::vector<FreedRange> m_freed_ranges;
+            /// @brief The dedicated buffers freed since the last `releaseFreed`
+            std::vector<FreedBuffer> m_freed_buffers;
+        };
+    } // namespace graphics
+} // namespace frametech
+
+#endif // _geometry_pool_hpp
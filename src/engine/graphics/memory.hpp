@@ -12,6 +12,7 @@
 #include "../../ftstd/result.hpp"
 #include "command.hpp"
 #include <assert.h>
+#include <vector>
 #include <vk_mem_alloc.h>
 #include <vulkan/vulkan.h>
 
@@ -19,6 +20,36 @@ namespace frametech
 {
     namespace graphics
     {
+        /// @brief A staging buffer, mapped for its whole lifetime: the CPU writes in it
+        /// (decodes, generates, compresses...) and the transfer queue copies from it
+        struct StagingBuffer
+        {
+            /// @brief The Vulkan buffer - source of the copies
+            VkBuffer m_buffer = VK_NULL_HANDLE;
+            /// @brief The allocation of the buffer
+            VmaAllocation m_allocation = VK_NULL_HANDLE;
+            /// @brief The mapped memory of the buffer - nullptr if there is no buffer
+            unsigned char* m_data = nullptr;
+            /// @brief Size of the buffer, in bytes
+            u64 m_size = 0;
+        };
+
+        /// @brief How the CPU and the GPU access a resource - selects its memory type
+        enum class MemoryUsage
+        {
+            /// @brief Written once by a copy of the transfer queue, then only read by the GPU
+            /// (geometry, textures): device local memory
+            STATIC,
+            /// @brief Written by the CPU every frame, read by the GPU (uniforms): host visible
+            /// memory, device local if possible
+            DYNAMIC,
+            /// @brief Written by the GPU, read back by the CPU: host visible and cached memory
+            READBACK,
+            /// @brief Written by the CPU, source of copies of the transfer queue: host visible memory
+            /// (see `initStagingBuffer` for the mapped staging buffers)
+            STAGING,
+        };
+
         class Memory
         {
         private:
@@ -39,41 +70,118 @@ namespace frametech
                 return ftstd::Result<u32>::Error((char*)"findMemoryType: did not found any memory type with favorite filter / properties");
             }
 
+            /// @brief Returns the allocation parameters of a resource accessed as `memory_usage`
+            static VmaAllocationCreateInfo getAllocationCreateInfo(const MemoryUsage memory_usage) noexcept
+            {
+                // Windows build : check why VMA_MEMORY_USAGE_AUTO does not work on Windows...
+                switch (memory_usage)
+                {
+                    case MemoryUsage::STATIC:
+                        return VmaAllocationCreateInfo{
+                            .usage = VMA_MEMORY_USAGE_GPU_ONLY,
+                            .preferredFlags = VkMemoryPropertyFlags(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+                        };
+                    case MemoryUsage::DYNAMIC:
+                        return VmaAllocationCreateInfo{
+                            .flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
+                            .usage = VMA_MEMORY_USAGE_CPU_TO_GPU,
+                        };
+                    case MemoryUsage::READBACK:
+                        return VmaAllocationCreateInfo{
+                            .flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+                            .usage = VMA_MEMORY_USAGE_GPU_TO_CPU,
+                        };
+                    case MemoryUsage::STAGING:
+                    default:
+                        return VmaAllocationCreateInfo{
+                            .usage = VMA_MEMORY_USAGE_CPU_ONLY,
+                        };
+                }
+            }
+
         public:
             /// @brief Initialize a given buffer
-            /// @param buffer_size The size to allocate
+            /// @param buffer_size The size to allocate, in bytes
             /// @param buffer The buffer to allocate
             /// @param buffer_usage Usage flag(s) for the buffer
+            /// @param memory_usage How the buffer is accessed - STATIC buffers are not host visible,
+            /// and are written by copies only
             /// @param buffer_sharing_mode Sharing mode for the buffer
+            /// @param queue_family_indices The queue families sharing the buffer, if VK_SHARING_MODE_CONCURRENT
             /// @return A VResult type to know if the initialization succeeded or not
             static ftstd::VResult initBuffer(
                 VmaAllocator& resources_allocator,
                 VmaAllocation* allocation,
-                const int buffer_size,
+                const u64 buffer_size,
                 VkBuffer& buffer,
                 const VkBufferUsageFlags buffer_usage,
-                const VkSharingMode buffer_sharing_mode = VK_SHARING_MODE_EXCLUSIVE) noexcept
+                const MemoryUsage memory_usage,
+                const VkSharingMode buffer_sharing_mode = VK_SHARING_MODE_EXCLUSIVE,
+                const std::vector<u32>& queue_family_indices = {}) noexcept
             {
                 VkBufferCreateInfo buffer_create_info{
                     .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
                     .size = static_cast<VkDeviceSize>(buffer_size),
                     .usage = buffer_usage,
                     .sharingMode = buffer_sharing_mode,
+                    .queueFamilyIndexCount = static_cast<u32>(queue_family_indices.size()),
+                    .pQueueFamilyIndices = queue_family_indices.data(),
                 };
 
-                VmaAllocationCreateInfo alloc_info = {
-                    .flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
-                    .usage = VMA_MEMORY_USAGE_CPU_TO_GPU,
-                };
+                const VmaAllocationCreateInfo alloc_info = getAllocationCreateInfo(memory_usage);
 
                 if (vmaCreateBuffer(resources_allocator, &buffer_create_info, &alloc_info, &buffer, allocation, nullptr) != VK_SUCCESS)
                 {
-                    LogE("vmaCreateBuffer: cannot initiate the buffer with size of %d bytes", buffer_size);
+                    LogE("vmaCreateBuffer: cannot initiate the buffer with size of %llu bytes", buffer_size);
                     return ftstd::VResult::Error((char*)"vmaCreateBuffer: cannot initiate the buffer");
                 }
                 return ftstd::VResult::Ok();
             }
 
+            /// @brief Initialize a staging buffer, mapped until it is destroyed.
+            /// The memory is cached on the host if possible: the CPU can read back what it writes
+            /// (to generate the next mip level, to compress...) at the speed of regular memory.
+            /// The allocator is internally synchronized: can be called from any thread.
+            /// @param resources_allocator Allocator for the resources
+            /// @param buffer_size The size to allocate, in bytes
+            /// @param staging_buffer The buffer to initialize (out)
+            /// @return A VResult type to know if the initialization succeeded or not
+            static ftstd::VResult initStagingBuffer(
+                VmaAllocator& resources_allocator,
+                const u64 buffer_size,
+                StagingBuffer& staging_buffer) noexcept
+            {
+                VkBufferCreateInfo buffer_create_info{
+                    .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+                    .size = static_cast<VkDeviceSize>(buffer_size),
+                    .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                    .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+                };
+
+                VmaAllocationCreateInfo alloc_info = getAllocationCreateInfo(MemoryUsage::STAGING);
+                alloc_info.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+                alloc_info.preferredFlags |= VkMemoryPropertyFlags(VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+
+                VmaAllocationInfo allocation_info{};
+                if (vmaCreateBuffer(resources_allocator, &buffer_create_info, &alloc_info, &staging_buffer.m_buffer, &staging_buffer.m_allocation, &allocation_info) != VK_SUCCESS)
+                {
+                    LogE("vmaCreateBuffer: cannot initiate the staging buffer with size of %llu bytes", buffer_size);
+                    staging_buffer = StagingBuffer{};
+                    return ftstd::VResult::Error((char*)"vmaCreateBuffer: cannot initiate the staging buffer");
+                }
+                staging_buffer.m_data = static_cast<unsigned char*>(allocation_info.pMappedData);
+                staging_buffer.m_size = buffer_size;
+                return ftstd::VResult::Ok();
+            }
+
+            /// @brief Destroys a staging buffer, if any - `staging_buffer` is reset
+            static void destroyStagingBuffer(VmaAllocator& resources_allocator, StagingBuffer& staging_buffer) noexcept
+            {
+                if (VK_NULL_HANDLE != staging_buffer.m_buffer)
+                    vmaDestroyBuffer(resources_allocator, staging_buffer.m_buffer, staging_buffer.m_allocation);
+                staging_buffer = StagingBuffer{};
+            }
+
             /// @brief Copy the data from the source image to the destination VkImage
             /// @param resources_allocator Allocator for the resources
             /// @param allocation Allocation structure (out)
@@ -86,11 +194,8 @@ namespace frametech
                 VkImage& image,
                 VkImageCreateInfo& image_create_info) noexcept
             {
-                VmaAllocationCreateInfo alloc_info = {
-                    .flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
-                    // Windows build : check why VMA_MEMORY_USAGE_AUTO does not work on Windows...
-                    .usage = VMA_MEMORY_USAGE_GPU_ONLY,
-                };
+                // Sampled textures are written by copies only
+                const VmaAllocationCreateInfo alloc_info = getAllocationCreateInfo(MemoryUsage::STATIC);
 
                 if (vmaCreateImage(resources_allocator, &image_create_info, &alloc_info, &image, allocation, nullptr) != VK_SUCCESS)
                 {
@@ -133,6 +238,7 @@ namespace frametech
             /// @param dst_offset Offset of the destination buffer to copy to (default should be 0)
             /// @param transfert_command_pool The Transfert command pool
             /// @param size The size of the buffer to copy
+            /// @param fence Signaled once the copy is done (optional)
             /// @return A VResult type to know if the operation performed well or not
             static ftstd::VResult copyBufferToBuffer(
                 VkBuffer& src,
@@ -141,7 +247,8 @@ namespace frametech
                 VkDeviceSize dst_offset,
                 VkCommandPool* transfert_command_pool,
                 const VkQueue& transfert_queue,
-                const VkDeviceSize size)
+                const VkDeviceSize size,
+                const VkFence fence = VK_NULL_HANDLE)
             {
 
                 frametech::graphics::Command command_buffer(*transfert_command_pool);
@@ -161,7 +268,7 @@ namespace frametech
                     ++submit_count;
                 }
 
-                command_buffer.end(transfert_queue, submit_count);
+                command_buffer.end(transfert_queue, submit_count, fence);
                 return ftstd::VResult::Ok();
             }
 
@@ -216,6 +323,34 @@ namespace frametech
                 command_buffer.end(transfert_queue, submit_count);
                 return ftstd::VResult::Ok();
             }
+
+            /// @brief Copies several regions of a buffer (e.g. the mip levels of a texture)
+            /// to an image, with a single command
+            /// @param fence Signaled once the copy is done (optional)
+            static ftstd::VResult copyBufferToImage(
+                VkBuffer& src_buffer,
+                VkImage& dst_image,
+                VkCommandPool* transfert_command_pool,
+                const VkQueue& transfert_queue,
+                const std::vector<VkBufferImageCopy>& copy_regions,
+                const VkFence fence = VK_NULL_HANDLE)
+            {
+                if (copy_regions.empty())
+                    return ftstd::VResult::Error((char*)"No region to copy to the image");
+
+                frametech::graphics::Command command_buffer(*transfert_command_pool);
+                command_buffer.createBuffer();
+                command_buffer.begin();
+                vkCmdCopyBufferToImage(
+                    *command_buffer.getBuffer(),
+                    src_buffer,
+                    dst_image,
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                    static_cast<u32>(copy_regions.size()),
+                    copy_regions.data());
+                command_buffer.end(transfert_queue, 1, fence);
+                return ftstd::VResult::Ok();
+            }
         };
     } // namespace graphics
 } // namespace frametech
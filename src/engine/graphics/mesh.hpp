@@ -10,9 +10,18 @@
 #define mesh_h
 
 #include "../../engine/graphics/shaders.h"
+#include "../../ftstd/hash.hpp"
+#include "../../ftstd/mapped_file.hpp"
 #include "../platform.hpp"
+#include "mesh_file.hpp"
+#include "mesh_optimizer.hpp"
+#include "mesh_simplifier.hpp"
+#include "meshlet.hpp"
+#include "obj_parser.hpp"
+#include <algorithm>
+#include <memory>
+#include <string>
 #include <vector>
-#include <objloader/objloader.h>
 
 namespace frametech
 {
@@ -20,8 +29,12 @@ namespace frametech
     {
     // TODO : consider all meshes coming from MODELS files
     // TODO : MODELS files to dict to know which ones are available
-        /// @brief Maximum number of characters to name a mesh
-        constexpr u32 MESH_2D_NAME_LENGTH = 20;
+        /// @brief Maximum number of characters to name a mesh - long enough for the path of its file
+        constexpr u32 MESH_2D_NAME_LENGTH = 64;
+        /// @brief Maximum number of characters to name a material
+        constexpr u32 MESH_MATERIAL_NAME_LENGTH = 64;
+        /// @brief The mesh loaded by Mesh2D::FROM_FILE
+        constexpr const char* DEFAULT_MESH_FILE = "MODELS/viking_room.obj";
 
         /// @brief Basic 2D meshes
         enum class Mesh2D
@@ -38,6 +51,42 @@ namespace frametech
             FROM_FILE = 4
         };
 
+        /// @brief A part of a Mesh object drawn with its own material (an object or a group of an OBJ file).
+        /// The submeshes share the vertices and the indices of the mesh: the indices of a submesh
+        /// start from 0, and are offset by m_vertex_offset when drawn.
+        /// Stored as is in the binary mesh files.
+        struct Submesh
+        {
+            /// @brief Minimum corner of the bounding box, in mesh space
+            glm::vec3 m_bounds_min;
+            /// @brief Index of the material in the materials of the mesh
+            u32 m_material;
+            /// @brief Maximum corner of the bounding box, in mesh space
+            glm::vec3 m_bounds_max;
+            /// @brief First vertex of the submesh, added to its indices
+            i32 m_vertex_offset;
+            /// @brief Number of vertices of the submesh
+            u32 m_vertices_count;
+            /// @brief First level of detail of the submesh in the levels of detail of the mesh
+            u32 m_first_lod;
+            /// @brief Number of levels of detail of the submesh - at least 1, the full submesh
+            u32 m_lods_count;
+            /// @brief First meshlet of the submesh in the meshlets of the mesh
+            u32 m_first_meshlet;
+            /// @brief Number of meshlets of the submesh - 0 if it has not been split
+            u32 m_meshlets_count;
+            u32 m_padding[3];
+        };
+        static_assert(sizeof(Submesh) == 64, "the submeshes are stored in the binary mesh files");
+
+        /// @brief A material referenced by the submeshes - only its name for now (`usemtl` in the OBJ files).
+        /// Stored as is in the binary mesh files.
+        struct MeshMaterial
+        {
+            /// @brief The name of the material - empty for the default one
+            char m_name[MESH_MATERIAL_NAME_LENGTH];
+        };
+
         /// @brief Stores all information about
         /// a Mesh object
         struct Mesh
@@ -48,36 +97,336 @@ namespace frametech
             std::vector<frametech::engine::graphics::shaders::Vertex> m_vertices;
             /// @brief The indices of the Mesh object
             /// 32 bits (unsigned) integers should be more than enough here
-            /// Possible optimization: reduce to 16 bits (unsigned) integers if
+            /// The pipeline narrows them to 16 bits (unsigned) integers on upload if
             /// we are using less than 65536 unique vertices
             std::vector<u32> m_indices;
             /// @brief The type of the Mesh object
             Mesh2D m_type;
+            /// @brief The binary mesh file (see MeshFile) the data is read from, if any.
+            /// If set, m_vertices and m_indices stay empty: the data lives in the mapping.
+            std::shared_ptr<ftstd::MappedFile> m_source = nullptr;
+            /// @brief The vertices in m_source
+            const frametech::engine::graphics::shaders::Vertex* m_source_vertices = nullptr;
+            /// @brief The number of vertices in m_source
+            u64 m_source_vertices_count = 0;
+            /// @brief The indices in m_source
+            const u32* m_source_indices = nullptr;
+            /// @brief The number of indices in m_source
+            u64 m_source_indices_count = 0;
+            /// @brief The meshlets of the Mesh object - empty if it has not been split
+            /// (see MeshletUtils::buildMeshlets)
+            std::vector<Meshlet> m_meshlets;
+            /// @brief The meshlets in m_source
+            const Meshlet* m_source_meshlets = nullptr;
+            /// @brief The number of meshlets in m_source
+            u64 m_source_meshlets_count = 0;
+            /// @brief The levels of detail of the Mesh object, from the full mesh - empty if
+            /// they have not been built (see MeshSimplifier::buildLods)
+            std::vector<MeshLod> m_lods;
+            /// @brief The levels of detail in m_source
+            const MeshLod* m_source_lods = nullptr;
+            /// @brief The number of levels of detail in m_source
+            u64 m_source_lods_count = 0;
+            /// @brief The submeshes of the Mesh object, sorted by material - empty if the whole mesh
+            /// is a single submesh
+            std::vector<Submesh> m_submeshes;
+            /// @brief The submeshes in m_source
+            const Submesh* m_source_submeshes = nullptr;
+            /// @brief The number of submeshes in m_source
+            u64 m_source_submeshes_count = 0;
+            /// @brief The materials referenced by the submeshes
+            std::vector<MeshMaterial> m_materials;
+            /// @brief The materials in m_source
+            const MeshMaterial* m_source_materials = nullptr;
+            /// @brief The number of materials in m_source
+            u64 m_source_materials_count = 0;
+
+            /// @brief Returns the vertices of the Mesh object, wherever they are stored
+            const frametech::engine::graphics::shaders::Vertex* getVertexData() const noexcept
+            {
+                return nullptr != m_source ? m_source_vertices : m_vertices.data();
+            }
+            /// @brief Returns the number of vertices of the Mesh object
+            u64 getVerticesCount() const noexcept
+            {
+                return nullptr != m_source ? m_source_vertices_count : m_vertices.size();
+            }
+            /// @brief Returns the indices of the Mesh object, wherever they are stored
+            const u32* getIndexData() const noexcept
+            {
+                return nullptr != m_source ? m_source_indices : m_indices.data();
+            }
+            /// @brief Returns the number of indices of the Mesh object
+            u64 getIndicesCount() const noexcept
+            {
+                return nullptr != m_source ? m_source_indices_count : m_indices.size();
+            }
+            /// @brief Returns the meshlets of the Mesh object, wherever they are stored
+            const Meshlet* getMeshletData() const noexcept
+            {
+                return nullptr != m_source ? m_source_meshlets : m_meshlets.data();
+            }
+            /// @brief Returns the number of meshlets of the Mesh object
+            u64 getMeshletsCount() const noexcept
+            {
+                return nullptr != m_source ? m_source_meshlets_count : m_meshlets.size();
+            }
+            /// @brief Returns the number of submeshes of the Mesh object - at least 1, the whole mesh
+            u64 getSubmeshesCount() const noexcept
+            {
+                const u64 submeshes_count = nullptr != m_source ? m_source_submeshes_count : m_submeshes.size();
+                return 0 == submeshes_count ? 1 : submeshes_count;
+            }
+            /// @brief Returns the submesh `index`. Without submeshes, the whole mesh is returned as a
+            /// single submesh, with empty bounds (to compute from the vertices).
+            Submesh getSubmesh(const u64 index) const noexcept
+            {
+                const Submesh* submeshes = nullptr != m_source ? m_source_submeshes : m_submeshes.data();
+                const u64 submeshes_count = nullptr != m_source ? m_source_submeshes_count : m_submeshes.size();
+                if (index < submeshes_count)
+                    return submeshes[index];
+                return Submesh{
+                    .m_bounds_min = glm::vec3(0.0f),
+                    .m_material = 0,
+                    .m_bounds_max = glm::vec3(0.0f),
+                    .m_vertex_offset = 0,
+                    .m_vertices_count = static_cast<u32>(getVerticesCount()),
+                    .m_first_lod = 0,
+                    .m_lods_count = static_cast<u32>(nullptr != m_source ? m_source_lods_count : m_lods.size()),
+                    .m_first_meshlet = 0,
+                    .m_meshlets_count = static_cast<u32>(getMeshletsCount()),
+                };
+            }
+            /// @brief Returns the number of materials referenced by the submeshes
+            u64 getMaterialsCount() const noexcept
+            {
+                return nullptr != m_source ? m_source_materials_count : m_materials.size();
+            }
+            /// @brief Returns the name of the material `material` - empty if unknown
+            const char* getMaterialName(const u32 material) const noexcept
+            {
+                const MeshMaterial* materials = nullptr != m_source ? m_source_materials : m_materials.data();
+                return material < getMaterialsCount() ? materials[material].m_name : "";
+            }
+            /// @brief Returns the number of levels of detail of `submesh` - at least 1, the full submesh
+            u64 getLodsCount(const Submesh& submesh) const noexcept
+            {
+                return 0 == submesh.m_lods_count ? 1 : submesh.m_lods_count;
+            }
+            /// @brief Returns the largest number of levels of detail of the submeshes
+            u64 getMaxLodsCount() const noexcept
+            {
+                u64 lods_count = 1;
+                for (u64 i = 0; i < getSubmeshesCount(); ++i)
+                    lods_count = std::max(lods_count, getLodsCount(getSubmesh(i)));
+                return lods_count;
+            }
+            /// @brief Returns the level of detail `level` of `submesh` - the last one if there are less levels
+            MeshLod getLod(const Submesh& submesh, const u64 level) const noexcept
+            {
+                if (0 == submesh.m_lods_count)
+                    return MeshLod{.m_first_index = 0, .m_indices_count = static_cast<u32>(getIndicesCount()), .m_error = 0.0f};
+                const MeshLod* lods = (nullptr != m_source ? m_source_lods : m_lods.data()) + submesh.m_first_lod;
+                return lods[level < submesh.m_lods_count ? level : submesh.m_lods_count - 1];
+            }
+        };
+
+        /// @brief Processing passes run on a mesh file once parsed, before it gets cached
+        struct MeshImportSettings
+        {
+            /// @brief Tolerance used to weld the vertices - see MeshOptimizer::weldVertices
+            f32 m_weld_epsilon = DEFAULT_WELD_EPSILON;
+            /// @brief Reorders the triangles for the post-transform vertex cache
+            bool m_optimize_vertex_cache = true;
+            /// @brief Reorders the clusters of triangles to reduce overdraw (after the vertex cache pass)
+            bool m_optimize_overdraw = false;
+            /// @brief Reorders the vertices in the order of the indices
+            bool m_optimize_vertex_fetch = true;
+            /// @brief Ratio of the triangles kept by each level of detail - no level of detail if empty
+            std::vector<f32> m_lod_ratios = {0.5f, 0.25f, 0.125f};
+            /// @brief Splits the full mesh in meshlets, to cull them on the CPU - only meshes with
+            /// at least MESHLET_MIN_MESH_TRIANGLES triangles are split
+            bool m_build_meshlets = true;
         };
 
         /// @brief Utility class to interact with Mesh objects
         class MeshUtils
         {
         public:
-            static ftstd::Result<Mesh> loadFromFile(const char* const pathfile) noexcept {
-                objl::Loader obj_loader {};
-                if (!obj_loader.LoadFile(pathfile)) {
-                    LogE("cannot load mesh from file '%s'", pathfile);
-                    return ftstd::Result<Mesh>::Error((char*)"cannot load mesh");
+            /// @brief Imports a Mesh object from an OBJ content.
+            /// Each object / group / material of the content becomes a submesh, sorted by material: once parsed,
+            /// each submesh goes through the passes of `settings` (see MeshOptimizer), then all of them
+            /// are packed in the vertices and the indices of the mesh.
+            /// @param content The OBJ content
+            /// @param content_size The size of content, in bytes
+            /// @param name The name of the mesh - the path of its file
+            /// @param settings The processing passes to run on the parsed mesh
+            /// @return A Mesh object, as a result
+            static ftstd::Result<Mesh> importObj(const char* content, const u64 content_size, const char* name, const MeshImportSettings& settings = MeshImportSettings{}) noexcept {
+                Mesh mesh {
+                    .m_type = Mesh2D::FROM_FILE,
+                };
+                strncpy(mesh.m_name, name, MESH_2D_NAME_LENGTH);
+                mesh.m_name[MESH_2D_NAME_LENGTH - 1] = '\0';
+                std::vector<frametech::engine::graphics::shaders::Vertex> vertices;
+                std::vector<u32> indices;
+                std::vector<ObjGroup> groups;
+                if (ObjParser::parse(content, content_size, vertices, indices, &groups).IsError()) {
+                    LogE("cannot parse mesh from file '%s'", name);
+                    return ftstd::Result<Mesh>::Error((char*)"cannot parse mesh");
                 }
-                std::vector<frametech::engine::graphics::shaders::Vertex> vertices(obj_loader.LoadedVertices.size());
-                for (int vertex_index = 0; vertex_index < obj_loader.LoadedVertices.size(); ++vertex_index) {
-                    vertices[vertex_index] = frametech::engine::graphics::shaders::Vertex::fromObjLoaderVertex(obj_loader.LoadedVertices[vertex_index]);
+                // Sorted by material: the draws sharing a material follow each other
+                std::stable_sort(groups.begin(), groups.end(), [](const ObjGroup& a, const ObjGroup& b) {
+                    return a.m_material < b.m_material;
+                });
+                for (const ObjGroup& group : groups) {
+                    Mesh part {
+                        .m_type = Mesh2D::FROM_FILE,
+                    };
+                    snprintf(part.m_name, MESH_2D_NAME_LENGTH, "%s", group.m_name.empty() ? name : group.m_name.c_str());
+                    part.m_vertices.assign(vertices.begin() + group.m_first_vertex, vertices.begin() + group.m_first_vertex + group.m_vertices_count);
+                    part.m_indices.reserve(group.m_indices_count);
+                    for (u32 i = 0; i < group.m_indices_count; ++i)
+                        part.m_indices.push_back(indices[group.m_first_index + i] - group.m_first_vertex);
+                    runImportPasses(part, settings);
+                    if (appendSubmesh(mesh, part, group.m_material).IsError()) {
+                        LogE("cannot add the submesh '%s' to mesh '%s'", part.m_name, name);
+                        return ftstd::Result<Mesh>::Error((char*)"cannot add submesh");
+                    }
                 }
+                Log("> Mesh '%s' imported with %zu submeshes, %zu materials", name, mesh.m_submeshes.size(), mesh.m_materials.size());
+                return ftstd::Result<Mesh>::Ok(mesh);
+            }
+            /// @brief Returns the hash of the import settings, stored in the binary mesh files: a file
+            /// processed with other settings is imported again
+            static u64 getSettingsHash(const MeshImportSettings& settings) noexcept {
+                // Hash the fields one by one: the padding of the structure is not initialized
+                u32 weld_epsilon;
+                memcpy(&weld_epsilon, &settings.m_weld_epsilon, sizeof(f32));
+                const u64 settings_fields[] = {
+                    weld_epsilon,
+                    settings.m_optimize_vertex_cache ? 1ull : 0ull,
+                    settings.m_optimize_overdraw ? 1ull : 0ull,
+                    settings.m_optimize_vertex_fetch ? 1ull : 0ull,
+                    settings.m_build_meshlets ? 1ull : 0ull,
+                    settings.m_lod_ratios.size(),
+                };
+                const u64 seed = ftstd::hash::xxh64(settings_fields, sizeof(settings_fields));
+                return ftstd::hash::xxh64(settings.m_lod_ratios.data(), settings.m_lod_ratios.size() * sizeof(f32), seed);
+            }
+            /// @brief Loads a Mesh object from an OBJ file (see importObj).
+            /// The result is cached in a binary mesh file next to the OBJ file (see MeshFile):
+            /// if this cache is up-to-date, it is mapped and used instead of parsing the OBJ file.
+            /// @param pathfile The path of the OBJ file
+            /// @param settings The processing passes to run on the parsed mesh
+            /// @return A Mesh object, as a result
+            static ftstd::Result<Mesh> loadFromFile(const char* const pathfile, const MeshImportSettings& settings = MeshImportSettings{}) noexcept {
+                const std::string cache_path = MeshFile::getCachePath(pathfile);
                 Mesh mesh {
-                    .m_vertices = vertices,
-                    .m_indices = obj_loader.LoadedIndices,
                     .m_type = Mesh2D::FROM_FILE,
                 };
                 strncpy(mesh.m_name, pathfile, MESH_2D_NAME_LENGTH);
                 mesh.m_name[MESH_2D_NAME_LENGTH - 1] = '\0';
+                const u64 settings_hash = getSettingsHash(settings);
+                if (MeshFile::isUpToDate(cache_path.c_str(), pathfile) &&
+                    !MeshFile::read(cache_path.c_str(), mesh, settings_hash).IsError()) {
+                    Log("> Mesh '%s' loaded from its binary cache '%s'", pathfile, cache_path.c_str());
+                    return ftstd::Result<Mesh>::Ok(mesh);
+                }
+
+                ftstd::MappedFile obj_file;
+                if (obj_file.open(pathfile, ftstd::MappedFile::Access::SEQUENTIAL).IsError()) {
+                    LogE("cannot load mesh from file '%s'", pathfile);
+                    return ftstd::Result<Mesh>::Error((char*)"cannot load mesh");
+                }
+                auto imported = importObj(obj_file.data(), obj_file.size(), pathfile, settings);
+                if (imported.IsError())
+                    return imported;
+                mesh = imported.GetValue();
+                // Not being able to write the cache is not an error: next load parses again
+                if (MeshFile::write(cache_path.c_str(), mesh, settings_hash).IsError())
+                    LogW("cannot write the binary cache of mesh '%s'", pathfile);
                 return ftstd::Result<Mesh>::Ok(mesh);
             }
+            /// @brief Runs the processing passes of `settings` on a mesh, in place
+            /// @param mesh The mesh to process - stored in m_vertices / m_indices, without submeshes
+            /// @param settings The processing passes to run
+            static void runImportPasses(Mesh& mesh, const MeshImportSettings& settings) noexcept
+            {
+                if (MeshOptimizer::weldVertices(mesh, settings.m_weld_epsilon).IsError())
+                    LogW("cannot weld the vertices of mesh '%s'", mesh.m_name);
+                if (settings.m_optimize_vertex_cache && MeshOptimizer::optimizeVertexCache(mesh).IsError())
+                    LogW("cannot optimize the vertex cache of mesh '%s'", mesh.m_name);
+                if (settings.m_optimize_overdraw && MeshOptimizer::optimizeOverdraw(mesh).IsError())
+                    LogW("cannot optimize the overdraw of mesh '%s'", mesh.m_name);
+                if (!settings.m_lod_ratios.empty() && MeshSimplifier::buildLods(mesh, settings.m_lod_ratios).IsError())
+                    LogW("cannot build the levels of detail of mesh '%s'", mesh.m_name);
+                if (settings.m_optimize_vertex_fetch && MeshOptimizer::optimizeVertexFetch(mesh).IsError())
+                    LogW("cannot optimize the vertex fetch of mesh '%s'", mesh.m_name);
+                if (settings.m_build_meshlets && mesh.getLod(mesh.getSubmesh(0), 0).m_indices_count / 3 >= MESHLET_MIN_MESH_TRIANGLES &&
+                    MeshletUtils::buildMeshlets(mesh).IsError())
+                    LogW("cannot split the mesh '%s' in meshlets", mesh.m_name);
+            }
+            /// @brief Appends `part` to `mesh` as a new submesh: its vertices, indices, levels of detail and
+            /// meshlets are copied at the end of the ones of `mesh`. The indices of `part` are kept as is, and
+            /// offset by the first vertex of the submesh when drawn.
+            /// @param mesh The mesh to append to - stored in m_vertices / m_indices
+            /// @param part The mesh to append - stored in m_vertices / m_indices, without submeshes
+            /// @param material The name of the material of the submesh
+            /// @return A VResult type
+            static ftstd::VResult appendSubmesh(Mesh& mesh, const Mesh& part, const std::string& material) noexcept
+            {
+                if (nullptr != mesh.m_source || nullptr != part.m_source)
+                    return ftstd::VResult::Error((char*)"cannot append a mapped mesh");
+                if (part.m_vertices.empty() || part.m_indices.empty())
+                    return ftstd::VResult::Error((char*)"cannot append an empty submesh");
+                if (mesh.m_vertices.size() + part.m_vertices.size() > INT32_MAX ||
+                    mesh.m_indices.size() + part.m_indices.size() > UINT32_MAX)
+                    return ftstd::VResult::Error((char*)"too many vertices or indices in the mesh");
+
+                u32 material_index = 0;
+                while (material_index < mesh.m_materials.size() &&
+                       0 != strncmp(mesh.m_materials[material_index].m_name, material.c_str(), MESH_MATERIAL_NAME_LENGTH - 1))
+                    ++material_index;
+                if (material_index == mesh.m_materials.size()) {
+                    MeshMaterial mesh_material{};
+                    snprintf(mesh_material.m_name, MESH_MATERIAL_NAME_LENGTH, "%s", material.c_str());
+                    mesh.m_materials.push_back(mesh_material);
+                }
+
+                Submesh submesh{
+                    .m_bounds_min = part.m_vertices[0].m_position,
+                    .m_material = material_index,
+                    .m_bounds_max = part.m_vertices[0].m_position,
+                    .m_vertex_offset = static_cast<i32>(mesh.m_vertices.size()),
+                    .m_vertices_count = static_cast<u32>(part.m_vertices.size()),
+                    .m_first_lod = static_cast<u32>(mesh.m_lods.size()),
+                    .m_lods_count = static_cast<u32>(std::max<size_t>(part.m_lods.size(), 1)),
+                    .m_first_meshlet = static_cast<u32>(mesh.m_meshlets.size()),
+                    .m_meshlets_count = static_cast<u32>(part.m_meshlets.size()),
+                };
+                for (const frametech::engine::graphics::shaders::Vertex& vertex : part.m_vertices) {
+                    submesh.m_bounds_min = glm::min(submesh.m_bounds_min, vertex.m_position);
+                    submesh.m_bounds_max = glm::max(submesh.m_bounds_max, vertex.m_position);
+                }
+                // The levels of detail and the meshlets are ranges of the indices of the part: move them
+                // after the indices already in the mesh
+                const u32 first_index = static_cast<u32>(mesh.m_indices.size());
+                if (part.m_lods.empty())
+                    mesh.m_lods.push_back(MeshLod{.m_first_index = first_index, .m_indices_count = static_cast<u32>(part.m_indices.size()), .m_error = 0.0f});
+                for (MeshLod lod : part.m_lods) {
+                    lod.m_first_index += first_index;
+                    mesh.m_lods.push_back(lod);
+                }
+                for (Meshlet meshlet : part.m_meshlets) {
+                    meshlet.m_first_index += first_index;
+                    mesh.m_meshlets.push_back(meshlet);
+                }
+                mesh.m_vertices.insert(mesh.m_vertices.end(), part.m_vertices.begin(), part.m_vertices.end());
+                mesh.m_indices.insert(mesh.m_indices.end(), part.m_indices.begin(), part.m_indices.end());
+                mesh.m_submeshes.push_back(submesh);
+                return ftstd::VResult::Ok();
+            }
             /// @brief Returns a 2D Mesh object, based on the id passed as parameter
             /// @param queried_mesh The 2D Mesh ID to get
             /// @return A Mesh object
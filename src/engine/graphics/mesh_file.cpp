@@ -0,0 +1,260 @@
+//
+//  mesh_file.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#include "mesh_file.hpp"
+#include "../../ftstd/debug_tools.h"
+#include "../../ftstd/mapped_file.hpp"
+#include "mesh.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <stdio.h>
+#include <thread>
+
+using frametech::engine::graphics::shaders::Vertex;
+
+/// @brief Returns `offset`, rounded up to the next multiple of `alignment`
+static u64 alignUp(const u64 offset, const u64 alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+/// @brief Returns if the `size` bytes at `offset` are within a file of `file_size` bytes - without
+/// overflowing on corrupted offsets
+static bool isInFile(const u64 offset, const u64 size, const u64 file_size)
+{
+    return offset <= file_size && size <= file_size - offset;
+}
+
+/// @brief Returns if the `count` indices from `first_index` are all lower than `vertices_count`
+static bool areIndicesInRange(const u32* indices, const u64 first_index, const u64 count, const u64 vertices_count)
+{
+    u32 max_index = 0;
+    for (u64 i = first_index; i < first_index + count; ++i)
+        max_index = std::max(max_index, indices[i]);
+    return 0 == count || max_index < vertices_count;
+}
+
+std::string frametech::graphics::MeshFile::getCachePath(const char* source_path) noexcept
+{
+    return std::filesystem::path(source_path).replace_extension(MESH_FILE_EXTENSION).string();
+}
+
+bool frametech::graphics::MeshFile::isUpToDate(const char* path, const char* source_path) noexcept
+{
+    std::error_code error;
+    const auto last_write_time = std::filesystem::last_write_time(path, error);
+    if (error)
+        return false;
+    const auto source_last_write_time = std::filesystem::last_write_time(source_path, error);
+    if (error)
+        return true;
+    return last_write_time >= source_last_write_time;
+}
+
+ftstd::VResult frametech::graphics::MeshFile::read(const char* path, frametech::graphics::Mesh& mesh, const u64 settings_hash) noexcept
+{
+    auto mesh_file = std::make_shared<ftstd::MappedFile>();
+    // Everything is going to be copied in the staging buffers right after
+    if (mesh_file->open(path, ftstd::MappedFile::Access::WILL_NEED).IsError())
+        return ftstd::VResult::Error((char*)"cannot map the binary mesh file");
+
+    const u64 file_size = mesh_file->size();
+    if (file_size < sizeof(MeshFileHeader))
+        return ftstd::VResult::Error((char*)"truncated binary mesh file");
+    MeshFileHeader header{};
+    memcpy(&header, mesh_file->data(), sizeof(MeshFileHeader));
+
+    if (0 != memcmp(header.m_magic, MESH_FILE_MAGIC, sizeof(MESH_FILE_MAGIC)))
+        return ftstd::VResult::Error((char*)"not a binary mesh file");
+    if (MESH_FILE_VERSION != header.m_version)
+    {
+        LogW("binary mesh file '%s' has version %u, expected version %u", path, header.m_version, MESH_FILE_VERSION);
+        return ftstd::VResult::Error((char*)"unsupported binary mesh file version");
+    }
+    if (sizeof(Vertex) != header.m_vertex_stride || sizeof(u32) != header.m_index_stride ||
+        sizeof(Meshlet) != header.m_meshlet_stride || sizeof(MeshLod) != header.m_lod_stride ||
+        sizeof(Submesh) != header.m_submesh_stride || sizeof(MeshMaterial) != header.m_material_stride)
+        return ftstd::VResult::Error((char*)"binary mesh file layout does not match the engine one");
+    if (0 != header.m_vertices_offset % MESH_FILE_ALIGNMENT ||
+        0 != header.m_indices_offset % MESH_FILE_ALIGNMENT ||
+        0 != header.m_meshlets_offset % MESH_FILE_ALIGNMENT ||
+        0 != header.m_lods_offset % MESH_FILE_ALIGNMENT ||
+        0 != header.m_submeshes_offset % MESH_FILE_ALIGNMENT ||
+        0 != header.m_materials_offset % MESH_FILE_ALIGNMENT ||
+        header.m_vertices_count > file_size / sizeof(Vertex) ||
+        header.m_indices_count > file_size / sizeof(u32) ||
+        header.m_meshlets_count > file_size / sizeof(Meshlet) ||
+        header.m_lods_count > file_size / sizeof(MeshLod) ||
+        header.m_submeshes_count > file_size / sizeof(Submesh) ||
+        header.m_materials_count > file_size / sizeof(MeshMaterial) ||
+        !isInFile(header.m_vertices_offset, header.m_vertices_count * sizeof(Vertex), file_size) ||
+        !isInFile(header.m_indices_offset, header.m_indices_count * sizeof(u32), file_size) ||
+        !isInFile(header.m_meshlets_offset, header.m_meshlets_count * sizeof(Meshlet), file_size) ||
+        !isInFile(header.m_lods_offset, header.m_lods_count * sizeof(MeshLod), file_size) ||
+        !isInFile(header.m_submeshes_offset, header.m_submeshes_count * sizeof(Submesh), file_size) ||
+        !isInFile(header.m_materials_offset, header.m_materials_count * sizeof(MeshMaterial), file_size))
+        return ftstd::VResult::Error((char*)"corrupted binary mesh file");
+    if (settings_hash != header.m_settings_hash)
+        return ftstd::VResult::Error((char*)"binary mesh file processed with other import settings");
+    // The meshlets and the levels of detail are ranges of indices drawn as is: they must stay within the indices
+    const Meshlet* meshlets = reinterpret_cast<const Meshlet*>(mesh_file->data() + header.m_meshlets_offset);
+    for (u32 i = 0; i < header.m_meshlets_count; ++i)
+    {
+        if (meshlets[i].m_first_index > header.m_indices_count ||
+            static_cast<u64>(meshlets[i].m_triangles_count) * 3 > header.m_indices_count - meshlets[i].m_first_index)
+            return ftstd::VResult::Error((char*)"corrupted binary mesh file meshlet");
+    }
+    const MeshLod* lods = reinterpret_cast<const MeshLod*>(mesh_file->data() + header.m_lods_offset);
+    for (u32 i = 0; i < header.m_lods_count; ++i)
+    {
+        if (lods[i].m_first_index > header.m_indices_count ||
+            lods[i].m_indices_count > header.m_indices_count - lods[i].m_first_index)
+            return ftstd::VResult::Error((char*)"corrupted binary mesh file level of detail");
+    }
+    // The submeshes index the other arrays
+    const Submesh* submeshes = reinterpret_cast<const Submesh*>(mesh_file->data() + header.m_submeshes_offset);
+    for (u32 i = 0; i < header.m_submeshes_count; ++i)
+    {
+        if (submeshes[i].m_vertex_offset < 0 ||
+            static_cast<u64>(submeshes[i].m_vertex_offset) + submeshes[i].m_vertices_count > header.m_vertices_count ||
+            0 == submeshes[i].m_lods_count ||
+            static_cast<u64>(submeshes[i].m_first_lod) + submeshes[i].m_lods_count > header.m_lods_count ||
+            static_cast<u64>(submeshes[i].m_first_meshlet) + submeshes[i].m_meshlets_count > header.m_meshlets_count ||
+            submeshes[i].m_material >= header.m_materials_count)
+            return ftstd::VResult::Error((char*)"corrupted binary mesh file submesh");
+    }
+    // The indices of a submesh are relative to its first vertex: they must stay within its vertices
+    const u32* indices = reinterpret_cast<const u32*>(mesh_file->data() + header.m_indices_offset);
+    if (0 == header.m_submeshes_count && !areIndicesInRange(indices, 0, header.m_indices_count, header.m_vertices_count))
+        return ftstd::VResult::Error((char*)"corrupted binary mesh file indices");
+    for (u32 i = 0; i < header.m_submeshes_count; ++i)
+    {
+        const Submesh& submesh = submeshes[i];
+        for (u32 lod = submesh.m_first_lod; lod < submesh.m_first_lod + submesh.m_lods_count; ++lod)
+        {
+            if (!areIndicesInRange(indices, lods[lod].m_first_index, lods[lod].m_indices_count, submesh.m_vertices_count))
+                return ftstd::VResult::Error((char*)"corrupted binary mesh file submesh indices");
+        }
+        for (u32 meshlet = submesh.m_first_meshlet; meshlet < submesh.m_first_meshlet + submesh.m_meshlets_count; ++meshlet)
+        {
+            if (!areIndicesInRange(indices, meshlets[meshlet].m_first_index, static_cast<u64>(meshlets[meshlet].m_triangles_count) * 3, submesh.m_vertices_count))
+                return ftstd::VResult::Error((char*)"corrupted binary mesh file submesh indices");
+        }
+    }
+    const MeshMaterial* materials = reinterpret_cast<const MeshMaterial*>(mesh_file->data() + header.m_materials_offset);
+    for (u32 i = 0; i < header.m_materials_count; ++i)
+    {
+        if (nullptr == memchr(materials[i].m_name, '\0', MESH_MATERIAL_NAME_LENGTH))
+            return ftstd::VResult::Error((char*)"corrupted binary mesh file material");
+    }
+
+    mesh.m_vertices.clear();
+    mesh.m_indices.clear();
+    mesh.m_meshlets.clear();
+    mesh.m_lods.clear();
+    mesh.m_submeshes.clear();
+    mesh.m_materials.clear();
+    mesh.m_source_vertices = reinterpret_cast<const Vertex*>(mesh_file->data() + header.m_vertices_offset);
+    mesh.m_source_vertices_count = header.m_vertices_count;
+    mesh.m_source_indices = indices;
+    mesh.m_source_indices_count = header.m_indices_count;
+    mesh.m_source_meshlets = meshlets;
+    mesh.m_source_meshlets_count = header.m_meshlets_count;
+    mesh.m_source_lods = lods;
+    mesh.m_source_lods_count = header.m_lods_count;
+    mesh.m_source_submeshes = submeshes;
+    mesh.m_source_submeshes_count = header.m_submeshes_count;
+    mesh.m_source_materials = materials;
+    mesh.m_source_materials_count = header.m_materials_count;
+    mesh.m_source = mesh_file;
+    return ftstd::VResult::Ok();
+}
+
+ftstd::VResult frametech::graphics::MeshFile::write(const char* path, const frametech::graphics::Mesh& mesh, const u64 settings_hash) noexcept
+{
+    if (mesh.getMeshletsCount() > UINT32_MAX || mesh.getMaterialsCount() > UINT32_MAX)
+        return ftstd::VResult::Error((char*)"too many meshlets or materials to write");
+    const u64 lods_count = nullptr != mesh.m_source ? mesh.m_source_lods_count : mesh.m_lods.size();
+    const MeshLod* lods = nullptr != mesh.m_source ? mesh.m_source_lods : mesh.m_lods.data();
+    const u64 submeshes_count = nullptr != mesh.m_source ? mesh.m_source_submeshes_count : mesh.m_submeshes.size();
+    const Submesh* submeshes = nullptr != mesh.m_source ? mesh.m_source_submeshes : mesh.m_submeshes.data();
+    const MeshMaterial* materials = nullptr != mesh.m_source ? mesh.m_source_materials : mesh.m_materials.data();
+    MeshFileHeader header{
+        .m_version = MESH_FILE_VERSION,
+        .m_vertex_stride = static_cast<u32>(sizeof(Vertex)),
+        .m_index_stride = static_cast<u32>(sizeof(u32)),
+        .m_vertices_count = mesh.getVerticesCount(),
+        .m_indices_count = mesh.getIndicesCount(),
+        .m_meshlet_stride = static_cast<u32>(sizeof(Meshlet)),
+        .m_meshlets_count = static_cast<u32>(mesh.getMeshletsCount()),
+        .m_lod_stride = static_cast<u32>(sizeof(MeshLod)),
+        .m_lods_count = static_cast<u32>(lods_count),
+        .m_submesh_stride = static_cast<u32>(sizeof(Submesh)),
+        .m_submeshes_count = static_cast<u32>(submeshes_count),
+        .m_material_stride = static_cast<u32>(sizeof(MeshMaterial)),
+        .m_materials_count = static_cast<u32>(mesh.getMaterialsCount()),
+        .m_settings_hash = settings_hash,
+    };
+    memcpy(header.m_magic, MESH_FILE_MAGIC, sizeof(MESH_FILE_MAGIC));
+    header.m_vertices_offset = alignUp(sizeof(MeshFileHeader), MESH_FILE_ALIGNMENT);
+    header.m_indices_offset = alignUp(header.m_vertices_offset + header.m_vertices_count * sizeof(Vertex), MESH_FILE_ALIGNMENT);
+    header.m_meshlets_offset = alignUp(header.m_indices_offset + header.m_indices_count * sizeof(u32), MESH_FILE_ALIGNMENT);
+    header.m_lods_offset = alignUp(header.m_meshlets_offset + header.m_meshlets_count * sizeof(Meshlet), MESH_FILE_ALIGNMENT);
+    header.m_submeshes_offset = alignUp(header.m_lods_offset + header.m_lods_count * sizeof(MeshLod), MESH_FILE_ALIGNMENT);
+    header.m_materials_offset = alignUp(header.m_submeshes_offset + header.m_submeshes_count * sizeof(Submesh), MESH_FILE_ALIGNMENT);
+
+    // One temporary file per thread: two threads can write the same file
+    const std::string temporary_path = std::string(path) + "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+    FILE* pFile = fopen(temporary_path.c_str(), "wb");
+    if (NULL == pFile)
+        return ftstd::VResult::Error((char*)"cannot open the binary mesh file to write");
+
+    static const char padding[MESH_FILE_ALIGNMENT] = {};
+    const u64 vertices_padding = header.m_vertices_offset - sizeof(MeshFileHeader);
+    const u64 indices_padding = header.m_indices_offset - header.m_vertices_offset - header.m_vertices_count * sizeof(Vertex);
+    const u64 meshlets_padding = header.m_meshlets_offset - header.m_indices_offset - header.m_indices_count * sizeof(u32);
+    const u64 lods_padding = header.m_lods_offset - header.m_meshlets_offset - header.m_meshlets_count * sizeof(Meshlet);
+    const u64 submeshes_padding = header.m_submeshes_offset - header.m_lods_offset - header.m_lods_count * sizeof(MeshLod);
+    const u64 materials_padding = header.m_materials_offset - header.m_submeshes_offset - header.m_submeshes_count * sizeof(Submesh);
+    const bool written =
+        1 == fwrite(&header, sizeof(MeshFileHeader), 1, pFile) &&
+        vertices_padding == fwrite(padding, 1, vertices_padding, pFile) &&
+        header.m_vertices_count == fwrite(mesh.getVertexData(), sizeof(Vertex), header.m_vertices_count, pFile) &&
+        indices_padding == fwrite(padding, 1, indices_padding, pFile) &&
+        header.m_indices_count == fwrite(mesh.getIndexData(), sizeof(u32), header.m_indices_count, pFile) &&
+        meshlets_padding == fwrite(padding, 1, meshlets_padding, pFile) &&
+        header.m_meshlets_count == fwrite(mesh.getMeshletData(), sizeof(Meshlet), header.m_meshlets_count, pFile) &&
+        lods_padding == fwrite(padding, 1, lods_padding, pFile) &&
+        header.m_lods_count == fwrite(lods, sizeof(MeshLod), header.m_lods_count, pFile) &&
+        submeshes_padding == fwrite(padding, 1, submeshes_padding, pFile) &&
+        header.m_submeshes_count == fwrite(submeshes, sizeof(Submesh), header.m_submeshes_count, pFile) &&
+        materials_padding == fwrite(padding, 1, materials_padding, pFile) &&
+        header.m_materials_count == fwrite(materials, sizeof(MeshMaterial), header.m_materials_count, pFile);
+    if (0 != fclose(pFile) || !written)
+    {
+        remove(temporary_path.c_str());
+        return ftstd::VResult::Error((char*)"cannot write the binary mesh file");
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary_path, path, error);
+    if (error)
+    {
+        remove(temporary_path.c_str());
+        return ftstd::VResult::Error((char*)"cannot move the binary mesh file");
+    }
+    Log("> Binary mesh file '%s' written (%llu vertices, %llu indices, %u meshlets, %u levels of detail, %u submeshes)",
+        path,
+        header.m_vertices_count,
+        header.m_indices_count,
+        header.m_meshlets_count,
+        header.m_lods_count,
+        header.m_submeshes_count);
+    return ftstd::VResult::Ok();
+}
@@ -0,0 +1,105 @@
+//
+//  mesh_file.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _mesh_file_hpp
+#define _mesh_file_hpp
+
+#include "../../ftstd/result.hpp"
+#include "../platform.hpp"
+#include <string>
+
+namespace frametech
+{
+    namespace graphics
+    {
+        struct Mesh;
+
+        /// @brief Header of a binary mesh file (.ftmesh).
+        /// The vertices and the indices follow, in the layout of the GPU buffers, then the
+        /// meshlets, the levels of detail, the submeshes and the materials - each array starting on a MESH_FILE_ALIGNMENT boundary.
+        struct MeshFileHeader
+        {
+            /// @brief Always MESH_FILE_MAGIC
+            char m_magic[4];
+            /// @brief Version of the format - files with another version are rejected
+            u32 m_version;
+            /// @brief Size of one vertex, in bytes
+            u32 m_vertex_stride;
+            /// @brief Size of one index, in bytes
+            u32 m_index_stride;
+            /// @brief Number of vertices
+            u64 m_vertices_count;
+            /// @brief Number of indices
+            u64 m_indices_count;
+            /// @brief Offset of the first vertex, from the beginning of the file
+            u64 m_vertices_offset;
+            /// @brief Offset of the first index, from the beginning of the file
+            u64 m_indices_offset;
+            /// @brief Size of one meshlet, in bytes
+            u32 m_meshlet_stride;
+            /// @brief Number of meshlets - 0 if the mesh has not been split
+            u32 m_meshlets_count;
+            /// @brief Offset of the first meshlet, from the beginning of the file
+            u64 m_meshlets_offset;
+            /// @brief Size of one level of detail, in bytes
+            u32 m_lod_stride;
+            /// @brief Number of levels of detail - 0 if they have not been built
+            u32 m_lods_count;
+            /// @brief Offset of the first level of detail, from the beginning of the file
+            u64 m_lods_offset;
+            /// @brief Size of one submesh, in bytes
+            u32 m_submesh_stride;
+            /// @brief Number of submeshes - 0 if the whole mesh is a single submesh
+            u32 m_submeshes_count;
+            /// @brief Offset of the first submesh, from the beginning of the file
+            u64 m_submeshes_offset;
+            /// @brief Size of one material, in bytes
+            u32 m_material_stride;
+            /// @brief Number of materials
+            u32 m_materials_count;
+            /// @brief Offset of the first material, from the beginning of the file
+            u64 m_materials_offset;
+            /// @brief Hash of the import settings the mesh was processed with (see MeshUtils::getSettingsHash)
+            u64 m_settings_hash;
+        };
+
+        /// @brief Reads and writes binary mesh files, used as a cache of parsed mesh files
+        class MeshFile
+        {
+        public:
+            /// @brief Magic number of the binary mesh files
+            static constexpr char MESH_FILE_MAGIC[4] = {'F', 'T', 'M', 'S'};
+            /// @brief Current version of the format - also bumped when the import passes change,
+            /// so that the files written by an older engine are imported again
+            static constexpr u32 MESH_FILE_VERSION = 7;
+            /// @brief Alignment of the arrays in the file
+            static constexpr u64 MESH_FILE_ALIGNMENT = 16;
+            /// @brief Extension of the binary mesh files
+            static constexpr const char* MESH_FILE_EXTENSION = ".ftmesh";
+
+            /// @brief Returns the path of the binary mesh file that caches `source_path`
+            /// (same path, with the binary mesh file extension)
+            static std::string getCachePath(const char* source_path) noexcept;
+            /// @brief Returns if the binary mesh file at `path` exists, and is not older than
+            /// `source_path`. If `source_path` does not exist, the binary mesh file is used as is.
+            static bool isUpToDate(const char* path, const char* source_path) noexcept;
+            /// @brief Maps the binary mesh file at `path` in `mesh`: the vertices, the indices, the meshlets,
+            /// the levels of detail, the submeshes and the materials are not copied, `mesh` keeps the mapping alive.
+            /// @param settings_hash The hash of the import settings expected - a file processed with other settings is rejected
+            /// @return A VResult type - an error if the file is missing, invalid, or processed with other settings
+            static ftstd::VResult read(const char* path, frametech::graphics::Mesh& mesh, const u64 settings_hash) noexcept;
+            /// @brief Writes the vertices, the indices, the meshlets, the levels of detail, the submeshes and the materials of `mesh` in the binary mesh file at `path`.
+            /// The file is written aside, then moved: a reader never sees a partial file.
+            /// @param settings_hash The hash of the import settings `mesh` was processed with
+            /// @return A VResult type
+            static ftstd::VResult write(const char* path, const frametech::graphics::Mesh& mesh, const u64 settings_hash) noexcept;
+        };
+    } // namespace graphics
+} // namespace frametech
+
+#endif // _mesh_file_hpp
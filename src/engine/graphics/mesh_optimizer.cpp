@@ -0,0 +1,538 @@
+//
+//  mesh_optimizer.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#include "mesh_optimizer.hpp"
+#include "../../ftstd/debug_tools.h"
+#include "mesh.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+using frametech::engine::graphics::shaders::Vertex;
+
+namespace
+{
+    /// @brief Marks the end of a list of vertices, or a vertex not found
+    constexpr u32 NO_VERTEX = UINT32_MAX;
+
+    /// @brief Packs the coordinates of a grid cell in a 64 bits key (21 bits per axis).
+    /// Far cells can share a key: candidates are always compared afterwards.
+    inline u64 getCellKey(const i64 x, const i64 y, const i64 z) noexcept
+    {
+        constexpr u64 mask = (1ull << 21) - 1;
+        return ((static_cast<u64>(x) & mask) << 42) | ((static_cast<u64>(y) & mask) << 21) | (static_cast<u64>(z) & mask);
+    }
+
+    /// @brief Returns the cell of the grid with cells of `cell_size` that contains `value`
+    inline i64 getCell(const f32 value, const f64 cell_size) noexcept
+    {
+        constexpr f64 max_cell = static_cast<f64>(1ll << 40);
+        const f64 cell = std::floor(static_cast<f64>(value) / cell_size);
+        return static_cast<i64>(cell < -max_cell ? -max_cell : (cell > max_cell ? max_cell : cell));
+    }
+
+    /// @brief Key of the exact position of a vertex (+0 and -0 are the same position)
+    inline u64 getExactKey(const glm::vec3& position) noexcept
+    {
+        u32 bits[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const f32 component = 0.0f == position[axis] ? 0.0f : position[axis];
+            memcpy(&bits[axis], &component, sizeof(u32));
+        }
+        u64 key = bits[0] * 0x9E3779B97F4A7C15ull;
+        key ^= bits[1] * 0xC2B2AE3D27D4EB4Full + (key >> 29);
+        key ^= bits[2] * 0x165667B19E3779F9ull + (key >> 32);
+        return key;
+    }
+
+    /// @brief Returns if all the attributes of `a` and `b` are within `epsilon`
+    inline bool areNear(const Vertex& a, const Vertex& b, const f32 epsilon) noexcept
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (std::fabs(a.m_position[axis] - b.m_position[axis]) > epsilon ||
+                std::fabs(a.m_color[axis] - b.m_color[axis]) > epsilon)
+                return false;
+        }
+        return std::fabs(a.m_texture_coordinates.x - b.m_texture_coordinates.x) <= epsilon &&
+               std::fabs(a.m_texture_coordinates.y - b.m_texture_coordinates.y) <= epsilon;
+    }
+
+    /// @brief Size of the LRU cache modelled by the Forsyth algorithm
+    constexpr u32 FORSYTH_CACHE_SIZE = 32;
+    /// @brief Highest valence with a precomputed score
+    constexpr u32 FORSYTH_MAX_VALENCE = 32;
+
+    /// @brief Precomputed vertex scores of the Forsyth algorithm
+    struct ForsythScores
+    {
+        /// @brief Score per position in the cache
+        f32 m_cache[FORSYTH_CACHE_SIZE];
+        /// @brief Score per number of remaining triangles
+        f32 m_valence[FORSYTH_MAX_VALENCE + 1];
+
+        ForsythScores() noexcept
+        {
+            constexpr f32 last_triangle_score = 0.75f;
+            constexpr f32 cache_decay_power = 1.5f;
+            constexpr f32 valence_boost_scale = 2.0f;
+            constexpr f32 valence_boost_power = 0.5f;
+            for (u32 position = 0; position < FORSYTH_CACHE_SIZE; ++position)
+            {
+                // The vertices of the last triangle get a fixed score, so that the next
+                // triangle does not favour a particular vertex of it
+                if (position < 3)
+                {
+                    m_cache[position] = last_triangle_score;
+                    continue;
+                }
+                const f32 scaler = 1.0f / static_cast<f32>(FORSYTH_CACHE_SIZE - 3);
+                m_cache[position] = std::pow(1.0f - static_cast<f32>(position - 3) * scaler, cache_decay_power);
+            }
+            m_valence[0] = 0.0f;
+            for (u32 valence = 1; valence <= FORSYTH_MAX_VALENCE; ++valence)
+                m_valence[valence] = valence_boost_scale * std::pow(static_cast<f32>(valence), -valence_boost_power);
+        }
+
+        /// @brief Score of a vertex - a vertex without remaining triangle gets a negative score
+        f32 get(const i32 cache_position, const u32 remaining_valence) const noexcept
+        {
+            if (0 == remaining_valence)
+                return -1.0f;
+            const f32 cache_score = cache_position >= 0 ? m_cache[cache_position] : 0.0f;
+            return cache_score + m_valence[remaining_valence < FORSYTH_MAX_VALENCE ? remaining_valence : FORSYTH_MAX_VALENCE];
+        }
+    };
+
+    /// @brief Returns if all the indices are in [0, vertices_count)
+    inline bool areIndicesValid(const std::vector<u32>& indices, const size_t vertices_count) noexcept
+    {
+        for (const u32 index : indices)
+        {
+            if (index >= vertices_count)
+                return false;
+        }
+        return 0 == indices.size() % 3;
+    }
+} // namespace
+
+ftstd::VResult frametech::graphics::MeshOptimizer::weldVertices(frametech::graphics::Mesh& mesh, const f32 epsilon) noexcept
+{
+    if (nullptr != mesh.m_source)
+        return ftstd::VResult::Error((char*)"cannot weld the vertices of a mapped mesh");
+    if (epsilon < 0.0f)
+        return ftstd::VResult::Error((char*)"cannot weld vertices with a negative epsilon");
+
+    const size_t nb_vertices = mesh.m_vertices.size();
+    if (0 == nb_vertices)
+        return ftstd::VResult::Ok();
+    for (const u32 index : mesh.m_indices)
+    {
+        if (index >= nb_vertices)
+            return ftstd::VResult::Error((char*)"cannot weld a mesh with out of range indices");
+    }
+
+    // The welded vertices are chained per grid cell: cells maps a cell to the last
+    // welded vertex inside it, and next_in_cell goes to the previous one.
+    // With a cell size of epsilon, a match can only be in the cell or its 26 neighbours.
+    std::vector<Vertex> welded_vertices;
+    welded_vertices.reserve(nb_vertices);
+    std::vector<u32> next_in_cell;
+    next_in_cell.reserve(nb_vertices);
+    std::unordered_map<u64, u32> cells;
+    cells.reserve(nb_vertices);
+    std::vector<u32> remap(nb_vertices);
+
+    const f64 cell_size = static_cast<f64>(epsilon);
+    for (size_t vertex_index = 0; vertex_index < nb_vertices; ++vertex_index)
+    {
+        const Vertex& vertex = mesh.m_vertices[vertex_index];
+        u32 welded_index = NO_VERTEX;
+        u64 cell_key = 0;
+        if (epsilon > 0.0f)
+        {
+            const i64 x = getCell(vertex.m_position.x, cell_size);
+            const i64 y = getCell(vertex.m_position.y, cell_size);
+            const i64 z = getCell(vertex.m_position.z, cell_size);
+            cell_key = getCellKey(x, y, z);
+            for (i64 dx = -1; dx <= 1 && NO_VERTEX == welded_index; ++dx)
+                for (i64 dy = -1; dy <= 1 && NO_VERTEX == welded_index; ++dy)
+                    for (i64 dz = -1; dz <= 1 && NO_VERTEX == welded_index; ++dz)
+                    {
+                        const auto cell = cells.find(getCellKey(x + dx, y + dy, z + dz));
+                        if (cells.end() == cell)
+                            continue;
+                        for (u32 candidate = cell->second; NO_VERTEX != candidate; candidate = next_in_cell[candidate])
+                        {
+                            if (areNear(vertex, welded_vertices[candidate], epsilon))
+                            {
+                                welded_index = candidate;
+                                break;
+                            }
+                        }
+                    }
+        }
+        else
+        {
+            cell_key = getExactKey(vertex.m_position);
+            if (const auto cell = cells.find(cell_key); cells.end() != cell)
+            {
+                for (u32 candidate = cell->second; NO_VERTEX != candidate; candidate = next_in_cell[candidate])
+                {
+                    if (areNear(vertex, welded_vertices[candidate], 0.0f))
+                    {
+                        welded_index = candidate;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (NO_VERTEX == welded_index)
+        {
+            welded_index = static_cast<u32>(welded_vertices.size());
+            welded_vertices.push_back(vertex);
+            const auto [cell, inserted] = cells.try_emplace(cell_key, welded_index);
+            next_in_cell.push_back(inserted ? NO_VERTEX : cell->second);
+            cell->second = welded_index;
+        }
+        remap[vertex_index] = welded_index;
+    }
+
+    // Rebuild the indices, and drop the triangles that collapsed
+    const size_t nb_indices = mesh.m_indices.size() - mesh.m_indices.size() % 3;
+    size_t nb_welded_indices = 0;
+    for (size_t index = 0; index < nb_indices; index += 3)
+    {
+        const u32 a = remap[mesh.m_indices[index]];
+        const u32 b = remap[mesh.m_indices[index + 1]];
+        const u32 c = remap[mesh.m_indices[index + 2]];
+        if (a == b || b == c || a == c)
+            continue;
+        mesh.m_indices[nb_welded_indices++] = a;
+        mesh.m_indices[nb_welded_indices++] = b;
+        mesh.m_indices[nb_welded_indices++] = c;
+    }
+    const size_t nb_collapsed_triangles = (nb_indices - nb_welded_indices) / 3;
+    mesh.m_indices.resize(nb_welded_indices);
+
+    Log("> Mesh '%s' welded with epsilon %g: %zu -> %zu vertices (%zu collapsed triangles removed)",
+        mesh.m_name,
+        static_cast<f64>(epsilon),
+        nb_vertices,
+        welded_vertices.size(),
+        nb_collapsed_triangles);
+    mesh.m_vertices.swap(welded_vertices);
+    return ftstd::VResult::Ok();
+}
+
+frametech::graphics::VertexCacheStatistics frametech::graphics::MeshOptimizer::analyzeVertexCache(
+    const u32* indices,
+    const u64 indices_count,
+    const u64 vertices_count,
+    const u32 cache_size) noexcept
+{
+    VertexCacheStatistics statistics{};
+    if (0 == indices_count || 0 == vertices_count || 0 == cache_size)
+        return statistics;
+
+    // A vertex is in the FIFO cache if it entered it less than cache_size misses ago
+    std::vector<u64> entered_at(static_cast<size_t>(vertices_count), 0);
+    u64 nb_misses = 0;
+    for (u64 i = 0; i < indices_count; ++i)
+    {
+        const u32 index = indices[i];
+        if (index >= vertices_count)
+            continue;
+        if (0 == entered_at[index] || nb_misses - entered_at[index] >= cache_size)
+        {
+            ++nb_misses;
+            entered_at[index] = nb_misses;
+        }
+    }
+    statistics.m_transformed_vertices = nb_misses;
+    statistics.m_acmr = static_cast<f32>(static_cast<f64>(nb_misses) / static_cast<f64>(indices_count / 3));
+    statistics.m_atvr = static_cast<f32>(static_cast<f64>(nb_misses) / static_cast<f64>(vertices_count));
+    return statistics;
+}
+
+ftstd::VResult frametech::graphics::MeshOptimizer::optimizeVertexCache(frametech::graphics::Mesh& mesh) noexcept
+{
+    if (nullptr != mesh.m_source)
+        return ftstd::VResult::Error((char*)"cannot optimize the indices of a mapped mesh");
+    const size_t nb_vertices = mesh.m_vertices.size();
+    if (!areIndicesValid(mesh.m_indices, nb_vertices))
+        return ftstd::VResult::Error((char*)"cannot optimize a mesh with invalid indices");
+    if (mesh.m_indices.size() / 3 < 2)
+        return ftstd::VResult::Ok();
+
+    const VertexCacheStatistics before = analyzeVertexCache(mesh.m_indices.data(), mesh.m_indices.size(), nb_vertices);
+    optimizeVertexCache(mesh.m_indices, nb_vertices);
+    const VertexCacheStatistics after = analyzeVertexCache(mesh.m_indices.data(), mesh.m_indices.size(), nb_vertices);
+    Log("> Mesh '%s' vertex cache optimization: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f",
+        mesh.m_name,
+        static_cast<f64>(before.m_acmr),
+        static_cast<f64>(after.m_acmr),
+        static_cast<f64>(before.m_atvr),
+        static_cast<f64>(after.m_atvr));
+    return ftstd::VResult::Ok();
+}
+
+void frametech::graphics::MeshOptimizer::optimizeVertexCache(std::vector<u32>& indices, const u64 vertices_count) noexcept
+{
+    const size_t nb_vertices = vertices_count;
+    const size_t nb_triangles = indices.size() / 3;
+    if (nb_triangles < 2)
+        return;
+
+    static const ForsythScores scores{};
+
+    // Triangles of each vertex, packed: the first `remaining_valence[v]` triangles
+    // from `first_triangle[v]` are the ones of v that have not been emitted yet
+    std::vector<u32> first_triangle(nb_vertices + 1, 0);
+    for (const u32 index : indices)
+        ++first_triangle[index + 1];
+    for (size_t vertex = 0; vertex < nb_vertices; ++vertex)
+        first_triangle[vertex + 1] += first_triangle[vertex];
+    std::vector<u32> remaining_valence(nb_vertices, 0);
+    std::vector<u32> vertex_triangles(indices.size());
+    for (size_t triangle = 0; triangle < nb_triangles; ++triangle)
+    {
+        for (size_t corner = 0; corner < 3; ++corner)
+        {
+            const u32 vertex = indices[triangle * 3 + corner];
+            vertex_triangles[first_triangle[vertex] + remaining_valence[vertex]++] = static_cast<u32>(triangle);
+        }
+    }
+
+    std::vector<i32> cache_position(nb_vertices, -1);
+    std::vector<f32> vertex_score(nb_vertices);
+    for (size_t vertex = 0; vertex < nb_vertices; ++vertex)
+        vertex_score[vertex] = scores.get(-1, remaining_valence[vertex]);
+    std::vector<f32> triangle_score(nb_triangles);
+    std::vector<bool> emitted(nb_triangles, false);
+    u32 best_triangle = 0;
+    for (size_t triangle = 0; triangle < nb_triangles; ++triangle)
+    {
+        triangle_score[triangle] = vertex_score[indices[triangle * 3]] +
+                                   vertex_score[indices[triangle * 3 + 1]] +
+                                   vertex_score[indices[triangle * 3 + 2]];
+        if (triangle_score[triangle] > triangle_score[best_triangle])
+            best_triangle = static_cast<u32>(triangle);
+    }
+
+    std::vector<u32> optimized_indices;
+    optimized_indices.reserve(indices.size());
+    // The cache holds up to 3 more vertices while it is being updated
+    u32 cache[FORSYTH_CACHE_SIZE + 3];
+    u32 cache_size = 0;
+    u32 next_unemitted_triangle = 0;
+
+    for (size_t nb_emitted = 0; nb_emitted < nb_triangles; ++nb_emitted)
+    {
+        if (NO_VERTEX == best_triangle)
+        {
+            // No candidate around the cache: restart from any triangle left
+            while (emitted[next_unemitted_triangle])
+                ++next_unemitted_triangle;
+            best_triangle = next_unemitted_triangle;
+        }
+        const u32* const triangle_vertices = &indices[best_triangle * 3];
+        emitted[best_triangle] = true;
+
+        u32 new_cache[FORSYTH_CACHE_SIZE + 3];
+        u32 new_cache_size = 0;
+        for (u32 corner = 0; corner < 3; ++corner)
+        {
+            const u32 vertex = triangle_vertices[corner];
+            optimized_indices.push_back(vertex);
+            new_cache[new_cache_size++] = vertex;
+            // Remove the triangle from the remaining triangles of the vertex
+            u32* const triangles = &vertex_triangles[first_triangle[vertex]];
+            for (u32 i = 0; i < remaining_valence[vertex]; ++i)
+            {
+                if (triangles[i] == best_triangle)
+                {
+                    triangles[i] = triangles[--remaining_valence[vertex]];
+                    break;
+                }
+            }
+        }
+        for (u32 i = 0; i < cache_size; ++i)
+        {
+            const u32 vertex = cache[i];
+            if (vertex != triangle_vertices[0] && vertex != triangle_vertices[1] && vertex != triangle_vertices[2])
+                new_cache[new_cache_size++] = vertex;
+        }
+
+        // Update the scores of the vertices in the cache, and of the ones pushed out of it
+        best_triangle = NO_VERTEX;
+        f32 best_score = -1.0f;
+        for (u32 i = 0; i < new_cache_size; ++i)
+        {
+            const u32 vertex = new_cache[i];
+            cache_position[vertex] = i < FORSYTH_CACHE_SIZE ? static_cast<i32>(i) : -1;
+            const f32 new_score = scores.get(cache_position[vertex], remaining_valence[vertex]);
+            const f32 score_delta = new_score - vertex_score[vertex];
+            vertex_score[vertex] = new_score;
+            const u32* const triangles = &vertex_triangles[first_triangle[vertex]];
+            for (u32 j = 0; j < remaining_valence[vertex]; ++j)
+            {
+                const u32 triangle = triangles[j];
+                triangle_score[triangle] += score_delta;
+                if (triangle_score[triangle] > best_score)
+                {
+                    best_score = triangle_score[triangle];
+                    best_triangle = triangle;
+                }
+            }
+        }
+        cache_size = new_cache_size < FORSYTH_CACHE_SIZE ? new_cache_size : FORSYTH_CACHE_SIZE;
+        memcpy(cache, new_cache, cache_size * sizeof(u32));
+    }
+    indices.swap(optimized_indices);
+}
+
+ftstd::VResult frametech::graphics::MeshOptimizer::optimizeOverdraw(frametech::graphics::Mesh& mesh, const f32 threshold) noexcept
+{
+    if (nullptr != mesh.m_source)
+        return ftstd::VResult::Error((char*)"cannot optimize the indices of a mapped mesh");
+    const size_t nb_vertices = mesh.m_vertices.size();
+    if (!areIndicesValid(mesh.m_indices, nb_vertices))
+        return ftstd::VResult::Error((char*)"cannot optimize a mesh with invalid indices");
+    const size_t nb_triangles = mesh.m_indices.size() / 3;
+    if (nb_triangles < 2)
+        return ftstd::VResult::Ok();
+
+    const std::vector<u32>& indices = mesh.m_indices;
+
+    // Split the triangles in clusters: a new cluster starts on each triangle whose
+    // 3 vertices miss the simulated cache, as the cache restarts there anyway
+    std::vector<u32> cluster_starts;
+    {
+        std::vector<u64> entered_at(nb_vertices, 0);
+        u64 nb_misses = 0;
+        for (size_t triangle = 0; triangle < nb_triangles; ++triangle)
+        {
+            u32 triangle_misses = 0;
+            for (size_t corner = 0; corner < 3; ++corner)
+            {
+                const u32 vertex = indices[triangle * 3 + corner];
+                if (0 == entered_at[vertex] || nb_misses - entered_at[vertex] >= VERTEX_CACHE_ANALYSIS_SIZE)
+                {
+                    ++nb_misses;
+                    entered_at[vertex] = nb_misses;
+                    ++triangle_misses;
+                }
+            }
+            if (3 == triangle_misses)
+                cluster_starts.push_back(static_cast<u32>(triangle));
+        }
+    }
+    if (cluster_starts.size() < 2)
+        return ftstd::VResult::Ok();
+    cluster_starts.push_back(static_cast<u32>(nb_triangles));
+
+    // Sort the clusters by how much they face outwards: their area-weighted normal
+    // against the direction from the center of the mesh to theirs
+    glm::vec3 mesh_centroid(0.0f);
+    f32 mesh_area = 0.0f;
+    const size_t nb_clusters = cluster_starts.size() - 1;
+    std::vector<glm::vec3> cluster_centroids(nb_clusters, glm::vec3(0.0f));
+    std::vector<glm::vec3> cluster_normals(nb_clusters, glm::vec3(0.0f));
+    for (size_t cluster = 0; cluster < nb_clusters; ++cluster)
+    {
+        f32 cluster_area = 0.0f;
+        for (u32 triangle = cluster_starts[cluster]; triangle < cluster_starts[cluster + 1]; ++triangle)
+        {
+            const glm::vec3& a = mesh.m_vertices[indices[triangle * 3]].m_position;
+            const glm::vec3& b = mesh.m_vertices[indices[triangle * 3 + 1]].m_position;
+            const glm::vec3& c = mesh.m_vertices[indices[triangle * 3 + 2]].m_position;
+            const glm::vec3 normal = glm::cross(b - a, c - a);
+            const f32 area = glm::length(normal);
+            const glm::vec3 centroid = (a + b + c) / 3.0f;
+            cluster_centroids[cluster] += centroid * area;
+            cluster_normals[cluster] += normal;
+            cluster_area += area;
+        }
+        mesh_centroid += cluster_centroids[cluster];
+        mesh_area += cluster_area;
+        if (cluster_area > 0.0f)
+            cluster_centroids[cluster] /= cluster_area;
+    }
+    if (mesh_area > 0.0f)
+        mesh_centroid /= mesh_area;
+
+    std::vector<f32> cluster_sort_keys(nb_clusters);
+    std::vector<u32> cluster_order(nb_clusters);
+    for (size_t cluster = 0; cluster < nb_clusters; ++cluster)
+    {
+        const f32 normal_length = glm::length(cluster_normals[cluster]);
+        const glm::vec3 normal = normal_length > 0.0f ? cluster_normals[cluster] / normal_length : glm::vec3(0.0f);
+        cluster_sort_keys[cluster] = glm::dot(cluster_centroids[cluster] - mesh_centroid, normal);
+        cluster_order[cluster] = static_cast<u32>(cluster);
+    }
+    std::stable_sort(cluster_order.begin(), cluster_order.end(), [&cluster_sort_keys](const u32 a, const u32 b) {
+        return cluster_sort_keys[a] > cluster_sort_keys[b];
+    });
+
+    std::vector<u32> sorted_indices;
+    sorted_indices.reserve(indices.size());
+    for (const u32 cluster : cluster_order)
+        sorted_indices.insert(sorted_indices.end(),
+                              indices.begin() + cluster_starts[cluster] * 3,
+                              indices.begin() + cluster_starts[cluster + 1] * 3);
+
+    const VertexCacheStatistics before = analyzeVertexCache(indices.data(), indices.size(), nb_vertices);
+    const VertexCacheStatistics after = analyzeVertexCache(sorted_indices.data(), sorted_indices.size(), nb_vertices);
+    if (after.m_acmr > before.m_acmr * threshold)
+    {
+        Log("> Mesh '%s' overdraw optimization skipped: ACMR would go from %.3f to %.3f",
+            mesh.m_name,
+            static_cast<f64>(before.m_acmr),
+            static_cast<f64>(after.m_acmr));
+        return ftstd::VResult::Ok();
+    }
+    Log("> Mesh '%s' overdraw optimization: %zu clusters, ACMR %.3f -> %.3f",
+        mesh.m_name,
+        nb_clusters,
+        static_cast<f64>(before.m_acmr),
+        static_cast<f64>(after.m_acmr));
+    mesh.m_indices.swap(sorted_indices);
+    return ftstd::VResult::Ok();
+}
+
+ftstd::VResult frametech::graphics::MeshOptimizer::optimizeVertexFetch(frametech::graphics::Mesh& mesh) noexcept
+{
+    if (nullptr != mesh.m_source)
+        return ftstd::VResult::Error((char*)"cannot optimize the vertices of a mapped mesh");
+    const size_t nb_vertices = mesh.m_vertices.size();
+    if (!areIndicesValid(mesh.m_indices, nb_vertices))
+        return ftstd::VResult::Error((char*)"cannot optimize a mesh with invalid indices");
+    if (mesh.m_indices.empty())
+        return ftstd::VResult::Ok();
+
+    std::vector<u32> remap(nb_vertices, NO_VERTEX);
+    std::vector<Vertex> fetched_vertices;
+    fetched_vertices.reserve(nb_vertices);
+    for (u32& index : mesh.m_indices)
+    {
+        if (NO_VERTEX == remap[index])
+        {
+            remap[index] = static_cast<u32>(fetched_vertices.size());
+            fetched_vertices.push_back(mesh.m_vertices[index]);
+        }
+        index = remap[index];
+    }
+    if (fetched_vertices.size() != nb_vertices)
+        Log("> Mesh '%s' vertex fetch optimization: %zu unused vertices removed", mesh.m_name, nb_vertices - fetched_vertices.size());
+    mesh.m_vertices.swap(fetched_vertices);
+    return ftstd::VResult::Ok();
+}
@@ -0,0 +1,89 @@
+//
+//  mesh_optimizer.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _mesh_optimizer_hpp
+#define _mesh_optimizer_hpp
+
+#include "../../ftstd/result.hpp"
+#include "../platform.hpp"
+#include <vector>
+
+namespace frametech
+{
+    namespace graphics
+    {
+        struct Mesh;
+
+        /// @brief Default tolerance used to weld the vertices of imported meshes
+        constexpr f32 DEFAULT_WELD_EPSILON = 1e-6f;
+        /// @brief Size of the FIFO cache used to estimate the post-transform vertex cache efficiency
+        constexpr u32 VERTEX_CACHE_ANALYSIS_SIZE = 16;
+
+        /// @brief Post-transform vertex cache efficiency of an index buffer
+        struct VertexCacheStatistics
+        {
+            /// @brief Number of vertex shader invocations
+            u64 m_transformed_vertices = 0;
+            /// @brief Average cache miss ratio: transformed vertices per triangle.
+            /// 3 is the worst, ~0.5 the best on regular meshes.
+            f32 m_acmr = 0.0f;
+            /// @brief Average transformed vertex ratio: transformed vertices per vertex.
+            /// 1 is the best.
+            f32 m_atvr = 0.0f;
+        };
+
+        /// @brief Processing passes run on the vertices / indices of a Mesh object,
+        /// once at import time. Those only work on meshes stored in m_vertices / m_indices
+        /// (not on meshes mapped from a binary mesh file).
+        class MeshOptimizer
+        {
+        public:
+            /// @brief Merges the vertices whose attributes (position, color, texture coordinates)
+            /// are all within `epsilon` of each other, and rebuilds the indices.
+            /// With an epsilon of 0, only the exact duplicates are merged.
+            /// @param mesh The mesh to weld
+            /// @param epsilon The tolerance, per component
+            /// @return A VResult type
+            static ftstd::VResult weldVertices(frametech::graphics::Mesh& mesh, const f32 epsilon = DEFAULT_WELD_EPSILON) noexcept;
+            /// @brief Reorders the triangles for the post-transform vertex cache
+            /// (Tom Forsyth's linear-speed vertex cache optimisation).
+            /// @param mesh The mesh whose indices to reorder
+            /// @return A VResult type
+            static ftstd::VResult optimizeVertexCache(frametech::graphics::Mesh& mesh) noexcept;
+            /// @brief Reorders the triangles of `indices` for the post-transform vertex cache - the
+            /// indices must be valid (see the Mesh version)
+            /// @param indices The indices to reorder, 3 per triangle
+            /// @param vertices_count The number of vertices referenced by the indices
+            static void optimizeVertexCache(std::vector<u32>& indices, const u64 vertices_count) noexcept;
+            /// @brief Reorders the clusters of triangles produced by optimizeVertexCache so that the
+            /// ones facing outwards are drawn first, to reduce overdraw (Sander et al., Tipsify).
+            /// The new order is kept only if the ACMR does not grow above `threshold` times the current one.
+            /// @param mesh The mesh whose indices to reorder - call optimizeVertexCache first
+            /// @param threshold The maximum ACMR ratio to accept
+            /// @return A VResult type
+            static ftstd::VResult optimizeOverdraw(frametech::graphics::Mesh& mesh, const f32 threshold = 1.05f) noexcept;
+            /// @brief Reorders the vertices in the order of their first use in the indices,
+            /// for fetch locality, and drops the vertices that are not used.
+            /// @param mesh The mesh whose vertices to reorder - call it after the index reorders
+            /// @return A VResult type
+            static ftstd::VResult optimizeVertexFetch(frametech::graphics::Mesh& mesh) noexcept;
+            /// @brief Simulates a FIFO post-transform vertex cache of `cache_size` entries on the indices
+            /// @param indices The indices, 3 per triangle
+            /// @param indices_count The number of indices
+            /// @param vertices_count The number of vertices referenced by the indices
+            /// @param cache_size The number of entries of the simulated cache
+            /// @return The statistics of the indices
+            static VertexCacheStatistics analyzeVertexCache(const u32* indices,
+                                                            const u64 indices_count,
+                                                            const u64 vertices_count,
+                                                            const u32 cache_size = VERTEX_CACHE_ANALYSIS_SIZE) noexcept;
+        };
+    } // namespace graphics
+} // namespace frametech
+
+#endif // _mesh_optimizer_hpp
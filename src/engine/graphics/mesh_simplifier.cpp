@@ -0,0 +1,415 @@
+//
+//  mesh_simplifier.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#include "mesh_simplifier.hpp"
+#include "../../ftstd/debug_tools.h"
+#include "mesh.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <unordered_set>
+
+using frametech::engine::graphics::shaders::Vertex;
+
+namespace
+{
+    /// @brief Weight of the planes that keep the borders in place, relatively to the planes of the triangles
+    constexpr f64 BORDER_WEIGHT = 10.0;
+    /// @brief A level that keeps more than this ratio of the previous one is not worth its indices
+    constexpr f64 MIN_LOD_REDUCTION = 0.95;
+
+    /// @brief How a position can move
+    enum class PositionKind : u8
+    {
+        /// Inside a manifold surface: collapses along any edge
+        MANIFOLD,
+        /// On an open edge: only collapses along the border
+        BORDER,
+        /// On a UV seam (several vertices on the position), or non-manifold: never moves
+        LOCKED,
+    };
+
+    /// @brief Sum of squared distances to planes, weighted:
+    /// Q(p) = p^T A p + 2 b.p + c, A symmetric
+    struct Quadric
+    {
+        f64 m_a00 = 0.0, m_a11 = 0.0, m_a22 = 0.0;
+        f64 m_a01 = 0.0, m_a02 = 0.0, m_a12 = 0.0;
+        f64 m_b0 = 0.0, m_b1 = 0.0, m_b2 = 0.0;
+        f64 m_c = 0.0;
+        /// @brief Sum of the weights, to get back a squared distance
+        f64 m_weight = 0.0;
+
+        /// @brief Adds the plane of unit normal `normal` through `point`
+        void addPlane(const glm::dvec3& normal, const glm::dvec3& point, const f64 weight) noexcept
+        {
+            const f64 distance = -glm::dot(normal, point);
+            m_a00 += weight * normal.x * normal.x;
+            m_a11 += weight * normal.y * normal.y;
+            m_a22 += weight * normal.z * normal.z;
+            m_a01 += weight * normal.x * normal.y;
+            m_a02 += weight * normal.x * normal.z;
+            m_a12 += weight * normal.y * normal.z;
+            m_b0 += weight * normal.x * distance;
+            m_b1 += weight * normal.y * distance;
+            m_b2 += weight * normal.z * distance;
+            m_c += weight * distance * distance;
+            m_weight += weight;
+        }
+        void add(const Quadric& other) noexcept
+        {
+            m_a00 += other.m_a00;
+            m_a11 += other.m_a11;
+            m_a22 += other.m_a22;
+            m_a01 += other.m_a01;
+            m_a02 += other.m_a02;
+            m_a12 += other.m_a12;
+            m_b0 += other.m_b0;
+            m_b1 += other.m_b1;
+            m_b2 += other.m_b2;
+            m_c += other.m_c;
+            m_weight += other.m_weight;
+        }
+        /// @brief Returns the weighted mean of the squared distances from `point` to the planes
+        f64 getError(const glm::dvec3& p) const noexcept
+        {
+            if (m_weight <= 0.0)
+                return 0.0;
+            const f64 error = m_a00 * p.x * p.x + m_a11 * p.y * p.y + m_a22 * p.z * p.z +
+                              2.0 * (m_a01 * p.x * p.y + m_a02 * p.x * p.z + m_a12 * p.y * p.z) +
+                              2.0 * (m_b0 * p.x + m_b1 * p.y + m_b2 * p.z) +
+                              m_c;
+            return std::max(error, 0.0) / m_weight;
+        }
+    };
+
+    /// @brief A candidate collapse: `m_from` is merged into `m_to` (two vertices of a triangle)
+    struct Collapse
+    {
+        u32 m_from;
+        u32 m_to;
+        /// @brief Squared distance added by the collapse
+        f64 m_error;
+    };
+
+    /// @brief Key of the half-edge going from the position `from` to the position `to`
+    inline u64 getEdgeKey(const u32 from, const u32 to) noexcept
+    {
+        return (static_cast<u64>(from) << 32) | to;
+    }
+
+    /// @brief Returns the non-normalized normal of the triangle (a, b, c)
+    inline glm::dvec3 getNormal(const glm::dvec3& a, const glm::dvec3& b, const glm::dvec3& c) noexcept
+    {
+        return glm::cross(b - a, c - a);
+    }
+} // namespace
+
+ftstd::VResult frametech::graphics::MeshSimplifier::simplify(const Vertex* vertices,
+                                                            const u64 vertices_count,
+                                                            const u32* indices,
+                                                            const u64 indices_count,
+                                                            const u64 target_indices_count,
+                                                            const f32 max_error,
+                                                            std::vector<u32>& simplified_indices,
+                                                            f32& error) noexcept
+{
+    error = 0.0f;
+    if (0 != indices_count % 3)
+        return ftstd::VResult::Error((char*)"the indices are not a triangle list");
+    if (vertices_count > UINT32_MAX)
+        return ftstd::VResult::Error((char*)"too many vertices to simplify");
+    for (u64 i = 0; i < indices_count; ++i)
+    {
+        if (indices[i] >= vertices_count)
+            return ftstd::VResult::Error((char*)"index out of the vertices");
+    }
+    simplified_indices.assign(indices, indices + indices_count);
+    const u32 nb_vertices = static_cast<u32>(vertices_count);
+
+    // The vertices on the same position (split by their texture coordinates or colors) move
+    // together: everything below works on positions, named by their first vertex
+    std::vector<u32> positions(nb_vertices);
+    std::vector<u32> wedges_count(nb_vertices, 0);
+    {
+        std::vector<u32> sorted_vertices(nb_vertices);
+        std::iota(sorted_vertices.begin(), sorted_vertices.end(), 0);
+        const auto is_before = [vertices](const u32 a, const u32 b) {
+            const glm::vec3& pa = vertices[a].m_position;
+            const glm::vec3& pb = vertices[b].m_position;
+            if (pa.x != pb.x)
+                return pa.x < pb.x;
+            if (pa.y != pb.y)
+                return pa.y < pb.y;
+            if (pa.z != pb.z)
+                return pa.z < pb.z;
+            return a < b;
+        };
+        std::sort(sorted_vertices.begin(), sorted_vertices.end(), is_before);
+        for (u32 i = 0; i < nb_vertices; ++i)
+        {
+            const u32 vertex = sorted_vertices[i];
+            const bool same_position = i > 0 && vertices[sorted_vertices[i - 1]].m_position == vertices[vertex].m_position;
+            positions[vertex] = same_position ? positions[sorted_vertices[i - 1]] : vertex;
+        }
+        // Only the vertices used by the triangles count as wedges
+        std::vector<bool> used(nb_vertices, false);
+        for (u64 i = 0; i < indices_count; ++i)
+            used[indices[i]] = true;
+        for (u32 vertex = 0; vertex < nb_vertices; ++vertex)
+            wedges_count[positions[vertex]] += used[vertex] ? 1 : 0;
+    }
+    const auto getPosition = [vertices](const u32 vertex) {
+        return glm::dvec3(vertices[vertex].m_position);
+    };
+
+    // Half-edges between positions: an edge without its opposite is a border
+    std::unordered_set<u64> half_edges;
+    half_edges.reserve(indices_count);
+    std::vector<PositionKind> kinds(nb_vertices, PositionKind::MANIFOLD);
+    for (u64 i = 0; i < indices_count; i += 3)
+    {
+        for (u32 corner = 0; corner < 3; ++corner)
+        {
+            const u32 from = positions[indices[i + corner]];
+            const u32 to = positions[indices[i + (corner + 1) % 3]];
+            // The same half-edge twice: more than two triangles on the edge, or flipped ones
+            if (from != to && !half_edges.insert(getEdgeKey(from, to)).second)
+            {
+                kinds[from] = PositionKind::LOCKED;
+                kinds[to] = PositionKind::LOCKED;
+            }
+        }
+    }
+    const auto isBorder = [&half_edges](const u32 from, const u32 to) {
+        return 0 == half_edges.count(getEdgeKey(to, from)) || 0 == half_edges.count(getEdgeKey(from, to));
+    };
+
+    // Quadrics of the planes of the triangles, weighted by their area, plus the
+    // planes orthogonal to the borders, to keep them in place
+    std::vector<Quadric> quadrics(nb_vertices);
+    for (u64 i = 0; i < indices_count; i += 3)
+    {
+        const u32 triangle_positions[3] = {positions[indices[i]], positions[indices[i + 1]], positions[indices[i + 2]]};
+        const glm::dvec3 a = getPosition(triangle_positions[0]);
+        const glm::dvec3 normal = getNormal(a, getPosition(triangle_positions[1]), getPosition(triangle_positions[2]));
+        const f64 area = glm::length(normal);
+        if (area <= 0.0)
+            continue;
+        const glm::dvec3 unit_normal = normal / area;
+        for (u32 corner = 0; corner < 3; ++corner)
+            quadrics[triangle_positions[corner]].addPlane(unit_normal, a, area * 0.5);
+        for (u32 corner = 0; corner < 3; ++corner)
+        {
+            const u32 from = triangle_positions[corner];
+            const u32 to = triangle_positions[(corner + 1) % 3];
+            if (0 != half_edges.count(getEdgeKey(to, from)))
+                continue;
+            if (PositionKind::MANIFOLD == kinds[from])
+                kinds[from] = PositionKind::BORDER;
+            if (PositionKind::MANIFOLD == kinds[to])
+                kinds[to] = PositionKind::BORDER;
+            const glm::dvec3 edge = getPosition(to) - getPosition(from);
+            const glm::dvec3 border_normal = glm::cross(edge, unit_normal);
+            const f64 border_normal_length = glm::length(border_normal);
+            if (border_normal_length <= 0.0)
+                continue;
+            const f64 weight = BORDER_WEIGHT * glm::dot(edge, edge);
+            quadrics[from].addPlane(border_normal / border_normal_length, getPosition(from), weight);
+            quadrics[to].addPlane(border_normal / border_normal_length, getPosition(from), weight);
+        }
+    }
+    for (u32 position = 0; position < nb_vertices; ++position)
+    {
+        if (wedges_count[position] > 1)
+            kinds[position] = PositionKind::LOCKED;
+    }
+
+    const f64 max_squared_error = static_cast<f64>(max_error) * static_cast<f64>(max_error);
+    f64 result_error = 0.0;
+    std::vector<Collapse> collapses;
+    std::vector<u32> remap(nb_vertices);
+    std::vector<bool> locked(nb_vertices);
+    std::vector<u32> first_triangle(nb_vertices + 1);
+    std::vector<u32> position_triangles;
+    while (simplified_indices.size() > target_indices_count)
+    {
+        const u64 nb_triangles = simplified_indices.size() / 3;
+
+        // Triangles of each position, packed
+        std::fill(first_triangle.begin(), first_triangle.end(), 0);
+        for (const u32 index : simplified_indices)
+            ++first_triangle[positions[index] + 1];
+        for (u32 position = 0; position < nb_vertices; ++position)
+            first_triangle[position + 1] += first_triangle[position];
+        position_triangles.resize(simplified_indices.size());
+        {
+            std::vector<u32> filled(first_triangle.begin(), first_triangle.end() - 1);
+            for (u64 i = 0; i < simplified_indices.size(); ++i)
+                position_triangles[filled[positions[simplified_indices[i]]]++] = static_cast<u32>(i / 3);
+        }
+
+        // Cheapest direction of each edge that can collapse
+        collapses.clear();
+        for (u64 i = 0; i < simplified_indices.size(); i += 3)
+        {
+            for (u32 corner = 0; corner < 3; ++corner)
+            {
+                const u32 a = simplified_indices[i + corner];
+                const u32 b = simplified_indices[i + (corner + 1) % 3];
+                const u32 pa = positions[a];
+                const u32 pb = positions[b];
+                // Each manifold edge is seen from its two triangles: keep one
+                if (pa == pb || (pa > pb && !isBorder(pa, pb)))
+                    continue;
+                const bool border_edge = isBorder(pa, pb);
+                const bool a_can_move = PositionKind::MANIFOLD == kinds[pa] || (PositionKind::BORDER == kinds[pa] && border_edge);
+                const bool b_can_move = PositionKind::MANIFOLD == kinds[pb] || (PositionKind::BORDER == kinds[pb] && border_edge);
+                if (!a_can_move && !b_can_move)
+                    continue;
+                Quadric quadric = quadrics[pa];
+                quadric.add(quadrics[pb]);
+                const f64 a_to_b_error = a_can_move ? quadric.getError(getPosition(pb)) : HUGE_VAL;
+                const f64 b_to_a_error = b_can_move ? quadric.getError(getPosition(pa)) : HUGE_VAL;
+                if (a_to_b_error <= b_to_a_error)
+                    collapses.push_back(Collapse{.m_from = a, .m_to = b, .m_error = a_to_b_error});
+                else
+                    collapses.push_back(Collapse{.m_from = b, .m_to = a, .m_error = b_to_a_error});
+            }
+        }
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) {
+            return a.m_error < b.m_error;
+        });
+
+        // A manifold collapse removes 2 triangles: aim at the target, without overshooting
+        const u64 target_triangles = target_indices_count / 3;
+        const u64 collapses_goal = std::max<u64>(1, (nb_triangles - target_triangles) / 2);
+        u64 nb_collapses = 0;
+        std::iota(remap.begin(), remap.end(), 0);
+        std::fill(locked.begin(), locked.end(), false);
+        for (const Collapse& collapse : collapses)
+        {
+            if (nb_collapses >= collapses_goal || collapse.m_error > max_squared_error)
+                break;
+            const u32 from = positions[collapse.m_from];
+            const u32 to = positions[collapse.m_to];
+            if (locked[from] || locked[to])
+                continue;
+            // The triangles around `from` that stay must not flip
+            const glm::dvec3 target_position = getPosition(to);
+            bool flips = false;
+            for (u32 i = first_triangle[from]; i < first_triangle[from + 1] && !flips; ++i)
+            {
+                const u32* triangle = &simplified_indices[position_triangles[i] * 3];
+                const u32 triangle_positions[3] = {positions[triangle[0]], positions[triangle[1]], positions[triangle[2]]};
+                if (triangle_positions[0] == to || triangle_positions[1] == to || triangle_positions[2] == to)
+                    continue;
+                glm::dvec3 corners[3] = {getPosition(triangle_positions[0]), getPosition(triangle_positions[1]), getPosition(triangle_positions[2])};
+                const glm::dvec3 normal = getNormal(corners[0], corners[1], corners[2]);
+                for (glm::dvec3& corner : corners)
+                    corner = corner == getPosition(from) ? target_position : corner;
+                const glm::dvec3 new_normal = getNormal(corners[0], corners[1], corners[2]);
+                // Flipped, or so thin that it is about to
+                flips = glm::dot(normal, new_normal) <= 0.25 * glm::length(normal) * glm::length(new_normal);
+            }
+            if (flips)
+                continue;
+            // The collapse changes every triangle around `from`: their other positions wait for the next pass
+            for (u32 i = first_triangle[from]; i < first_triangle[from + 1]; ++i)
+            {
+                const u32* triangle = &simplified_indices[position_triangles[i] * 3];
+                for (u32 corner = 0; corner < 3; ++corner)
+                    locked[positions[triangle[corner]]] = true;
+            }
+            // `from` has a single vertex (seams are locked): it takes the vertex of the edge
+            remap[collapse.m_from] = collapse.m_to;
+            quadrics[to].add(quadrics[from]);
+            result_error = std::max(result_error, collapse.m_error);
+            ++nb_collapses;
+        }
+        if (0 == nb_collapses)
+            break;
+
+        // Rewrite the triangles, and drop the ones that collapsed
+        u64 nb_indices = 0;
+        for (u64 i = 0; i < simplified_indices.size(); i += 3)
+        {
+            const u32 a = remap[simplified_indices[i]];
+            const u32 b = remap[simplified_indices[i + 1]];
+            const u32 c = remap[simplified_indices[i + 2]];
+            if (positions[a] == positions[b] || positions[b] == positions[c] || positions[c] == positions[a])
+                continue;
+            simplified_indices[nb_indices++] = a;
+            simplified_indices[nb_indices++] = b;
+            simplified_indices[nb_indices++] = c;
+        }
+        simplified_indices.resize(nb_indices);
+    }
+    error = static_cast<f32>(std::sqrt(result_error));
+    return ftstd::VResult::Ok();
+}
+
+ftstd::VResult frametech::graphics::MeshSimplifier::buildLods(frametech::graphics::Mesh& mesh, const std::vector<f32>& ratios) noexcept
+{
+    if (nullptr != mesh.m_source)
+        return ftstd::VResult::Error((char*)"cannot simplify a mapped mesh");
+    if (!mesh.m_lods.empty())
+        return ftstd::VResult::Error((char*)"the levels of detail have already been built");
+    if (mesh.m_indices.size() > UINT32_MAX)
+        return ftstd::VResult::Error((char*)"too many indices to simplify");
+    const u64 full_indices_count = mesh.m_indices.size();
+    const u64 full_triangles_count = full_indices_count / 3;
+    std::vector<MeshLod> lods = {MeshLod{.m_first_index = 0, .m_indices_count = static_cast<u32>(full_indices_count), .m_error = 0.0f}};
+    std::vector<u32> previous_indices = mesh.m_indices;
+    f32 error = 0.0f;
+    for (const f32 ratio : ratios)
+    {
+        if (ratio <= 0.0f || ratio >= 1.0f)
+            return ftstd::VResult::Error((char*)"the ratios of the levels of detail must be in (0, 1)");
+        const u64 target_indices_count = static_cast<u64>(static_cast<f64>(full_triangles_count) * ratio) * 3;
+        if (target_indices_count >= previous_indices.size())
+            continue;
+        std::vector<u32> lod_indices;
+        f32 lod_error = 0.0f;
+        if (const auto result = simplify(mesh.m_vertices.data(),
+                                         mesh.m_vertices.size(),
+                                         previous_indices.data(),
+                                         previous_indices.size(),
+                                         target_indices_count,
+                                         HUGE_VALF,
+                                         lod_indices,
+                                         lod_error);
+            result.IsError())
+            return result;
+        if (lod_indices.empty() || static_cast<f64>(lod_indices.size()) > static_cast<f64>(previous_indices.size()) * MIN_LOD_REDUCTION)
+        {
+            Log("> Mesh '%s' cannot be simplified below %llu triangles", mesh.m_name, static_cast<u64>(previous_indices.size() / 3));
+            break;
+        }
+        if (mesh.m_indices.size() + lod_indices.size() > UINT32_MAX)
+            break;
+        MeshOptimizer::optimizeVertexCache(lod_indices, mesh.m_vertices.size());
+        // Simplified from the previous level: the errors add up
+        error += lod_error;
+        lods.push_back(MeshLod{
+            .m_first_index = static_cast<u32>(mesh.m_indices.size()),
+            .m_indices_count = static_cast<u32>(lod_indices.size()),
+            .m_error = error,
+        });
+        mesh.m_indices.insert(mesh.m_indices.end(), lod_indices.begin(), lod_indices.end());
+        Log("> Mesh '%s' LOD %zu: %llu triangles (%.1f %%), error %g",
+            mesh.m_name,
+            lods.size() - 1,
+            static_cast<u64>(lod_indices.size() / 3),
+            100.0 * static_cast<f64>(lod_indices.size()) / static_cast<f64>(full_indices_count),
+            static_cast<f64>(error));
+        previous_indices.swap(lod_indices);
+    }
+    if (lods.size() > 1)
+        mesh.m_lods.swap(lods);
+    return ftstd::VResult::Ok();
+}
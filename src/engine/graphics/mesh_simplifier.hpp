@@ -0,0 +1,83 @@
+//
+//  mesh_simplifier.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _mesh_simplifier_hpp
+#define _mesh_simplifier_hpp
+
+#include "../../ftstd/result.hpp"
+#include "../platform.hpp"
+#include "shaders.h"
+#include <vector>
+
+namespace frametech
+{
+    namespace graphics
+    {
+        struct Mesh;
+
+        /// @brief Projected error, in pixels, under which a level of detail is used
+        constexpr f32 DEFAULT_LOD_PIXEL_ERROR = 1.0f;
+
+        /// @brief A level of detail of a Mesh object: a range of its indices, drawn with
+        /// the same vertices as the full mesh.
+        /// Stored as is in the binary mesh files.
+        struct MeshLod
+        {
+            /// @brief First index of the level in the indices of the mesh
+            u32 m_first_index;
+            /// @brief Number of indices of the level
+            u32 m_indices_count;
+            /// @brief Upper bound of the distance between the level and the full mesh,
+            /// in mesh space - 0 for the full mesh
+            f32 m_error;
+            u32 m_padding;
+        };
+        static_assert(sizeof(MeshLod) == 16, "the levels of detail are stored in the binary mesh files");
+
+        /// @brief Edge-collapse simplification with quadric error metrics (Garland & Heckbert).
+        /// The vertices are never moved nor created: a collapse merges a vertex into one of
+        /// its neighbours, so every level of detail shares the vertices of the full mesh.
+        /// UV seams (vertices split on the same position) are locked, and the borders only
+        /// collapse along themselves.
+        class MeshSimplifier
+        {
+        public:
+            /// @brief Simplifies the triangles of `indices`, until there are at most `target_indices_count`
+            /// indices left, or no collapse is possible without going above `max_error`.
+            /// @param vertices The vertices referenced by the indices
+            /// @param vertices_count The number of vertices
+            /// @param indices The indices, 3 per triangle
+            /// @param indices_count The number of indices
+            /// @param target_indices_count The number of indices to reach
+            /// @param max_error The maximum distance to the input triangles, in mesh space
+            /// @param simplified_indices The simplified indices - replaced
+            /// @param error The distance reached by the simplification, in mesh space
+            /// @return A VResult type
+            static ftstd::VResult simplify(const frametech::engine::graphics::shaders::Vertex* vertices,
+                                           const u64 vertices_count,
+                                           const u32* indices,
+                                           const u64 indices_count,
+                                           const u64 target_indices_count,
+                                           const f32 max_error,
+                                           std::vector<u32>& simplified_indices,
+                                           f32& error) noexcept;
+            /// @brief Builds the levels of detail of `mesh`: each ratio of `ratios` (decreasing, in (0, 1))
+            /// is a level with about this ratio of the triangles of the full mesh, simplified from the
+            /// previous level and optimized for the vertex cache. The indices of the levels are appended
+            /// to the ones of the mesh, whose range becomes level 0.
+            /// Stops at the first level that cannot be simplified enough (locked seams...).
+            /// Only works on meshes stored in m_vertices / m_indices - call it after the index reorders.
+            /// @param mesh The mesh to simplify
+            /// @param ratios The ratio of triangles of each level
+            /// @return A VResult type
+            static ftstd::VResult buildLods(frametech::graphics::Mesh& mesh, const std::vector<f32>& ratios) noexcept;
+        };
+    } // namespace graphics
+} // namespace frametech
+
+#endif // _mesh_simplifier_hpp
@@ -0,0 +1,231 @@
+//
+//  meshlet.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#include "meshlet.hpp"
+#include "../../ftstd/debug_tools.h"
+#include "mesh.hpp"
+#include <algorithm>
+#include <cmath>
+
+using frametech::engine::graphics::shaders::Vertex;
+
+namespace
+{
+    /// @brief Marks a vertex not referenced by any meshlet yet
+    constexpr u32 NO_MESHLET = UINT32_MAX;
+
+    /// @brief Computes the bounding sphere and the normal cone of `meshlet`
+    void computeBounds(frametech::graphics::Meshlet& meshlet, const Vertex* vertices, const u32* indices) noexcept
+    {
+        const u32* meshlet_indices = indices + meshlet.m_first_index;
+        const u32 indices_count = meshlet.m_triangles_count * 3;
+
+        // Sphere around the bounding box: not the tightest one, but cheap and stable
+        glm::vec3 min_position = vertices[meshlet_indices[0]].m_position;
+        glm::vec3 max_position = min_position;
+        for (u32 i = 1; i < indices_count; ++i)
+        {
+            min_position = glm::min(min_position, vertices[meshlet_indices[i]].m_position);
+            max_position = glm::max(max_position, vertices[meshlet_indices[i]].m_position);
+        }
+        const glm::vec3 center = (min_position + max_position) * 0.5f;
+        f32 squared_radius = 0.0f;
+        for (u32 i = 0; i < indices_count; ++i)
+        {
+            const glm::vec3 offset = vertices[meshlet_indices[i]].m_position - center;
+            squared_radius = std::max(squared_radius, glm::dot(offset, offset));
+        }
+        meshlet.m_center = center;
+        meshlet.m_radius = std::sqrt(squared_radius);
+
+        // The front faces are counter-clockwise: the normal of (a, b, c) is (b - a) x (c - a)
+        glm::vec3 normals_sum = glm::vec3(0.0f);
+        for (u32 i = 0; i < indices_count; i += 3)
+        {
+            const glm::vec3& a = vertices[meshlet_indices[i]].m_position;
+            const glm::vec3 normal = glm::cross(vertices[meshlet_indices[i + 1]].m_position - a, vertices[meshlet_indices[i + 2]].m_position - a);
+            const f32 length = glm::length(normal);
+            if (length > 0.0f)
+                normals_sum += normal / length;
+        }
+        meshlet.m_cone_axis = glm::vec3(0.0f);
+        meshlet.m_cone_apex = center;
+        meshlet.m_cone_cutoff = 1.0f;
+        const f32 normals_sum_length = glm::length(normals_sum);
+        if (normals_sum_length <= 0.0f)
+            return;
+        const glm::vec3 axis = normals_sum / normals_sum_length;
+        f32 min_dot = 1.0f;
+        for (u32 i = 0; i < indices_count; i += 3)
+        {
+            const glm::vec3& a = vertices[meshlet_indices[i]].m_position;
+            const glm::vec3 normal = glm::cross(vertices[meshlet_indices[i + 1]].m_position - a, vertices[meshlet_indices[i + 2]].m_position - a);
+            const f32 length = glm::length(normal);
+            if (length > 0.0f)
+                min_dot = std::min(min_dot, glm::dot(normal / length, axis));
+        }
+        meshlet.m_cone_axis = axis;
+        // A normal at 90 degrees or more from the axis: some triangle faces any direction
+        if (min_dot <= 0.0f)
+            return;
+        // The apex is moved back along the axis until it lies behind the plane of every triangle
+        f32 max_distance = 0.0f;
+        for (u32 i = 0; i < indices_count; i += 3)
+        {
+            const glm::vec3& a = vertices[meshlet_indices[i]].m_position;
+            const glm::vec3 normal = glm::cross(vertices[meshlet_indices[i + 1]].m_position - a, vertices[meshlet_indices[i + 2]].m_position - a);
+            const f32 length = glm::length(normal);
+            if (length <= 0.0f)
+                continue;
+            const glm::vec3 unit_normal = normal / length;
+            max_distance = std::max(max_distance, glm::dot(center - a, unit_normal) / glm::dot(axis, unit_normal));
+        }
+        meshlet.m_cone_apex = center - axis * max_distance;
+        meshlet.m_cone_cutoff = std::sqrt(1.0f - min_dot * min_dot);
+    }
+} // namespace
+
+ftstd::VResult frametech::graphics::MeshletUtils::buildMeshlets(frametech::graphics::Mesh& mesh, const u32 max_vertices, const u32 max_triangles) noexcept
+{
+    if (nullptr != mesh.m_source)
+        return ftstd::VResult::Error((char*)"cannot split a mapped mesh in meshlets");
+    if (mesh.getSubmeshesCount() > 1)
+        return ftstd::VResult::Error((char*)"cannot split a mesh with several submeshes in meshlets");
+    const u64 indices_count = mesh.getLod(mesh.getSubmesh(0), 0).m_indices_count;
+    if (0 != indices_count % 3)
+        return ftstd::VResult::Error((char*)"the indices are not a triangle list");
+    if (max_vertices < 3 || 0 == max_triangles)
+        return ftstd::VResult::Error((char*)"meshlets must hold at least one triangle");
+    if (mesh.m_indices.size() > UINT32_MAX)
+        return ftstd::VResult::Error((char*)"too many indices to split in meshlets");
+    mesh.m_meshlets.clear();
+
+    const std::vector<Vertex>& vertices = mesh.m_vertices;
+    const std::vector<u32>& indices = mesh.m_indices;
+    for (const u32 index : indices)
+    {
+        if (index >= vertices.size())
+            return ftstd::VResult::Error((char*)"index out of the vertices");
+    }
+
+    // Last meshlet referencing each vertex, to count the unique vertices of the current one
+    std::vector<u32> vertex_meshlets(vertices.size(), NO_MESHLET);
+    Meshlet meshlet{};
+    for (u64 i = 0; i < indices_count; i += 3)
+    {
+        const u32 meshlet_index = static_cast<u32>(mesh.m_meshlets.size());
+        const u32 a = indices[i];
+        const u32 b = indices[i + 1];
+        const u32 c = indices[i + 2];
+        u32 new_vertices = (vertex_meshlets[a] != meshlet_index) +
+                           (vertex_meshlets[b] != meshlet_index && b != a) +
+                           (vertex_meshlets[c] != meshlet_index && c != a && c != b);
+        if (meshlet.m_triangles_count > 0 &&
+            (meshlet.m_triangles_count == max_triangles || meshlet.m_vertices_count + new_vertices > max_vertices))
+        {
+            mesh.m_meshlets.push_back(meshlet);
+            meshlet = Meshlet{.m_first_index = static_cast<u32>(i)};
+            // Every vertex of the triangle is new to the next meshlet
+            new_vertices = 1 + (b != a) + (c != a && c != b);
+        }
+        const u32 current_meshlet_index = static_cast<u32>(mesh.m_meshlets.size());
+        vertex_meshlets[a] = current_meshlet_index;
+        vertex_meshlets[b] = current_meshlet_index;
+        vertex_meshlets[c] = current_meshlet_index;
+        meshlet.m_vertices_count += new_vertices;
+        ++meshlet.m_triangles_count;
+    }
+    if (meshlet.m_triangles_count > 0)
+        mesh.m_meshlets.push_back(meshlet);
+
+    for (Meshlet& built_meshlet : mesh.m_meshlets)
+        computeBounds(built_meshlet, vertices.data(), indices.data());
+    Log("> Mesh '%s' split in %zu meshlets (%.1f triangles per meshlet)",
+        mesh.m_name,
+        mesh.m_meshlets.size(),
+        mesh.m_meshlets.empty() ? 0.0 : static_cast<f64>(indices_count / 3) / static_cast<f64>(mesh.m_meshlets.size()));
+    return ftstd::VResult::Ok();
+}
+
+frametech::graphics::CullingView frametech::graphics::MeshletUtils::getCullingView(const glm::mat4& model,
+                                                                                   const glm::mat4& view,
+                                                                                   const glm::mat4& projection) noexcept
+{
+    // Everything happens in mesh space: the frustum planes are extracted from the
+    // model-view-projection matrix (Gribb & Hartmann), and the camera is moved in mesh space
+    CullingView culling_view{};
+    const glm::mat4 model_view = view * model;
+    const glm::mat4 model_view_projection = projection * model_view;
+    const glm::vec4 w_row = glm::vec4(model_view_projection[0][3], model_view_projection[1][3], model_view_projection[2][3], model_view_projection[3][3]);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        const glm::vec4 row = glm::vec4(model_view_projection[0][axis], model_view_projection[1][axis], model_view_projection[2][axis], model_view_projection[3][axis]);
+        // The near plane is the OpenGL one (-w <= z): a bit looser with a [0, 1] depth range, never wrong
+        culling_view.m_planes[axis * 2] = w_row + row;
+        culling_view.m_planes[axis * 2 + 1] = w_row - row;
+    }
+    bool can_cull = 0.0f != glm::determinant(model_view);
+    for (glm::vec4& plane : culling_view.m_planes)
+    {
+        const f32 length = glm::length(glm::vec3(plane));
+        can_cull = can_cull && length > 0.0f;
+        plane = length > 0.0f ? plane / length : plane;
+    }
+    if (can_cull)
+    {
+        const glm::vec4 camera = glm::inverse(model_view) * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        can_cull = 0.0f != camera.w;
+        culling_view.m_camera_position = glm::vec3(camera) / (can_cull ? camera.w : 1.0f);
+    }
+    culling_view.m_can_cull = can_cull;
+    return culling_view;
+}
+
+bool frametech::graphics::MeshletUtils::isSphereVisible(const CullingView& culling_view, const glm::vec3& center, const f32 radius) noexcept
+{
+    if (!culling_view.m_can_cull)
+        return true;
+    for (const glm::vec4& plane : culling_view.m_planes)
+    {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+            return false;
+    }
+    return true;
+}
+
+void frametech::graphics::MeshletUtils::cullMeshlets(const CullingView& culling_view,
+                                                     const Meshlet* meshlets,
+                                                     const u64 meshlets_count,
+                                                     const i32 vertex_offset,
+                                                     std::vector<IndexRange>& ranges,
+                                                     MeshletCullingStatistics& statistics) noexcept
+{
+    statistics.m_meshlets += static_cast<u32>(meshlets_count);
+    for (u64 i = 0; i < meshlets_count; ++i)
+    {
+        const Meshlet& meshlet = meshlets[i];
+        statistics.m_triangles += meshlet.m_triangles_count;
+        if (culling_view.m_can_cull)
+        {
+            if (!isSphereVisible(culling_view, meshlet.m_center, meshlet.m_radius))
+                continue;
+            const glm::vec3 view_direction = meshlet.m_cone_apex - culling_view.m_camera_position;
+            const f32 view_distance = glm::length(view_direction);
+            if (meshlet.m_cone_cutoff < 1.0f && view_distance > 0.0f && glm::dot(view_direction / view_distance, meshlet.m_cone_axis) >= meshlet.m_cone_cutoff)
+                continue;
+        }
+        ++statistics.m_visible_meshlets;
+        statistics.m_visible_triangles += meshlet.m_triangles_count;
+        const u32 indices_count = meshlet.m_triangles_count * 3;
+        if (!ranges.empty() &&
+            ranges.back().m_vertex_offset == vertex_offset &&
+            ranges.back().m_first_index + ranges.back().m_indices_count == meshlet.m_first_index)
+            ranges.back().m_indices_count += indices_count;
+        else
+            ranges.push_back(IndexRange{.m_first_index = meshlet.m_first_index, .m_indices_count = indices_count, .m_vertex_offset = vertex_offset});
+    }
+}
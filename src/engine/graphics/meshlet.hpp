@@ -0,0 +1,142 @@
+//
+//  meshlet.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _meshlet_hpp
+#define _meshlet_hpp
+
+#include "../../ftstd/result.hpp"
+#include "../platform.hpp"
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace frametech
+{
+    namespace graphics
+    {
+        struct Mesh;
+
+        /// @brief Maximum number of unique vertices referenced by a meshlet
+        constexpr u32 MESHLET_MAX_VERTICES = 64;
+        /// @brief Maximum number of triangles in a meshlet
+        constexpr u32 MESHLET_MAX_TRIANGLES = 124;
+        /// @brief Meshes with less triangles are not split in meshlets: culling them costs
+        /// more than drawing them
+        constexpr u64 MESHLET_MIN_MESH_TRIANGLES = 4 * MESHLET_MAX_TRIANGLES;
+
+        /// @brief A cluster of neighbour triangles of a Mesh object: a contiguous range of its indices,
+        /// with the bounds used to cull it on the CPU.
+        /// Stored as is in the binary mesh files.
+        struct Meshlet
+        {
+            /// @brief Center of the bounding sphere, in mesh space
+            glm::vec3 m_center;
+            /// @brief Radius of the bounding sphere
+            f32 m_radius;
+            /// @brief Apex of the normal cone: every triangle faces away from the points
+            /// seen from it inside the cone
+            glm::vec3 m_cone_apex;
+            /// @brief Sine of the half angle of the normal cone - 1 if the triangles face
+            /// too many directions to ever be all back-facing
+            f32 m_cone_cutoff;
+            /// @brief Axis of the normal cone (the average normal of the triangles)
+            glm::vec3 m_cone_axis;
+            /// @brief First index of the meshlet in the indices of the mesh
+            u32 m_first_index;
+            /// @brief Number of triangles (3 indices each)
+            u32 m_triangles_count;
+            /// @brief Number of unique vertices
+            u32 m_vertices_count;
+            u32 m_padding[2];
+        };
+        static_assert(sizeof(Meshlet) == 64, "the meshlets are stored in the binary mesh files");
+
+        /// @brief A range of indices to draw with a single vkCmdDrawIndexed
+        struct IndexRange
+        {
+            /// @brief First index of the range
+            u32 m_first_index;
+            /// @brief Number of indices
+            u32 m_indices_count;
+            /// @brief Added to the indices of the range - the first vertex of its submesh
+            i32 m_vertex_offset;
+        };
+
+        /// @brief The view of a frame, in the space of a mesh: what the culling tests against
+        struct CullingView
+        {
+            /// @brief Planes of the frustum (left, right, bottom, top, near, far), normals inwards
+            glm::vec4 m_planes[6];
+            /// @brief Position of the camera
+            glm::vec3 m_camera_position = glm::vec3(0.0f);
+            /// @brief False if the transformation is degenerate: everything is visible
+            bool m_can_cull = false;
+        };
+
+        /// @brief Result of the last meshlet culling, for the debug tools
+        struct MeshletCullingStatistics
+        {
+            /// @brief Number of meshlets tested
+            u32 m_meshlets = 0;
+            /// @brief Number of meshlets left to draw
+            u32 m_visible_meshlets = 0;
+            /// @brief Number of triangles of the drawn levels of detail
+            u64 m_triangles = 0;
+            /// @brief Number of triangles left to draw
+            u64 m_visible_triangles = 0;
+
+            /// @brief Returns the ratio of triangles not sent to the GPU, between 0 and 1
+            f32 getCulledTriangleRatio() const noexcept
+            {
+                return 0 == m_triangles ? 0.0f : 1.0f - static_cast<f32>(m_visible_triangles) / static_cast<f32>(m_triangles);
+            }
+        };
+
+        /// @brief Splits meshes in meshlets, and culls the meshlets on the CPU
+        class MeshletUtils
+        {
+        public:
+            /// @brief Splits the triangles of `mesh` (of its level of detail 0) in meshlets, in the order of
+            /// its indices: a meshlet ends once it would reference more than `max_vertices` vertices or hold
+            /// more than `max_triangles` triangles. The indices are not changed - run it after the index reorders, so that the
+            /// triangles next to each other in the indices are next to each other in space.
+            /// Only works on meshes stored in m_vertices / m_indices.
+            /// @param mesh The mesh to split - its meshlets are replaced
+            /// @param max_vertices The maximum number of unique vertices per meshlet
+            /// @param max_triangles The maximum number of triangles per meshlet
+            /// @return A VResult type
+            static ftstd::VResult buildMeshlets(frametech::graphics::Mesh& mesh,
+                                                const u32 max_vertices = MESHLET_MAX_VERTICES,
+                                                const u32 max_triangles = MESHLET_MAX_TRIANGLES) noexcept;
+            /// @brief Returns the view of a frame in mesh space, to cull the meshlets of the mesh
+            /// @param model The model matrix of the mesh
+            /// @param view The view matrix
+            /// @param projection The projection matrix
+            /// @return A CullingView object
+            static CullingView getCullingView(const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection) noexcept;
+            /// @brief Returns if the sphere, in mesh space, is at least partly in the view frustum
+            static bool isSphereVisible(const CullingView& culling_view, const glm::vec3& center, const f32 radius) noexcept;
+            /// @brief Appends to `ranges` the ranges of indices of the meshlets that can be visible: the
+            /// meshlets out of the view frustum, or whose triangles are all back-facing, are dropped.
+            /// The meshlets next to each other in the indices are merged in a single range.
+            /// @param culling_view The view of the frame, in mesh space
+            /// @param meshlets The meshlets to cull
+            /// @param meshlets_count The number of meshlets
+            /// @param vertex_offset The first vertex of the submesh of the meshlets
+            /// @param ranges The ranges of indices to draw
+            /// @param statistics The statistics of the culling, updated
+            static void cullMeshlets(const CullingView& culling_view,
+                                     const Meshlet* meshlets,
+                                     const u64 meshlets_count,
+                                     const i32 vertex_offset,
+                                     std::vector<IndexRange>& ranges,
+                                     MeshletCullingStatistics& statistics) noexcept;
+        };
+    } // namespace graphics
+} // namespace frametech
+
+#endif // _meshlet_hpp
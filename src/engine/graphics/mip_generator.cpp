@@ -0,0 +1,101 @@
+//
+//  mip_generator.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#include "mip_generator.hpp"
+#include "../../ftstd/debug_tools.h"
+#include <algorithm>
+#include <cstring>
+
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#include <stb/stb_image_resize.h>
+
+u32 frametech::engine::graphics::MipGenerator::getLevelsCount(const u32 width, const u32 height) noexcept
+{
+    u32 levels_count = 1;
+    for (u32 size = width > height ? width : height; size > 1; size >>= 1)
+        ++levels_count;
+    return levels_count;
+}
+
+u64 frametech::engine::graphics::MipGenerator::getChainSize(const std::vector<TextureMipLevel>& levels) noexcept
+{
+    if (levels.empty())
+        return 0;
+    return levels.back().m_offset + levels.back().m_size;
+}
+
+std::vector<frametech::engine::graphics::TextureMipLevel> frametech::engine::graphics::MipGenerator::getTexelLevels(
+    const u32 width,
+    const u32 height,
+    const u32 channels,
+    const u32 max_levels_count) noexcept
+{
+    const u32 levels_count = std::max<u32>(1, std::min(getLevelsCount(width, height), max_levels_count));
+    return getLevels(width, height, levels_count, [channels](const u32 level_width, const u32 level_height) {
+        return static_cast<u64>(level_width) * level_height * channels;
+    });
+}
+
+ftstd::VResult frametech::engine::graphics::MipGenerator::generate(
+    const unsigned char* pixels,
+    const u32 width,
+    const u32 height,
+    const u32 channels,
+    std::vector<unsigned char>& chain,
+    std::vector<TextureMipLevel>& levels,
+    const u32 max_levels_count,
+    const bool srgb) noexcept
+{
+    if (nullptr == pixels || 0 == width || 0 == height)
+        return ftstd::VResult::Error((char*)"no texels to generate the mip chain from");
+    levels = getTexelLevels(width, height, channels, max_levels_count);
+    chain.resize(getChainSize(levels));
+    return generate(pixels, channels, chain.data(), levels, srgb);
+}
+
+ftstd::VResult frametech::engine::graphics::MipGenerator::generate(
+    const unsigned char* pixels,
+    const u32 channels,
+    unsigned char* chain,
+    const std::vector<TextureMipLevel>& levels,
+    const bool srgb) noexcept
+{
+    if (nullptr == pixels || nullptr == chain || levels.empty())
+        return ftstd::VResult::Error((char*)"no texels to generate the mip chain from");
+    if (3 != channels && 4 != channels)
+        return ftstd::VResult::Error((char*)"only RGB and RGBA texels are supported to generate the mip chain");
+    if (pixels != chain)
+        memcpy(chain, pixels, levels[0].m_size);
+
+    const int alpha_channel = 4 == channels ? 3 : STBIR_ALPHA_CHANNEL_NONE;
+    for (size_t level = 1; level < levels.size(); ++level)
+    {
+        const TextureMipLevel& source = levels[level - 1];
+        const TextureMipLevel& destination = levels[level];
+        // Box filter: each texel is the average of the 2x2 texels above it
+        if (0 == stbir_resize_uint8_generic(chain + source.m_offset,
+                                            static_cast<int>(source.m_width),
+                                            static_cast<int>(source.m_height),
+                                            0,
+                                            chain + destination.m_offset,
+                                            static_cast<int>(destination.m_width),
+                                            static_cast<int>(destination.m_height),
+                                            0,
+                                            static_cast<int>(channels),
+                                            alpha_channel,
+                                            0,
+                                            STBIR_EDGE_CLAMP,
+                                            STBIR_FILTER_BOX,
+                                            srgb ? STBIR_COLORSPACE_SRGB : STBIR_COLORSPACE_LINEAR,
+                                            nullptr))
+        {
+            LogE("Cannot generate the mip level %zu (%ux%u)", level, destination.m_width, destination.m_height);
+            return ftstd::VResult::Error((char*)"failed to downsample a mip level");
+        }
+    }
+    return ftstd::VResult::Ok();
+}
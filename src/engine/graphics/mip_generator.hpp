@@ -0,0 +1,111 @@
+//
+//  mip_generator.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _mip_generator_hpp
+#define _mip_generator_hpp
+
+#include "../../ftstd/result.hpp"
+#include "../platform.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace frametech
+{
+    namespace engine
+    {
+        namespace graphics
+        {
+            /// @brief Position of one mip level in a buffer that holds the whole chain
+            struct TextureMipLevel
+            {
+                /// @brief Width of the level, in texels
+                u32 m_width;
+                /// @brief Height of the level, in texels
+                u32 m_height;
+                /// @brief Offset of the level, from the beginning of the chain
+                u64 m_offset;
+                /// @brief Size of the level, in bytes
+                u64 m_size;
+            };
+
+            /// @brief Generates the mip chain of decoded textures, with stb_image_resize
+            class MipGenerator
+            {
+            public:
+                /// @brief Alignment of each level in a chain - enough for any
+                /// bufferOffset of vkCmdCopyBufferToImage
+                static constexpr u64 MIP_LEVEL_ALIGNMENT = 16;
+
+                /// @brief Returns the number of levels of a full mip chain, down to 1x1
+                static u32 getLevelsCount(const u32 width, const u32 height) noexcept;
+                /// @brief Returns the layout of a chain of `levels_count` levels, where
+                /// each level takes `getLevelSize(width, height)` bytes
+                /// @return The levels, from the biggest to the smallest one
+                template <typename F>
+                static std::vector<TextureMipLevel> getLevels(const u32 width, const u32 height, const u32 levels_count, F&& getLevelSize)
+                {
+                    std::vector<TextureMipLevel> levels(levels_count);
+                    u64 offset = 0;
+                    for (u32 level = 0; level < levels_count; ++level)
+                    {
+                        const u32 level_width = width >> level > 0 ? width >> level : 1;
+                        const u32 level_height = height >> level > 0 ? height >> level : 1;
+                        levels[level] = TextureMipLevel{
+                            .m_width = level_width,
+                            .m_height = level_height,
+                            .m_offset = offset,
+                            .m_size = getLevelSize(level_width, level_height),
+                        };
+                        offset = (offset + levels[level].m_size + MIP_LEVEL_ALIGNMENT - 1) / MIP_LEVEL_ALIGNMENT * MIP_LEVEL_ALIGNMENT;
+                    }
+                    return levels;
+                }
+                /// @brief Returns the size of a whole chain, in bytes
+                static u64 getChainSize(const std::vector<TextureMipLevel>& levels) noexcept;
+                /// @brief Returns the layout of the mip chain `generate` builds from decoded texels
+                /// @param channels The number of bytes per texel
+                /// @param max_levels_count Stops the chain after this number of levels
+                /// @return The levels, from the biggest to the smallest one
+                static std::vector<TextureMipLevel> getTexelLevels(const u32 width, const u32 height, const u32 channels, const u32 max_levels_count = UINT32_MAX) noexcept;
+                /// @brief Builds the full mip chain of `pixels`, each level being downsampled
+                /// from the previous one. The alpha channel is filtered as is.
+                /// @param pixels The decoded texels of the first level, `channels` bytes per texel
+                /// @param width The width of the first level, in texels
+                /// @param height The height of the first level, in texels
+                /// @param channels The number of bytes per texel (3 or 4, the last one being the alpha)
+                /// @param chain The output chain - resized by the function
+                /// @param levels The output layout of `chain`
+                /// @param max_levels_count Stops the chain after this number of levels
+                /// @param srgb If the color channels are sRGB, to be filtered in linear space
+                /// @return A VResult type
+                static ftstd::VResult generate(
+                    const unsigned char* pixels,
+                    const u32 width,
+                    const u32 height,
+                    const u32 channels,
+                    std::vector<unsigned char>& chain,
+                    std::vector<TextureMipLevel>& levels,
+                    const u32 max_levels_count = UINT32_MAX,
+                    const bool srgb = true) noexcept;
+                /// @brief Like `generate`, in memory owned by the caller (e.g. a mapped staging buffer)
+                /// @param chain The output chain, of `getChainSize(levels)` bytes - the first level
+                /// is not copied if `pixels` is `chain`
+                /// @param levels The layout of `chain`, from `getTexelLevels`
+                /// @return A VResult type
+                static ftstd::VResult generate(
+                    const unsigned char* pixels,
+                    const u32 channels,
+                    unsigned char* chain,
+                    const std::vector<TextureMipLevel>& levels,
+                    const bool srgb = true) noexcept;
+            };
+        } // namespace graphics
+    } // namespace engine
+} // namespace frametech
+
+#endif // _mip_generator_hpp
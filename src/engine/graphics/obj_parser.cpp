@@ -0,0 +1,406 @@
+//
+//  obj_parser.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#include "obj_parser.hpp"
+#include "../../ftstd/debug_tools.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+using frametech::engine::graphics::shaders::Vertex;
+
+namespace
+{
+    /// @brief Index that is not set in a face corner (e.g. `f 1//2` has no texture coordinates)
+    constexpr i32 NO_INDEX = -1;
+
+    /// @brief A face corner, as written in the file (0-based, NO_INDEX if absent)
+    struct Corner
+    {
+        i32 m_position;
+        i32 m_texture_coordinates;
+        i32 m_normal;
+        bool operator==(const Corner& other) const noexcept
+        {
+            return m_position == other.m_position &&
+                   m_texture_coordinates == other.m_texture_coordinates &&
+                   m_normal == other.m_normal;
+        }
+    };
+
+    /// @brief Open addressing hash map from a face corner to the index of its vertex.
+    /// Grows by doubling, and never allocates per lookup.
+    class CornerMap
+    {
+    public:
+        explicit CornerMap(const size_t expected_size)
+        {
+            size_t capacity = 1024;
+            while (capacity < expected_size * 2)
+                capacity <<= 1;
+            m_slots.assign(capacity, EMPTY_SLOT);
+        }
+        /// @brief Returns the vertex index of `corner`, or inserts `new_index` and returns it.
+        /// Indices have to be inserted in order: 0, 1, 2...
+        u32 findOrInsert(const Corner& corner, const u32 new_index) noexcept
+        {
+            if ((m_corners.size() + 1) * 2 > m_slots.size())
+                grow();
+            size_t slot = hash(corner) & (m_slots.size() - 1);
+            while (EMPTY_SLOT != m_slots[slot])
+            {
+                if (m_corners[m_slots[slot]] == corner)
+                    return m_slots[slot];
+                slot = (slot + 1) & (m_slots.size() - 1);
+            }
+            m_slots[slot] = new_index;
+            m_corners.push_back(corner);
+            return new_index;
+        }
+        /// @brief Forgets the corners inserted, keeping the capacity. Costs O(corners inserted),
+        /// not O(capacity), so that it can be called for every group of a file.
+        void clear() noexcept
+        {
+            if (m_corners.size() * 4 >= m_slots.size())
+                std::fill(m_slots.begin(), m_slots.end(), EMPTY_SLOT);
+            else
+            {
+                // Only the slots in use: found before any is emptied, not to cut the probe sequences
+                std::vector<size_t> used_slots;
+                used_slots.reserve(m_corners.size());
+                for (u32 vertex_index = 0; vertex_index < m_corners.size(); ++vertex_index)
+                {
+                    size_t slot = hash(m_corners[vertex_index]) & (m_slots.size() - 1);
+                    while (vertex_index != m_slots[slot])
+                        slot = (slot + 1) & (m_slots.size() - 1);
+                    used_slots.push_back(slot);
+                }
+                for (const size_t slot : used_slots)
+                    m_slots[slot] = EMPTY_SLOT;
+            }
+            m_corners.clear();
+        }
+
+    private:
+        static constexpr u32 EMPTY_SLOT = UINT32_MAX;
+        /// @brief Vertex index per slot
+        std::vector<u32> m_slots;
+        /// @brief Corner per vertex index
+        std::vector<Corner> m_corners;
+
+        static size_t hash(const Corner& corner) noexcept
+        {
+            u64 h = static_cast<u32>(corner.m_position) * 0x9E3779B97F4A7C15ull;
+            h ^= static_cast<u32>(corner.m_texture_coordinates) * 0xC2B2AE3D27D4EB4Full + (h >> 29);
+            h ^= static_cast<u32>(corner.m_normal) * 0x165667B19E3779F9ull + (h >> 32);
+            return static_cast<size_t>(h ^ (h >> 31));
+        }
+        void grow() noexcept
+        {
+            std::vector<u32> slots(m_slots.size() * 2, EMPTY_SLOT);
+            for (u32 vertex_index = 0; vertex_index < m_corners.size(); ++vertex_index)
+            {
+                size_t slot = hash(m_corners[vertex_index]) & (slots.size() - 1);
+                while (EMPTY_SLOT != slots[slot])
+                    slot = (slot + 1) & (slots.size() - 1);
+                slots[slot] = vertex_index;
+            }
+            m_slots.swap(slots);
+        }
+    };
+
+    inline const char* skipSpaces(const char* it, const char* const end) noexcept
+    {
+        while (it < end && (' ' == *it || '\t' == *it))
+            ++it;
+        return it;
+    }
+
+    inline const char* skipLine(const char* it, const char* const end) noexcept
+    {
+        const void* end_of_line = memchr(it, '\n', static_cast<size_t>(end - it));
+        return nullptr == end_of_line ? end : static_cast<const char*>(end_of_line) + 1;
+    }
+
+    inline bool isEndOfStatement(const char* it, const char* const end) noexcept
+    {
+        return it >= end || '\n' == *it || '\r' == *it || '#' == *it;
+    }
+
+    /// @brief Parses a float after optional spaces.
+    /// Returns the position after the number, or `it` if no number has been read.
+    inline const char* parseFloat(const char* it, const char* const end, f32& value) noexcept
+    {
+        it = skipSpaces(it, end);
+        if (it < end && '+' == *it)
+            ++it;
+#if defined(__cpp_lib_to_chars)
+        const auto [next, error] = std::from_chars(it, end, value);
+        return std::errc() == error ? next : it;
+#else
+        // The standard library does not provide floating point from_chars yet
+        const char* const begin = it;
+        bool negative = false;
+        if (it < end && '-' == *it)
+        {
+            negative = true;
+            ++it;
+        }
+        f64 mantissa = 0.0;
+        i32 exponent = 0;
+        const char* const digits = it;
+        for (; it < end && *it >= '0' && *it <= '9'; ++it)
+            mantissa = mantissa * 10.0 + (*it - '0');
+        if (it < end && '.' == *it)
+        {
+            ++it;
+            for (; it < end && *it >= '0' && *it <= '9'; ++it, --exponent)
+                mantissa = mantissa * 10.0 + (*it - '0');
+        }
+        if (it == digits || (it == digits + 1 && '.' == *digits))
+            return begin;
+        if (it < end && ('e' == *it || 'E' == *it))
+        {
+            i32 written_exponent = 0;
+            const auto [next, error] = std::from_chars(it + 1 < end && '+' == it[1] ? it + 2 : it + 1, end, written_exponent);
+            if (std::errc() == error)
+            {
+                exponent += written_exponent;
+                it = next;
+            }
+        }
+        const f64 result = 0 == exponent ? mantissa : mantissa * std::pow(10.0, exponent);
+        value = static_cast<f32>(negative ? -result : result);
+        return it;
+#endif
+    }
+
+    /// @brief Parses a (signed) integer, without skipping spaces.
+    /// Returns the position after the number, or `it` if no number has been read.
+    inline const char* parseInteger(const char* it, const char* const end, i32& value) noexcept
+    {
+        const auto [next, error] = std::from_chars(it, end, value);
+        return std::errc() == error ? next : it;
+    }
+
+    /// @brief Returns the name that follows a statement keyword (o, g, usemtl), without the spaces around it
+    inline std::string parseName(const char* it, const char* const end) noexcept
+    {
+        it = skipSpaces(it, end);
+        const char* name_end = it;
+        while (!isEndOfStatement(name_end, end))
+            ++name_end;
+        while (name_end > it && (' ' == name_end[-1] || '\t' == name_end[-1]))
+            --name_end;
+        return std::string(it, static_cast<size_t>(name_end - it));
+    }
+
+    /// @brief Returns if the statement at `it` is `keyword`, followed by a space
+    inline bool isStatement(const char* it, const char* const end, const char* keyword, const size_t keyword_size) noexcept
+    {
+        return static_cast<size_t>(end - it) > keyword_size &&
+               0 == memcmp(it, keyword, keyword_size) &&
+               (' ' == it[keyword_size] || '\t' == it[keyword_size]);
+    }
+
+    /// @brief Converts a 1-based (or negative, relative) OBJ index to a 0-based index.
+    /// Returns false if the index points outside of the declared elements.
+    inline bool resolveIndex(const i32 obj_index, const size_t nb_elements, i32& index) noexcept
+    {
+        if (obj_index > 0 && static_cast<size_t>(obj_index) <= nb_elements)
+        {
+            index = obj_index - 1;
+            return true;
+        }
+        if (obj_index < 0 && static_cast<size_t>(-static_cast<i64>(obj_index)) <= nb_elements)
+        {
+            index = static_cast<i32>(static_cast<i64>(nb_elements) + obj_index);
+            return true;
+        }
+        return false;
+    }
+} // namespace
+
+ftstd::VResult frametech::graphics::ObjParser::parse(
+    const char* content,
+    const u64 content_size,
+    std::vector<Vertex>& vertices,
+    std::vector<u32>& indices,
+    std::vector<ObjGroup>* groups) noexcept
+{
+    if (nullptr == content || 0 == content_size)
+        return ftstd::VResult::Error((char*)"cannot parse an empty OBJ content");
+
+    const char* it = content;
+    const char* const end = content + content_size;
+
+    // Rough guesses, to avoid most of the reallocations on big files
+    const size_t expected_elements = static_cast<size_t>(content_size / 64);
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texture_coordinates;
+    std::vector<glm::vec3> normals;
+    positions.reserve(expected_elements);
+    texture_coordinates.reserve(expected_elements);
+    normals.reserve(expected_elements);
+
+    const size_t first_vertex = vertices.size();
+    vertices.reserve(first_vertex + expected_elements);
+    indices.reserve(indices.size() + expected_elements * 3);
+
+    CornerMap corners(expected_elements);
+    // First vertex of the corners map: restarts with each group, so that groups do not share vertices
+    size_t corners_first_vertex = first_vertex;
+    // Per new vertex: does it need a normal computed from its faces
+    std::vector<bool> computed_normals;
+    computed_normals.reserve(expected_elements);
+
+    ObjGroup group{.m_first_vertex = static_cast<u32>(first_vertex), .m_first_index = static_cast<u32>(indices.size())};
+    // Closes the current group, if it has faces, and starts a new one
+    const auto startGroup = [&]() {
+        if (nullptr == groups || indices.size() == group.m_first_index)
+            return;
+        group.m_vertices_count = static_cast<u32>(vertices.size() - group.m_first_vertex);
+        group.m_indices_count = static_cast<u32>(indices.size() - group.m_first_index);
+        groups->push_back(group);
+        group.m_first_vertex = static_cast<u32>(vertices.size());
+        group.m_first_index = static_cast<u32>(indices.size());
+        corners.clear();
+        corners_first_vertex = vertices.size();
+    };
+
+    u64 line_number = 0;
+    for (; it < end; it = skipLine(it, end))
+    {
+        ++line_number;
+        it = skipSpaces(it, end);
+        if (isEndOfStatement(it, end))
+            continue;
+        if ('v' == it[0] && it + 1 < end)
+        {
+            if (' ' == it[1] || '\t' == it[1])
+            {
+                glm::vec3 position(0.0f);
+                it = parseFloat(it + 1, end, position.x);
+                it = parseFloat(it, end, position.y);
+                it = parseFloat(it, end, position.z);
+                positions.push_back(position);
+            }
+            else if ('t' == it[1])
+            {
+                glm::vec2 coordinates(0.0f);
+                it = parseFloat(it + 2, end, coordinates.x);
+                it = parseFloat(it, end, coordinates.y);
+                texture_coordinates.push_back(coordinates);
+            }
+            else if ('n' == it[1])
+            {
+                glm::vec3 normal(0.0f);
+                it = parseFloat(it + 2, end, normal.x);
+                it = parseFloat(it, end, normal.y);
+                it = parseFloat(it, end, normal.z);
+                normals.push_back(normal);
+            }
+        }
+        else if (isStatement(it, end, "o", 1) || isStatement(it, end, "g", 1))
+        {
+            startGroup();
+            group.m_name = parseName(it + 1, end);
+        }
+        else if (isStatement(it, end, "usemtl", 6))
+        {
+            startGroup();
+            group.m_material = parseName(it + 6, end);
+        }
+        else if ('f' == it[0] && it + 1 < end && (' ' == it[1] || '\t' == it[1]))
+        {
+            ++it;
+            u32 face_vertices[3] = {0, 0, 0};
+            u32 nb_corners = 0;
+            while (true)
+            {
+                it = skipSpaces(it, end);
+                if (isEndOfStatement(it, end))
+                    break;
+                i32 obj_position = 0, obj_texture_coordinates = 0, obj_normal = 0;
+                const char* const corner_begin = it;
+                it = parseInteger(it, end, obj_position);
+                if (it < end && '/' == *it)
+                {
+                    it = parseInteger(it + 1, end, obj_texture_coordinates);
+                    if (it < end && '/' == *it)
+                        it = parseInteger(it + 1, end, obj_normal);
+                }
+                Corner corner{NO_INDEX, NO_INDEX, NO_INDEX};
+                if (it == corner_begin ||
+                    !resolveIndex(obj_position, positions.size(), corner.m_position) ||
+                    (0 != obj_texture_coordinates && !resolveIndex(obj_texture_coordinates, texture_coordinates.size(), corner.m_texture_coordinates)) ||
+                    (0 != obj_normal && !resolveIndex(obj_normal, normals.size(), corner.m_normal)))
+                {
+                    LogE("invalid face at line %llu of the OBJ content", line_number);
+                    return ftstd::VResult::Error((char*)"invalid face in OBJ content");
+                }
+
+                const u32 new_vertex_index = static_cast<u32>(vertices.size() - corners_first_vertex);
+                const u32 vertex_index = static_cast<u32>(corners_first_vertex) + corners.findOrInsert(corner, new_vertex_index);
+                if (vertex_index == corners_first_vertex + new_vertex_index)
+                {
+                    const glm::vec2 uv = NO_INDEX == corner.m_texture_coordinates ? glm::vec2(0.0f) : texture_coordinates[corner.m_texture_coordinates];
+                    vertices.push_back(Vertex{
+                        .m_position = positions[corner.m_position],
+                        .m_color = NO_INDEX == corner.m_normal ? glm::vec3(0.0f) : normals[corner.m_normal],
+                        // 1.0f - Y : OBJ files follow the OpenGL convention for V
+                        .m_texture_coordinates = glm::vec2(uv.x, 1.0f - uv.y),
+                    });
+                    computed_normals.push_back(NO_INDEX == corner.m_normal);
+                }
+
+                // Triangulate as a fan: (0, 1, 2), (0, 2, 3)...
+                if (nb_corners < 2)
+                {
+                    face_vertices[nb_corners] = vertex_index;
+                }
+                else
+                {
+                    face_vertices[2] = vertex_index;
+                    indices.push_back(face_vertices[0]);
+                    indices.push_back(face_vertices[1]);
+                    indices.push_back(face_vertices[2]);
+                    if (computed_normals[face_vertices[0] - first_vertex] ||
+                        computed_normals[face_vertices[1] - first_vertex] ||
+                        computed_normals[face_vertices[2] - first_vertex])
+                    {
+                        const glm::vec3 face_normal = glm::cross(
+                            vertices[face_vertices[1]].m_position - vertices[face_vertices[0]].m_position,
+                            vertices[face_vertices[2]].m_position - vertices[face_vertices[0]].m_position);
+                        for (const u32 face_vertex : face_vertices)
+                        {
+                            if (computed_normals[face_vertex - first_vertex])
+                                vertices[face_vertex].m_color += face_normal;
+                        }
+                    }
+                    face_vertices[1] = vertex_index;
+                }
+                ++nb_corners;
+            }
+        }
+    }
+
+    for (size_t vertex_index = first_vertex; vertex_index < vertices.size(); ++vertex_index)
+    {
+        if (!computed_normals[vertex_index - first_vertex])
+            continue;
+        glm::vec3& normal = vertices[vertex_index].m_color;
+        const f32 length = glm::length(normal);
+        normal = length > 0.0f ? normal / length : glm::vec3(0.0f, 0.0f, 1.0f);
+    }
+
+    if (vertices.size() == first_vertex)
+        return ftstd::VResult::Error((char*)"no face found in OBJ content");
+    startGroup();
+    return ftstd::VResult::Ok();
+}
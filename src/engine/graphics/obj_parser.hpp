@@ -0,0 +1,68 @@
+//
+//  obj_parser.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _obj_parser_hpp
+#define _obj_parser_hpp
+
+#include "../../ftstd/result.hpp"
+#include "../platform.hpp"
+#include "shaders.h"
+#include <string>
+#include <vector>
+
+namespace frametech
+{
+    namespace graphics
+    {
+        /// @brief A group of faces of an OBJ content, split by the o / g / usemtl statements
+        struct ObjGroup
+        {
+            /// @brief Name of the last object or group statement - empty if none
+            std::string m_name;
+            /// @brief Name of the last usemtl statement - empty if none
+            std::string m_material;
+            /// @brief First vertex of the group - its vertices are not shared with the other groups
+            u32 m_first_vertex;
+            /// @brief Number of vertices of the group
+            u32 m_vertices_count;
+            /// @brief First index of the group
+            u32 m_first_index;
+            /// @brief Number of indices of the group, 3 per triangle
+            u32 m_indices_count;
+        };
+
+        /// @brief Wavefront OBJ parser, working on a memory buffer (e.g. a mapped file).
+        /// Supports the v / vt / vn / f subset: polygonal faces are triangulated as
+        /// fans, and each unique v/vt/vn triplet becomes one vertex.
+        /// The o / g / usemtl statements split the faces in groups, on request.
+        /// Other statements (s, mtllib...) are ignored.
+        class ObjParser
+        {
+        public:
+            /// @brief Parses `content` and appends the result to `vertices` and `indices`.
+            /// The normal of the vertex lands in the color attribute, and the V coordinate
+            /// is flipped to follow the Vulkan convention - same output as objl::Loader.
+            /// Vertices without normal get the average normal of their faces.
+            /// @param content The OBJ text - does not need to be null-terminated
+            /// @param content_size The size of content, in bytes
+            /// @param vertices The output vertices
+            /// @param indices The output indices, 3 per triangle
+            /// @param groups If set, the output groups of faces (without the empty ones), in the
+            /// order of the file - the vertices are then split per group
+            /// @return A VResult type
+            static ftstd::VResult parse(
+                const char* content,
+                const u64 content_size,
+                std::vector<frametech::engine::graphics::shaders::Vertex>& vertices,
+                std::vector<u32>& indices,
+                std::vector<ObjGroup>* groups = nullptr) noexcept;
+        };
+    } // namespace graphics
+} // namespace frametech
+
+#endif // _obj_parser_hpp
@@ -0,0 +1,93 @@
+//
+//  offset_allocator.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#include "offset_allocator.hpp"
+#include <assert.h>
+
+void frametech::graphics::OffsetAllocator::reset(const u64 size) noexcept
+{
+    m_size = size;
+    m_used_size = 0;
+    m_free_ranges.clear();
+    m_free_ranges_by_size.clear();
+    if (size > 0)
+        insertFreeRange(0, size);
+}
+
+ftstd::Result<frametech::graphics::OffsetAllocation> frametech::graphics::OffsetAllocator::allocate(const u64 size, const u64 alignment) noexcept
+{
+    if (0 == size || 0 == alignment)
+        return ftstd::Result<OffsetAllocation>::Error((char*)"Cannot allocate an empty range");
+    // Smallest free range first - the next ones only if the alignment does not fit
+    for (auto candidate = m_free_ranges_by_size.lower_bound(size); candidate != m_free_ranges_by_size.end(); ++candidate)
+    {
+        const u64 range_offset = candidate->second;
+        const u64 range_size = candidate->first;
+        const u64 offset = (range_offset + alignment - 1) / alignment * alignment;
+        const u64 padding = offset - range_offset;
+        if (padding + size > range_size)
+            continue;
+        eraseFreeRange(m_free_ranges.find(range_offset));
+        // The padding and the end of the range stay free
+        if (padding > 0)
+            insertFreeRange(range_offset, padding);
+        if (padding + size < range_size)
+            insertFreeRange(offset + size, range_size - padding - size);
+        m_used_size += size;
+        return ftstd::Result<OffsetAllocation>::Ok(OffsetAllocation{.m_offset = offset, .m_size = size});
+    }
+    return ftstd::Result<OffsetAllocation>::Error((char*)"No free range fits");
+}
+
+void frametech::graphics::OffsetAllocator::free(const OffsetAllocation& allocation) noexcept
+{
+    if (0 == allocation.m_size)
+        return;
+    assert(allocation.m_offset + allocation.m_size <= m_size);
+    assert(m_used_size >= allocation.m_size);
+    m_used_size -= allocation.m_size;
+    u64 offset = allocation.m_offset;
+    u64 size = allocation.m_size;
+    // Merges with the free range that ends where the allocation starts...
+    if (auto next = m_free_ranges.lower_bound(offset); next != m_free_ranges.begin())
+    {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == offset)
+        {
+            offset = previous->first;
+            size += previous->second;
+            eraseFreeRange(previous);
+        }
+    }
+    // ... and with the one that starts where it ends
+    if (auto next = m_free_ranges.find(allocation.m_offset + allocation.m_size); next != m_free_ranges.end())
+    {
+        size += next->second;
+        eraseFreeRange(next);
+    }
+    insertFreeRange(offset, size);
+}
+
+void frametech::graphics::OffsetAllocator::insertFreeRange(const u64 offset, const u64 size) noexcept
+{
+    m_free_ranges.emplace(offset, size);
+    m_free_ranges_by_size.emplace(size, offset);
+}
+
+void frametech::graphics::OffsetAllocator::eraseFreeRange(std::map<u64, u64>::iterator range) noexcept
+{
+    const auto [first, last] = m_free_ranges_by_size.equal_range(range->second);
+    for (auto sized_range = first; sized_range != last; ++sized_range)
+    {
+        if (sized_range->second == range->first)
+        {
+            m_free_ranges_by_size.erase(sized_range);
+            break;
+        }
+    }
+    m_free_ranges.erase(range);
+}
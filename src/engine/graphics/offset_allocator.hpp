@@ -0,0 +1,70 @@
+//
+//  offset_allocator.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _offset_allocator_hpp
+#define _offset_allocator_hpp
+
+#include "../../ftstd/result.hpp"
+#include "../platform.hpp"
+#include <map>
+
+namespace frametech
+{
+    namespace graphics
+    {
+        /// @brief A range allocated by an OffsetAllocator
+        struct OffsetAllocation
+        {
+            /// @brief Offset of the range, in bytes
+            u64 m_offset = 0;
+            /// @brief Size of the range, in bytes - 0 if nothing is allocated
+            u64 m_size = 0;
+        };
+
+        /// @brief Sub-allocates ranges of a fixed size memory block (e.g. a buffer), without touching it:
+        /// the smallest free range that fits is picked, and the ranges freed are merged with their free
+        /// neighbours. Allocations and frees are in O(log(free ranges)).
+        /// Not thread safe.
+        class OffsetAllocator
+        {
+        public:
+            /// @brief Forgets all the allocations - the whole block of `size` bytes is free
+            void reset(const u64 size) noexcept;
+            /// @brief Allocates a range of `size` bytes
+            /// @param size The size of the range, in bytes
+            /// @param alignment The offset of the range is a multiple of it - not only a power of two
+            /// (e.g. the stride of vertices)
+            /// @return The range, or an error if no free range fits
+            ftstd::Result<OffsetAllocation> allocate(const u64 size, const u64 alignment = 1) noexcept;
+            /// @brief Frees a range returned by `allocate` - no-op for an empty range
+            void free(const OffsetAllocation& allocation) noexcept;
+            /// @brief Returns the size of the block, in bytes
+            u64 getSize() const noexcept { return m_size; }
+            /// @brief Returns the number of bytes allocated
+            u64 getUsedSize() const noexcept { return m_used_size; }
+            /// @brief Returns the size of the largest free range, in bytes
+            u64 getLargestFreeSize() const noexcept { return m_free_ranges_by_size.empty() ? 0 : m_free_ranges_by_size.rbegin()->first; }
+
+        private:
+            /// @brief Registers a free range
+            void insertFreeRange(const u64 offset, const u64 size) noexcept;
+            /// @brief Forgets a free range
+            void eraseFreeRange(std::map<u64, u64>::iterator range) noexcept;
+            /// @brief Size of the block, in bytes
+            u64 m_size = 0;
+            /// @brief Number of bytes allocated
+            u64 m_used_size = 0;
+            /// @brief The free ranges: size, by offset - to merge the neighbours
+            std::map<u64, u64> m_free_ranges;
+            /// @brief The free ranges: offset, by size - to find the smallest one that fits
+            std::multimap<u64, u64> m_free_ranges_by_size;
+        };
+    } // namespace graphics
+} // namespace frametech
+
+#endif // _offset_allocator_hpp
@@ -8,13 +8,18 @@
 #include "pipeline.hpp"
 #include "../../application.hpp" // To link getting the current world - to remove if refactoring
 #include "../../ftstd/debug_tools.h"
+#include "../../ftstd/mapped_file.hpp"
+#include "../../ftstd/profile_tools.h"
 #include "../engine.hpp"
 #include "../gameframework/world.hpp" // To link getting the current world - to remove if refactoring
+#include "geometry_pool.hpp"
 #include "memory.hpp"
+#include "upload_batch.hpp"
+#include <algorithm>
 #include <assert.h>
 #include <chrono>
 #include <filesystem>
-#include <fstream> // for readFile function(s)
+#include <memory>
 
 frametech::graphics::Pipeline::Pipeline()
 {
@@ -48,19 +53,15 @@ frametech::graphics::Pipeline::~Pipeline()
         vkDestroyPipelineLayout(graphics_device, m_layout, nullptr);
         m_layout = VK_NULL_HANDLE;
     }
-    if (VK_NULL_HANDLE != m_vertex_buffer)
+    if (auto& geometry_pool = frametech::Engine::getInstance()->m_geometry_pool; geometry_pool)
     {
-        Log("< Destroying the vertex buffer...");
-        vmaDestroyBuffer(resource_allocator, m_vertex_buffer, m_vertex_buffer_allocation);
-        m_vertex_buffer = VK_NULL_HANDLE;
-        m_vertex_buffer_allocation = VK_NULL_HANDLE;
-    }
-    if (VK_NULL_HANDLE != m_index_buffer)
-    {
-        Log("< Destroying the index buffer...");
-        vmaDestroyBuffer(resource_allocator, m_index_buffer, m_index_buffer_allocation);
-        m_index_buffer = VK_NULL_HANDLE;
-        m_index_buffer_allocation = VK_NULL_HANDLE;
+        Log("< Freeing the geometry of the mesh...");
+        geometry_pool->freeVertices(m_vertices);
+        geometry_pool->freeIndices(m_indices, m_index_type);
+        geometry_pool->freeDedicatedBuffer(m_dedicated_vertex_buffer, m_dedicated_vertex_buffer_allocation);
+        geometry_pool->freeDedicatedBuffer(m_dedicated_index_buffer, m_dedicated_index_buffer_allocation);
+        m_vertices = OffsetAllocation{};
+        m_indices = OffsetAllocation{};
     }
     if (VK_NULL_HANDLE != m_pipeline)
     {
@@ -117,68 +118,45 @@ frametech::graphics::Pipeline::~Pipeline()
     }
 }
 
-/// @brief Read the content of a file, located at `filepath`, and put the content of it
-/// in `buffer`.
-/// If `buffer_length` is greater than the real file size, there is a cap on the real file size.
-/// Returns the length that is read, or `nullopt` if an error happened.
-/// **Warning**: this function is **not** data-race conditons bullet-proof.
-static uint64_t readFile(const char* filepath, char** buffer, uint64_t buffer_length)
+/// @brief Maps the content of the file located at `filepath`.
+/// Returns nullptr if the file cannot be mapped, or is empty.
+static std::shared_ptr<ftstd::MappedFile> mapFile(const char* filepath)
 {
-    std::ifstream file(filepath, std::ifstream::binary | std::ifstream::ate);
-    assert(file);
-    if (!file)
-        return 0;
-    uint64_t length = std::filesystem::file_size(filepath);
-    if (0 == length)
-        return 0;
-
-    // do not read more than enough
-    length = buffer_length < length ? (int)buffer_length : length;
-
-    // read data as a block, close, and return
-    // the length of the file
-    file.seekg(0);
-    file.read(*buffer, length);
-    file.close();
-    return length;
+    auto mapped_file = std::make_shared<ftstd::MappedFile>();
+    if (mapped_file->open(filepath, ftstd::MappedFile::Access::WILL_NEED).IsError() || !mapped_file->isMapped())
+        return nullptr;
+    return mapped_file;
 }
 
 ftstd::Result<std::vector<frametech::graphics::Shader::Module>> frametech::graphics::Pipeline::createGraphicsApplication(const char* vertex_shader_filepath,
                                                                                                                          const char* fragment_shader_filepath)
 {
-    // Get the length
-    const auto vs_file_size = std::filesystem::file_size(vertex_shader_filepath);
-    assert(0 != vs_file_size);
-    const auto fs_file_size = std::filesystem::file_size(fragment_shader_filepath);
-    assert(0 != fs_file_size);
+    // Map the VS and the FS - the SPIR-V code is read from the mappings
+    const std::shared_ptr<ftstd::MappedFile> vs_file = mapFile(vertex_shader_filepath);
+    const std::shared_ptr<ftstd::MappedFile> fs_file = mapFile(fragment_shader_filepath);
     // If one of them are empty, fail
-    if (0 == vs_file_size || 0 == fs_file_size)
+    if (nullptr == vs_file || nullptr == fs_file)
     {
         LogE("< Cannot create the program");
         return ftstd::Result<std::vector<frametech::graphics::Shader::Module>>::Error((char*)"vertex or fragment shader is NULL");
     }
-
-    // Get the content of the VS
-    auto vs_buffer = new char[vs_file_size];
-    readFile(vertex_shader_filepath, &vs_buffer, vs_file_size);
-    Log("> For VS file '%s', read file ok (%d bytes)", vertex_shader_filepath, vs_file_size);
-    // Get the content of the FS
-    auto fs_buffer = new char[fs_file_size];
-    readFile(fragment_shader_filepath, &fs_buffer, fs_file_size);
-    Log("> For FS file '%s', read file ok (%d bytes)", fragment_shader_filepath, fs_file_size);
+    Log("> For VS file '%s', map file ok (%llu bytes)", vertex_shader_filepath, vs_file->size());
+    Log("> For FS file '%s', map file ok (%llu bytes)", fragment_shader_filepath, fs_file->size());
 
     std::vector<frametech::graphics::Shader::Module> shader_modules(
         {frametech::graphics::Shader::Module{
-             .m_code = fs_buffer,
-             .m_size = static_cast<u32>(fs_file_size),
+             .m_code = fs_file->data(),
+             .m_size = static_cast<u32>(fs_file->size()),
              .m_tag = (char*)fragment_shader_filepath,
              .m_type = frametech::graphics::Shader::Type::FRAGMENT_SHADER,
+             .m_source = fs_file,
          },
          frametech::graphics::Shader::Module{
-             .m_code = vs_buffer,
-             .m_size = static_cast<u32>(vs_file_size),
+             .m_code = vs_file->data(),
+             .m_size = static_cast<u32>(vs_file->size()),
              .m_tag = (char*)vertex_shader_filepath,
              .m_type = frametech::graphics::Shader::Type::VERTEX_SHADER,
+             .m_source = vs_file,
          }});
     return ftstd::Result<std::vector<frametech::graphics::Shader::Module>>::Ok(shader_modules);
 }
@@ -370,8 +348,8 @@ ftstd::VResult frametech::graphics::Pipeline::create()
         .pScissors = &scissor,
     };
 
-    const auto vertex_binding_description = frametech::engine::graphics::shaders::VertexUtils::getVertexBindingDescription();
-    const auto vertex_attribute_descriptions = frametech::engine::graphics::shaders::VertexUtils::getVertexAttributeDescriptions();
+    const auto vertex_binding_description = frametech::engine::graphics::shaders::VertexUtils::getVertexBindingDescription(0, m_vertex_layout);
+    const auto vertex_attribute_descriptions = frametech::engine::graphics::shaders::VertexUtils::getVertexAttributeDescriptions(m_vertex_layout);
 
     // Vertex data settings:
     // * bindings: spacing between data, and whether the data is per-vertex or per-instance,
@@ -479,151 +457,170 @@ ftstd::VResult frametech::graphics::Pipeline::create()
 
 ftstd::VResult frametech::graphics::Pipeline::createVertexBuffer() noexcept
 {
-    VmaAllocator resource_allocator = frametech::Engine::getInstance()->m_allocator;
-    if (VK_NULL_HANDLE != m_vertex_buffer)
-    {
-        Log("< Destroying the vertex buffer...");
-        vmaDestroyBuffer(resource_allocator, m_vertex_buffer, m_vertex_buffer_allocation);
-        m_vertex_buffer = VK_NULL_HANDLE;
-        m_vertex_buffer_allocation = VK_NULL_HANDLE;
-    }
-    VkQueue transfert_queue = frametech::Engine::getInstance()->m_graphics_device.getTransfertQueue();
+    frametech::graphics::GeometryPool* geometry_pool = frametech::Engine::getInstance()->m_geometry_pool.get();
+    // Released once the frame in flight, that may draw it, is done
+    geometry_pool->freeVertices(m_vertices);
+    geometry_pool->freeDedicatedBuffer(m_dedicated_vertex_buffer, m_dedicated_vertex_buffer_allocation);
+    m_vertices = OffsetAllocation{};
     VkCommandPool* transfert_command_pool = frametech::Engine::getInstance()->m_render->getTransfertCommand()->getPool();
-    const int buffer_size = static_cast<int>(sizeof(m_mesh.m_vertices[0]) * m_mesh.m_vertices.size());
+    const u64 vertex_stride = frametech::engine::graphics::shaders::VertexUtils::getVertexStride(m_vertex_layout);
+    const u64 buffer_size = vertex_stride * m_mesh.getVerticesCount();
     assert(buffer_size > 0);
     assert(transfert_command_pool != nullptr);
 
-    // Use staging buffer (or temporary buffer) to transfer next from CPU to GPU
-    // This buffer can be used as source in a memory transfer operation
-    VkBuffer staging_buffer{};
-    VmaAllocation staging_buffer_allocation{};
-    if (const auto result = frametech::graphics::Memory::initBuffer(
-            resource_allocator,
-            &staging_buffer_allocation,
-            buffer_size,
-            staging_buffer,
-            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
-        result.IsError())
-        return result;
-
-    // Now, fill the staging buffer with the actual data
-    void* data;
-    vmaMapMemory(resource_allocator, staging_buffer_allocation, &data);
-    memcpy(data, m_mesh.m_vertices.data(), (int)buffer_size);
-    vmaUnmapMemory(resource_allocator, staging_buffer_allocation);
-
-    // Initialize the actual vertex buffer
-    // This buffer can be used as destination in a memory transfert operation
-    if (m_vertex_buffer != VK_NULL_HANDLE)
+    // Quantize the vertices relatively to the bounds of the mesh, if needed
+    const frametech::engine::graphics::shaders::Vertex* vertices = m_mesh.getVertexData();
+    std::vector<frametech::engine::graphics::shaders::CompactVertex> compact_vertices;
+    m_vertex_dequantization = glm::mat4(1.0f);
+    glm::vec3 bounds_min = vertices[0].m_position;
+    glm::vec3 bounds_max = vertices[0].m_position;
+    glm::vec2 uvs_min = vertices[0].m_texture_coordinates;
+    glm::vec2 uvs_max = vertices[0].m_texture_coordinates;
+    for (u64 i = 1; i < m_mesh.getVerticesCount(); ++i)
     {
-        LogW("the vertex buffer has already been intialized - resetting it...");
-        vmaDestroyBuffer(resource_allocator, m_vertex_buffer, m_index_buffer_allocation);
-        m_index_buffer_allocation = VK_NULL_HANDLE;
+        bounds_min = glm::min(bounds_min, vertices[i].m_position);
+        bounds_max = glm::max(bounds_max, vertices[i].m_position);
+        uvs_min = glm::min(uvs_min, vertices[i].m_texture_coordinates);
+        uvs_max = glm::max(uvs_max, vertices[i].m_texture_coordinates);
+    }
+    m_has_uvs_in_unit_square = glm::all(glm::greaterThanEqual(uvs_min, glm::vec2(0.0f))) && glm::all(glm::lessThanEqual(uvs_max, glm::vec2(1.0f)));
+    const glm::vec3 bounds_extent = bounds_max - bounds_min;
+    // Without submeshes, the bounds of the whole mesh are the ones of its single submesh
+    const bool has_submeshes = !m_mesh.m_submeshes.empty() || 0 != m_mesh.m_source_submeshes_count;
+    m_submesh_bounding_spheres.clear();
+    for (u64 i = 0; i < m_mesh.getSubmeshesCount(); ++i)
+    {
+        const Submesh submesh = m_mesh.getSubmesh(i);
+        const glm::vec3 submesh_bounds_min = has_submeshes ? submesh.m_bounds_min : bounds_min;
+        const glm::vec3 submesh_bounds_max = has_submeshes ? submesh.m_bounds_max : bounds_max;
+        m_submesh_bounding_spheres.push_back(glm::vec4((submesh_bounds_min + submesh_bounds_max) * 0.5f,
+                                                       glm::length(submesh_bounds_max - submesh_bounds_min) * 0.5f));
+    }
+    if (m_vertex_layout == frametech::engine::graphics::shaders::VertexLayout::COMPACT)
+    {
+        compact_vertices.reserve(m_mesh.getVerticesCount());
+        for (u64 i = 0; i < m_mesh.getVerticesCount(); ++i)
+            compact_vertices.push_back(frametech::engine::graphics::shaders::VertexUtils::toCompactVertex(vertices[i], bounds_min, bounds_extent));
+        // position = bounds_min + quantized_position * bounds_extent
+        m_vertex_dequantization[0][0] = bounds_extent.x;
+        m_vertex_dequantization[1][1] = bounds_extent.y;
+        m_vertex_dequantization[2][2] = bounds_extent.z;
+        m_vertex_dequantization[3] = glm::vec4(bounds_min, 1.0f);
     }
-    m_vertex_buffer = VkBuffer();
-    if (const auto result = frametech::graphics::Memory::initBuffer(
-            resource_allocator,
-            &m_vertex_buffer_allocation,
-            buffer_size,
-            m_vertex_buffer,
-            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
-        result.IsError())
-        return result;
 
-    // Now, copy the data
-    if (const auto operation_result = frametech::graphics::Memory::copyBufferToBuffer(
-            staging_buffer,
-            0,
-            m_vertex_buffer,
-            0,
-            transfert_command_pool,
-            transfert_queue,
-            buffer_size);
-        operation_result.IsError())
+    // Allocate the range of the vertices in the vertex buffer of the pool - or a dedicated vertex
+    // buffer if the pool is full (e.g. a large mesh replaced while the previous one is still drawn)
+    if (auto vertices_range = geometry_pool->allocateVertices(m_mesh.getVerticesCount(), vertex_stride); !vertices_range.IsError())
     {
-        vmaDestroyBuffer(resource_allocator, staging_buffer, staging_buffer_allocation);
-        staging_buffer_allocation = VK_NULL_HANDLE;
-        return operation_result;
+        m_vertices = vertices_range.GetValue();
+        m_first_vertex = static_cast<i32>(m_vertices.m_offset / vertex_stride);
     }
+    else
+    {
+        if (const auto result = geometry_pool->createDedicatedBuffer(buffer_size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, m_dedicated_vertex_buffer, m_dedicated_vertex_buffer_allocation); result.IsError())
+            return ftstd::VResult::Error((char*)"Cannot allocate the vertices of the mesh");
+        m_first_vertex = 0;
+    }
+    const VkBuffer vertex_buffer = getVertexBuffer();
 
-    vmaDestroyBuffer(resource_allocator, staging_buffer, staging_buffer_allocation);
-    staging_buffer_allocation = VK_NULL_HANDLE;
+    // Now, copy the data through the staging ring, with one submission
+    const unsigned char* vertex_data = compact_vertices.empty() ? reinterpret_cast<const unsigned char*>(vertices)
+                                                                : reinterpret_cast<const unsigned char*>(compact_vertices.data());
+    frametech::graphics::UploadBatch upload_batch(*transfert_command_pool);
+    if (const auto result = upload_batch.begin(); result.IsError())
+        return result;
+    if (const auto result = upload_batch.uploadToBuffer(
+            vertex_buffer,
+            m_vertices.m_offset,
+            buffer_size,
+            [vertex_data](unsigned char* data, const u64 offset, const u64 size) {
+                memcpy(data, vertex_data + offset, size);
+            });
+        result.IsError())
+        return result;
+    upload_batch.releaseBuffer(vertex_buffer, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, true);
+    // Not waited for: the next draw waits for the upload (see acquireUploads)
+    if (const auto result = upload_batch.submit(); result.IsError())
+        return result;
 
     return ftstd::VResult::Ok();
 }
 
 ftstd::VResult frametech::graphics::Pipeline::createIndexBuffer() noexcept
 {
-    VmaAllocator resource_allocator = frametech::Engine::getInstance()->m_allocator;
-    if (VK_NULL_HANDLE != m_index_buffer)
-    {
-        Log("< Destroying the index buffer...");
-        vmaDestroyBuffer(resource_allocator, m_index_buffer, m_index_buffer_allocation);
-        m_index_buffer = VK_NULL_HANDLE;
-        m_index_buffer_allocation = VK_NULL_HANDLE;
-    }
-    VkQueue transfert_queue = frametech::Engine::getInstance()->m_graphics_device.getTransfertQueue();
+    frametech::graphics::GeometryPool* geometry_pool = frametech::Engine::getInstance()->m_geometry_pool.get();
+    // Released once the frame in flight, that may draw it, is done - in the pool of the previous index type
+    geometry_pool->freeIndices(m_indices, m_index_type);
+    geometry_pool->freeDedicatedBuffer(m_dedicated_index_buffer, m_dedicated_index_buffer_allocation);
+    m_indices = OffsetAllocation{};
     VkCommandPool* transfert_command_pool = frametech::Engine::getInstance()->m_render->getTransfertCommand()->getPool();
-    const int buffer_size = static_cast<int>(sizeof(m_mesh.m_indices[0]) * m_mesh.m_indices.size());
+    // 16 bits indices are enough to address less than 65536 vertices: the indices of each
+    // submesh start from 0, so only the largest submesh matters
+    u64 max_submesh_vertices_count = 0;
+    for (u64 i = 0; i < m_mesh.getSubmeshesCount(); ++i)
+        max_submesh_vertices_count = std::max<u64>(max_submesh_vertices_count, m_mesh.getSubmesh(i).m_vertices_count);
+    m_index_type = max_submesh_vertices_count <= UINT16_MAX + 1 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+    const u64 index_size = GeometryPool::getIndexSize(m_index_type);
+    const u64 buffer_size = index_size * m_mesh.getIndicesCount();
     assert(buffer_size > 0);
     assert(transfert_command_pool != nullptr);
 
-    // Use staging buffer (or temporary buffer) to transfer next from CPU to GPU
-    // This buffer can be used as source in a memory transfer operation
-    VkBuffer staging_buffer{};
-    VmaAllocation staging_buffer_allocation{};
-    if (const auto result = frametech::graphics::Memory::initBuffer(
-            resource_allocator,
-            &staging_buffer_allocation,
-            buffer_size,
-            staging_buffer,
-            VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
-        result.IsError())
-        return result;
-
-    // Now, fill the staging buffer with the actual data
-    void* data;
-    vmaMapMemory(resource_allocator, staging_buffer_allocation, &data);
-    memcpy(data, m_mesh.m_indices.data(), (int)buffer_size);
-    vmaUnmapMemory(resource_allocator, staging_buffer_allocation);
-
-    // Initialize the actual vertex buffer
-    // This buffer can be used as destination in a memory transfert operation
-    if (m_index_buffer != VK_NULL_HANDLE)
+    // Allocate the range of the indices in the index buffer of the pool, for this index type - or
+    // a dedicated index buffer if the pool is full
+    if (auto indices_range = geometry_pool->allocateIndices(m_mesh.getIndicesCount(), m_index_type); !indices_range.IsError())
+    {
+        m_indices = indices_range.GetValue();
+        m_first_index = static_cast<u32>(m_indices.m_offset / index_size);
+    }
+    else
     {
-        LogW("the index buffer has already been intialized - resetting it...");
-        vmaDestroyBuffer(resource_allocator, m_index_buffer, m_index_buffer_allocation);
-        m_index_buffer_allocation = VK_NULL_HANDLE;
+        if (const auto operation_result = geometry_pool->createDedicatedBuffer(buffer_size, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, m_dedicated_index_buffer, m_dedicated_index_buffer_allocation); operation_result.IsError())
+            return ftstd::VResult::Error((char*)"Cannot allocate the indices of the mesh");
+        m_first_index = 0;
     }
-    m_index_buffer = VkBuffer();
-    m_index_buffer_allocation = {};
-    if (const auto result = frametech::graphics::Memory::initBuffer(
-            resource_allocator,
-            &m_index_buffer_allocation,
+    const VkBuffer index_buffer = getIndexBuffer();
+
+    // Now, copy the data through the staging ring, with one submission - the indices are narrowed
+    // while written (the chunks of the ring are aligned, so never split an index)
+    const u32* indices = m_mesh.getIndexData();
+    const bool narrow_indices = m_index_type == VK_INDEX_TYPE_UINT16;
+    frametech::graphics::UploadBatch upload_batch(*transfert_command_pool);
+    if (const auto operation_result = upload_batch.begin(); operation_result.IsError())
+        return operation_result;
+    if (const auto operation_result = upload_batch.uploadToBuffer(
+            index_buffer,
+            m_indices.m_offset,
             buffer_size,
-            m_index_buffer,
-            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
-        result.IsError())
-        return result;
-
-    // Now, copy the data
-    if (const auto operation_result = frametech::graphics::Memory::copyBufferToBuffer(
-            staging_buffer,
-            0,
-            m_index_buffer,
-            0,
-            transfert_command_pool,
-            transfert_queue,
-            buffer_size);
+            [indices, narrow_indices](unsigned char* data, const u64 offset, const u64 size) {
+                if (narrow_indices)
+                {
+                    u16* narrowed_indices = reinterpret_cast<u16*>(data);
+                    const u64 first_index = offset / sizeof(u16);
+                    for (u64 i = 0; i < size / sizeof(u16); ++i)
+                        narrowed_indices[i] = static_cast<u16>(indices[first_index + i]);
+                }
+                else
+                    memcpy(data, reinterpret_cast<const unsigned char*>(indices) + offset, size);
+            });
         operation_result.IsError())
-    {
-        vmaDestroyBuffer(resource_allocator, staging_buffer, staging_buffer_allocation);
-        staging_buffer_allocation = VK_NULL_HANDLE;
         return operation_result;
-    }
+    upload_batch.releaseBuffer(index_buffer, VK_ACCESS_INDEX_READ_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, true);
+    // Not waited for: the next draw waits for the upload (see acquireUploads)
+    if (const auto operation_result = upload_batch.submit(); operation_result.IsError())
+        return operation_result;
 
-    vmaDestroyBuffer(resource_allocator, staging_buffer, staging_buffer_allocation);
-    staging_buffer_allocation = VK_NULL_HANDLE;
+    // The ranges culled for the previous mesh may be out of the new indices: draw
+    // the full submeshes until the next culling
+    m_submesh_lods.assign(m_mesh.getSubmeshesCount(), 0);
+    m_draw_ranges.clear();
+    for (u64 i = 0; i < m_mesh.getSubmeshesCount(); ++i)
+    {
+        const Submesh submesh = m_mesh.getSubmesh(i);
+        const MeshLod full_submesh = m_mesh.getLod(submesh, 0);
+        m_draw_ranges.push_back(IndexRange{.m_first_index = full_submesh.m_first_index,
+                                           .m_indices_count = full_submesh.m_indices_count,
+                                           .m_vertex_offset = submesh.m_vertex_offset});
+    }
 
     return ftstd::VResult::Ok();
 }
@@ -644,9 +641,10 @@ ftstd::VResult frametech::graphics::Pipeline::createUniformBuffers() noexcept
         if (frametech::graphics::Memory::initBuffer(
                 resource_allocator,
                 &m_uniform_buffers_allocation[i],
-                static_cast<int>(buffer_size),
+                buffer_size,
                 m_uniform_buffers[i],
-                VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+                VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                frametech::graphics::MemoryUsage::DYNAMIC)
                 .IsError())
         {
             LogE("<< UBO %d has not been created: cannot initialize the UBO buffer", i);
@@ -671,9 +669,85 @@ void frametech::graphics::Pipeline::updateUniformBuffer(const u32 current_frame_
         LogW("Cannot update uniform buffer: frame index is too high");
         return;
     }
+    mvp.model = mvp.model * m_vertex_dequantization;
     memcpy(m_uniform_buffers_data[current_frame_index], &mvp, sizeof(mvp));
 }
 
+void frametech::graphics::Pipeline::selectLod(const ModelViewProjection& mvp, const f32 viewport_height) noexcept
+{
+    const u64 submeshes_count = m_mesh.getSubmeshesCount();
+    m_submesh_lods.assign(submeshes_count, 0);
+    // The error of a level is a distance in mesh space: scaled to view space, then projected
+    // at the closest point of the bounding sphere of its submesh
+    const glm::mat4 model_view = mvp.view * mvp.model;
+    const f32 model_view_scale = std::max({glm::length(glm::vec3(model_view[0])), glm::length(glm::vec3(model_view[1])), glm::length(glm::vec3(model_view[2]))});
+    for (u64 i = 0; i < submeshes_count; ++i)
+    {
+        const Submesh submesh = m_mesh.getSubmesh(i);
+        const u64 lods_count = m_mesh.getLodsCount(submesh);
+        if (m_lod_override.has_value())
+        {
+            m_submesh_lods[i] = static_cast<u32>(std::min<u64>(m_lod_override.value(), lods_count - 1));
+            continue;
+        }
+        if (lods_count < 2 || i >= m_submesh_bounding_spheres.size())
+            continue;
+        const glm::vec4& bounding_sphere = m_submesh_bounding_spheres[i];
+        const glm::vec4 center = model_view * glm::vec4(glm::vec3(bounding_sphere), 1.0f);
+        if (center.w <= 0.0f)
+            continue;
+        const f32 scale = model_view_scale / center.w;
+        const f32 distance = glm::length(glm::vec3(center) / center.w) - bounding_sphere.w * scale;
+        if (distance <= 0.0f)
+            continue;
+        const f32 pixels_per_unit = mvp.projection[1][1] * viewport_height * 0.5f / distance;
+        for (u64 level = lods_count - 1; level > 0; --level)
+        {
+            if (m_mesh.getLod(submesh, level).m_error * scale * pixels_per_unit <= DEFAULT_LOD_PIXEL_ERROR)
+            {
+                m_submesh_lods[i] = static_cast<u32>(level);
+                break;
+            }
+        }
+    }
+}
+
+void frametech::graphics::Pipeline::cullMeshlets(const ModelViewProjection& mvp) noexcept
+{
+    ftstd::profile::ScopedProfileMarker scope((char*)"frametech::graphics::Pipeline::cullMeshlets");
+    // The bounds are in mesh space: the dequantization is not part of the transformation
+    const CullingView culling_view = MeshletUtils::getCullingView(mvp.model, mvp.view, mvp.projection);
+    const Meshlet* meshlets = m_mesh.getMeshletData();
+    m_draw_ranges.clear();
+    m_meshlet_culling_statistics = MeshletCullingStatistics{};
+    for (u64 i = 0; i < m_mesh.getSubmeshesCount(); ++i)
+    {
+        const Submesh submesh = m_mesh.getSubmesh(i);
+        const u32 lod_level = getLod(i);
+        const MeshLod lod = m_mesh.getLod(submesh, lod_level);
+        if (m_meshlet_culling && i < m_submesh_bounding_spheres.size() &&
+            !MeshletUtils::isSphereVisible(culling_view, glm::vec3(m_submesh_bounding_spheres[i]), m_submesh_bounding_spheres[i].w))
+        {
+            m_meshlet_culling_statistics.m_triangles += lod.m_indices_count / 3;
+            continue;
+        }
+        // The meshlets split the full submesh only
+        if (!m_meshlet_culling || 0 == submesh.m_meshlets_count || lod_level > 0)
+        {
+            m_draw_ranges.push_back(IndexRange{.m_first_index = lod.m_first_index, .m_indices_count = lod.m_indices_count, .m_vertex_offset = submesh.m_vertex_offset});
+            m_meshlet_culling_statistics.m_triangles += lod.m_indices_count / 3;
+            m_meshlet_culling_statistics.m_visible_triangles += lod.m_indices_count / 3;
+            continue;
+        }
+        MeshletUtils::cullMeshlets(culling_view,
+                                   meshlets + submesh.m_first_meshlet,
+                                   submesh.m_meshlets_count,
+                                   submesh.m_vertex_offset,
+                                   m_draw_ranges,
+                                   m_meshlet_culling_statistics);
+    }
+}
+
 VkPipeline frametech::graphics::Pipeline::getPipeline()
 {
     return m_pipeline;
@@ -825,20 +899,19 @@ void frametech::graphics::Pipeline::updateDescriptorSets(bool waitForDeviceIdleS
         // * application.hpp
         // * gameframework/world.hpp
 
-        const frametech::gameframework::World& c_world = frametech::Application::getInstance("")->getCurrentWorld();
-        const std::string texture_name = c_world.getSelectedTexture();
+        frametech::gameframework::World& c_world = frametech::Application::getInstance("")->getCurrentWorld();
         std::vector<VkDescriptorImageInfo> image_info_descriptors = std::vector<VkDescriptorImageInfo>(c_world.m_textures_cache.size());
 
-        for (const auto& [texture_tag, texture] : c_world.m_textures_cache)
+        // Only the selected texture is sampled: upload it if it is not resident
+        m_sampled_image = VK_NULL_HANDLE;
+        if (frametech::engine::graphics::Texture* texture = c_world.requestTexture(c_world.getSelectedTexture(), m_has_uvs_in_unit_square); nullptr != texture)
         {
-            if (texture_tag == texture_name)
-            {
-                VkDescriptorImageInfo image_info{};
-                image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-                image_info.imageView = texture->getImageView();
-                image_info.sampler = texture->getSampler();
-                image_info_descriptors.emplace_back(image_info);
-            }
+            m_sampled_image = texture->getImage();
+            VkDescriptorImageInfo image_info{};
+            image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            image_info.imageView = texture->getImageView();
+            image_info.sampler = texture->getSampler();
+            image_info_descriptors.emplace_back(image_info);
         }
 
         std::vector<VkWriteDescriptorSet> descriptor_sets = std::vector<VkWriteDescriptorSet>(image_info_descriptors.size() + 1);
@@ -880,6 +953,14 @@ void frametech::graphics::Pipeline::updateDescriptorSets(bool waitForDeviceIdleS
     }
 }
 
+void frametech::graphics::Pipeline::acquireUploads(VkCommandBuffer command_buffer) noexcept
+{
+    frametech::graphics::TransferQueue* transfer_queue = frametech::Engine::getInstance()->m_transfer_queue.get();
+    m_uploads_submission = std::max({transfer_queue->acquireBuffer(command_buffer, getVertexBuffer()),
+                                     transfer_queue->acquireBuffer(command_buffer, getIndexBuffer()),
+                                     transfer_queue->acquireImage(command_buffer, m_sampled_image)});
+}
+
 VkPipelineLayout frametech::graphics::Pipeline::getPipelineLayout() noexcept
 {
     return m_layout;
@@ -915,6 +996,8 @@ void frametech::graphics::Pipeline::acquireImage()
         frametech::Engine::getInstance()->m_graphics_device.getLogicalDevice(),
         1,
         m_sync_cpu_gpu);
+    // The previous frame is done: the geometry it may have drawn can be reused
+    frametech::Engine::getInstance()->m_geometry_pool->releaseFreed();
 
     // Acquire the new frame
     vkAcquireNextImageKHR(
@@ -955,13 +1038,23 @@ ftstd::Result<int> frametech::graphics::Pipeline::draw()
         0);
     // Record the current command
     frametech::Engine::getInstance()->m_render->getGraphicsCommand()->record();
-    // Submit
-    VkSemaphore wait_semaphores[] = {*m_sync_image_ready};
+    // Submit - waits for the uploads of the resources of the frame, if not done yet
+    VkSemaphore wait_semaphores[] = {*m_sync_image_ready, frametech::Engine::getInstance()->m_transfer_queue->getTimeline()};
     VkSemaphore signal_semaphores[] = {*m_sync_present_done};
-    VkPipelineStageFlags wait_stages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+    VkPipelineStageFlags wait_stages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                          VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT};
+    // The binary semaphores ignore their value
+    const u64 wait_values[] = {0, m_uploads_submission};
+    const VkTimelineSemaphoreSubmitInfo timeline_info{
+        .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+        .waitSemaphoreValueCount = 2,
+        .pWaitSemaphoreValues = wait_values,
+    };
+    const bool waits_uploads = 0 != m_uploads_submission;
     VkSubmitInfo submit_info{
         .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-        .waitSemaphoreCount = 1, // TODO: to change for something more idiomatic / maintainable
+        .pNext = waits_uploads ? &timeline_info : nullptr,
+        .waitSemaphoreCount = waits_uploads ? 2u : 1u, // TODO: to change for something more idiomatic / maintainable
         .pWaitSemaphores = wait_semaphores,
         .pWaitDstStageMask = wait_stages,
         .commandBufferCount = 1,
@@ -983,24 +1076,18 @@ ftstd::Result<int> frametech::graphics::Pipeline::draw()
     return ftstd::Result<int>::Ok(0);
 }
 
-const std::vector<frametech::engine::graphics::shaders::Vertex>& frametech::graphics::Pipeline::getVertices() noexcept
-{
-    return m_mesh.m_vertices;
-}
-
-const std::vector<u32>& frametech::graphics::Pipeline::getIndices() noexcept
-{
-    return m_mesh.m_indices;
-}
-
 const VkBuffer& frametech::graphics::Pipeline::getVertexBuffer() noexcept
 {
-    return m_vertex_buffer;
+    if (VK_NULL_HANDLE != m_dedicated_vertex_buffer)
+        return m_dedicated_vertex_buffer;
+    return frametech::Engine::getInstance()->m_geometry_pool->getVertexBuffer();
 }
 
 const VkBuffer& frametech::graphics::Pipeline::getIndexBuffer() noexcept
 {
-    return m_index_buffer;
+    if (VK_NULL_HANDLE != m_dedicated_index_buffer)
+        return m_dedicated_index_buffer;
+    return frametech::Engine::getInstance()->m_geometry_pool->getIndexBuffer(m_index_type);
 }
 
 const frametech::graphics::Mesh& frametech::graphics::Pipeline::getMesh() noexcept
@@ -1012,13 +1099,31 @@ void frametech::graphics::Pipeline::setMesh2D(frametech::graphics::Mesh2D new_me
 {
     // TODO : WTF ???
     if (new_mesh == frametech::graphics::Mesh2D::FROM_FILE) {
-        m_mesh = frametech::graphics::MeshUtils::loadFromFile((char*)"MODELS/viking_room.obj").GetValue();
+        m_mesh = frametech::graphics::MeshUtils::loadFromFile((char*)frametech::graphics::DEFAULT_MESH_FILE).GetValue();
+        m_mesh_path = frametech::graphics::DEFAULT_MESH_FILE;
     } else {
         m_mesh = frametech::graphics::MeshUtils::getMesh2D(new_mesh);
+        m_mesh_path.clear();
     }
     // Device fence
     vkDeviceWaitIdle(frametech::Engine::getInstance()->m_graphics_device.getLogicalDevice());
     // Force recreate the buffers
+    const bool had_uvs_in_unit_square = m_has_uvs_in_unit_square;
     createVertexBuffer();
     createIndexBuffer();
+    // A packed texture is sampled from its atlas page or on its own, depending on the UVs
+    if (had_uvs_in_unit_square != m_has_uvs_in_unit_square)
+        updateDescriptorSets(false);
+}
+
+ftstd::VResult frametech::graphics::Pipeline::replaceMesh(frametech::graphics::Mesh&& new_mesh, const std::string& source_path) noexcept
+{
+    if (0 == new_mesh.getVerticesCount() || 0 == new_mesh.getIndicesCount())
+        return ftstd::VResult::Error((char*)"Cannot render an empty mesh");
+    m_mesh = std::move(new_mesh);
+    m_mesh_path = source_path;
+    // The previous buffers are destroyed by the creation of the new ones
+    if (const auto result = createVertexBuffer(); result.IsError())
+        return result;
+    return createIndexBuffer();
 }
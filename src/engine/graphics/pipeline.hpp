@@ -9,13 +9,17 @@
 #ifndef pipeline_hpp
 #define pipeline_hpp
 
+#include "../../ftstd/mapped_file.hpp"
 #include "../../ftstd/result.hpp"
 #include "common.hpp"
 #include "mesh.hpp"
+#include "offset_allocator.hpp"
 #include "shaders.h"
 #include "transform.hpp"
 #include <cstdlib>
+#include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 #include <vk_mem_alloc.h>
 #include <vulkan/vulkan.h>
@@ -39,7 +43,7 @@ namespace frametech
             {
             public:
                 /// @brief The code of the SPIR-V shader.
-                char* m_code;
+                const char* m_code;
                 /// @brief The code size.
                 u32 m_size;
                 /// @brief The tag of the shader (e.g. its name / filepath).
@@ -49,6 +53,9 @@ namespace frametech
                 /// @brief The entrypoint of the shader program.
                 /// Default is 'main'
                 char* m_entrypoint = (char*)"main";
+                /// @brief The mapped file that holds m_code - keeps m_code valid
+                /// as long as the module is alive.
+                std::shared_ptr<ftstd::MappedFile> m_source = nullptr;
             };
         } // namespace Shader
         /// Graphics pipeline representation
@@ -90,25 +97,50 @@ namespace frametech
             /// @brief Returns the registered render pass object
             /// @return A VkRenderPass object
             VkRenderPass& getRenderPass();
-            /// @brief Returns the bounded vertices
-            /// @return The bounded vertices (may be an empty vector)
-            const std::vector<frametech::engine::graphics::shaders::Vertex>& getVertices() noexcept;
-            /// @brief Returns the vertices to draw, through their index
-            /// @return The indices of the vertices to draw (may be an empty vector)
-            const std::vector<u32>& getIndices() noexcept;
-            /// @brief Returns a reference to the current vertex buffer
+            /// @brief Returns a reference to the vertex buffer that stores the vertices of the mesh - the one of the
+            /// geometry pool, or a dedicated one if the mesh does not fit in the pool
             /// @return A reference to the current vertex buffer
             const VkBuffer& getVertexBuffer() noexcept;
-            /// @brief Returns a reference to the current index buffer
+            /// @brief Returns a reference to the index buffer that stores the indices of the mesh - the one of the
+            /// geometry pool, or a dedicated one if the mesh does not fit in the pool
             /// @return A reference to the current index buffer
             const VkBuffer& getIndexBuffer() noexcept;
+            /// @brief Returns the first vertex of the mesh in the vertex buffer - added to the
+            /// vertex offset of each draw
+            i32 getFirstVertex() const noexcept
+            {
+                return m_first_vertex;
+            }
+            /// @brief Returns the first index of the mesh in the index buffer - added to the
+            /// first index of each draw
+            u32 getFirstIndex() const noexcept
+            {
+                return m_first_index;
+            }
+            /// @brief Returns the type of the indices stored in the current index buffer
+            /// @return VK_INDEX_TYPE_UINT16 if the mesh has less than 65536 vertices,
+            /// VK_INDEX_TYPE_UINT32 otherwise
+            VkIndexType getIndexType() const noexcept
+            {
+                return m_index_type;
+            }
+            /// @brief Returns the layout of the vertices stored in the vertex buffer
+            /// @return A VertexLayout enum
+            frametech::engine::graphics::shaders::VertexLayout getVertexLayout() const noexcept
+            {
+                return m_vertex_layout;
+            }
             /// @brief Returns the pipeline of this object
             /// @return A VkPipeline object
             VkPipeline getPipeline();
-            /// @brief Creates a Vertex Buffer object to use for our shaders
+            /// @brief Uploads the vertices of the mesh to a range of the geometry pool of the engine,
+            /// and frees the previous one. The vertices are quantized on the fly if the pipeline uses
+            /// the compact layout.
             /// @return A VResult type to know if the function succeeded or not
             ftstd::VResult createVertexBuffer() noexcept;
-            /// @brief Creates an index buffer object to store the vertices to use to display our objects
+            /// @brief Uploads the indices of the mesh to a range of the geometry pool of the engine,
+            /// and frees the previous one. The indices are narrowed to 16 bits if the mesh has less
+            /// than 65536 vertices.
             /// @return A VResult type to know if the function succeeded or not
             ftstd::VResult createIndexBuffer() noexcept;
             /// @brief Creates the uniform buffers to use in our pipeline - should corresponds to the
@@ -120,6 +152,8 @@ namespace frametech
             /// This function should be call every frame to get the latest / current transformation.
             /// @param current_frame_index A uint32 value that represents the current frame index, in order
             /// to update **only** the right array value
+            /// @param mvp The transformation to send - the dequantization of the vertices
+            /// is appended to the model matrix here
             void updateUniformBuffer(const u32 current_frame_index, ModelViewProjection& mvp) noexcept;
             /// @brief Creates a descriptor set layout (data layout) to let the shaders
             /// access to any resource (buffer / image / ...)
@@ -138,6 +172,10 @@ namespace frametech
                 VkSampler* samplers = nullptr) noexcept;
             /// @brief Updates the registered descriptor sets
             void updateDescriptorSets(bool waitForDeviceIdleState = true) noexcept;
+            /// @brief Records in `command_buffer` the acquire of the buffers and of the texture used by the
+            /// frame, if they have been uploaded since the previous frames (see TransferQueue) - before the
+            /// render pass. The next `draw` waits for their upload.
+            void acquireUploads(VkCommandBuffer command_buffer) noexcept;
             /// @brief Creates the descriptor sets
             /// @return A VResult type to know if the function succeeded or not.
             ftstd::VResult createDescriptorSets() noexcept;
@@ -155,11 +193,30 @@ namespace frametech
             /// @brief Returns the Mesh object stored in the object
             /// @return A reference to the stored Mesh object
             const frametech::graphics::Mesh& getMesh() noexcept;
+            /// @brief Returns if the UVs of the mesh are all in [0, 1] - a mesh that repeats its
+            /// texture cannot sample a region of an atlas page
+            bool hasUVsInUnitSquare() const noexcept
+            {
+                return m_has_uvs_in_unit_square;
+            }
+            /// @brief Returns the full path of the file the mesh was loaded from - empty for the built-in meshes.
+            /// Not truncated, unlike the name of the mesh
+            const std::string& getMeshPath() const noexcept
+            {
+                return m_mesh_path;
+            }
             /// @brief Updates the Mesh object to render on screen
             /// WARNING: this function is absolutely not safe as it destroys
             /// the entire buffers before creating new ones...
             /// @param new_mesh a Mesh2D enum
             void setMesh2D(frametech::graphics::Mesh2D new_mesh) noexcept;
+            /// @brief Replaces the Mesh object to render, and recreates its buffers without
+            /// waiting for the device: must be called once the in-flight fence has been waited,
+            /// so that no submitted frame still reads the previous buffers
+            /// @param new_mesh The mesh to render
+            /// @param source_path The path of the file `new_mesh` was loaded from
+            /// @return A VResult type
+            ftstd::VResult replaceMesh(frametech::graphics::Mesh&& new_mesh, const std::string& source_path) noexcept;
             /// @brief Returns the selected transformation to apply to vertices
             /// @return A Transformation enum
             frametech::graphics::Transformation getTransform() noexcept
@@ -172,6 +229,53 @@ namespace frametech
             {
                 m_transform = new_transform;
             }
+            /// @brief Selects the level of detail of each submesh to draw: the coarsest one whose error,
+            /// projected on the screen, stays under DEFAULT_LOD_PIXEL_ERROR pixels
+            /// @param mvp The transformation of the frame
+            /// @param viewport_height The height of the viewport, in pixels
+            void selectLod(const ModelViewProjection& mvp, const f32 viewport_height) noexcept;
+            /// @brief Returns the level of detail of the submesh `submesh` drawn by the current frame
+            u32 getLod(const u64 submesh) const noexcept
+            {
+                return submesh < m_submesh_lods.size() ? m_submesh_lods[submesh] : 0;
+            }
+            /// @brief Forces the level of detail of every submesh to draw - std::nullopt to select it from the projected error
+            void setLodOverride(const std::optional<u32> lod) noexcept
+            {
+                m_lod_override = lod;
+            }
+            /// @brief Returns the forced level of detail, if any
+            std::optional<u32> getLodOverride() const noexcept
+            {
+                return m_lod_override;
+            }
+            /// @brief Culls the submeshes out of the view frustum, then the meshlets of the other ones
+            /// (see MeshletUtils::cullMeshlets) with the transformation of the frame, to build the
+            /// ranges of indices to draw. For a submesh without meshlets, with the culling disabled,
+            /// or with a coarser level of detail (see selectLod), the whole level is drawn.
+            /// Must be called before updateUniformBuffer, with the same transformation.
+            /// @param mvp The transformation of the frame
+            void cullMeshlets(const ModelViewProjection& mvp) noexcept;
+            /// @brief Returns the ranges of indices to draw - each one is a vkCmdDrawIndexed call
+            const std::vector<frametech::graphics::IndexRange>& getDrawRanges() const noexcept
+            {
+                return m_draw_ranges;
+            }
+            /// @brief Returns the result of the last meshlet culling, for the debug tools
+            const frametech::graphics::MeshletCullingStatistics& getMeshletCullingStatistics() const noexcept
+            {
+                return m_meshlet_culling_statistics;
+            }
+            /// @brief Returns if the meshlets are culled on the CPU
+            bool isMeshletCullingEnabled() const noexcept
+            {
+                return m_meshlet_culling;
+            }
+            /// @brief Enables or disables the culling of the meshlets on the CPU
+            void setMeshletCulling(const bool enabled) noexcept
+            {
+                m_meshlet_culling = enabled;
+            }
             /// @brief Performs the acquire image call
             void acquireImage();
             /// @brief Draw the current frame
@@ -202,14 +306,35 @@ namespace frametech
             VkRenderPass m_render_pass = VK_NULL_HANDLE;
             /// @brief The pipeline object
             VkPipeline m_pipeline = VK_NULL_HANDLE;
-            /// @brief The vertex buffer
-            VkBuffer m_vertex_buffer = VK_NULL_HANDLE;
-            /// @brief The vertex buffer allocation object
-            VmaAllocation m_vertex_buffer_allocation = {};
-            /// @brief The index buffer
-            VkBuffer m_index_buffer = VK_NULL_HANDLE;
-            /// @brief The index buffer allocation object
-            VmaAllocation m_index_buffer_allocation = {};
+            /// @brief The range of the vertices of the mesh in the vertex buffer of the geometry pool
+            OffsetAllocation m_vertices = {};
+            /// @brief The vertex buffer of the mesh, if it does not fit in the geometry pool
+            VkBuffer m_dedicated_vertex_buffer = VK_NULL_HANDLE;
+            /// @brief Allocation of m_dedicated_vertex_buffer
+            VmaAllocation m_dedicated_vertex_buffer_allocation = VK_NULL_HANDLE;
+            /// @brief First vertex of m_vertices - 0 in a dedicated vertex buffer
+            i32 m_first_vertex = 0;
+            /// @brief The range of the indices of the mesh in the index buffer of the geometry pool
+            OffsetAllocation m_indices = {};
+            /// @brief The index buffer of the mesh, if it does not fit in the geometry pool
+            VkBuffer m_dedicated_index_buffer = VK_NULL_HANDLE;
+            /// @brief Allocation of m_dedicated_index_buffer
+            VmaAllocation m_dedicated_index_buffer_allocation = VK_NULL_HANDLE;
+            /// @brief First index of m_indices - 0 in a dedicated index buffer
+            u32 m_first_index = 0;
+            /// @brief The type of the indices stored in the index buffer
+            VkIndexType m_index_type = VK_INDEX_TYPE_UINT32;
+            /// @brief The image sampled by the descriptor sets
+            VkImage m_sampled_image = VK_NULL_HANDLE;
+            /// @brief Value of the transfer timeline the next draw waits for - 0 if the resources
+            /// of the frame have been uploaded already
+            u64 m_uploads_submission = 0;
+            /// @brief The layout of the vertices stored in the vertex buffer - can only
+            /// be changed before the creation of the pipeline
+            frametech::engine::graphics::shaders::VertexLayout m_vertex_layout = frametech::engine::graphics::shaders::VertexLayout::COMPACT;
+            /// @brief Maps the quantized positions of the vertex buffer back to the
+            /// mesh space (identity for the standard layout)
+            glm::mat4 m_vertex_dequantization = glm::mat4(1.0f);
             /// @brief Uniform buffers
             std::vector<VkBuffer> m_uniform_buffers;
             /// @brief Memory addresses of the uniform buffers
@@ -219,8 +344,24 @@ namespace frametech
             std::vector<void*> m_uniform_buffers_data;
             /// @brief The default mesh to display
             frametech::graphics::Mesh m_mesh = frametech::graphics::MeshUtils::getMesh2D(frametech::graphics::Mesh2D::BASIC_TRIANGLE);
+            /// @brief The full path of the file m_mesh was loaded from - empty for the built-in meshes
+            std::string m_mesh_path;
+            /// @brief If the UVs of m_mesh are all in [0, 1]
+            bool m_has_uvs_in_unit_square = true;
             /// @brief The selected transformation
             frametech::graphics::Transformation m_transform = frametech::graphics::Transformation::Constant;
+            /// @brief The ranges of indices drawn by the current frame
+            std::vector<frametech::graphics::IndexRange> m_draw_ranges;
+            /// @brief The result of the last meshlet culling
+            frametech::graphics::MeshletCullingStatistics m_meshlet_culling_statistics;
+            /// @brief Culls the meshlets of the mesh on the CPU
+            bool m_meshlet_culling = true;
+            /// @brief The level of detail of each submesh drawn by the current frame
+            std::vector<u32> m_submesh_lods;
+            /// @brief The forced level of detail, if any
+            std::optional<u32> m_lod_override = std::nullopt;
+            /// @brief Bounding sphere of each submesh (center, radius), in mesh space
+            std::vector<glm::vec4> m_submesh_bounding_spheres;
             /// @brief Sync object to signal that an image is ready to
             /// be displayed
             VkSemaphore* m_sync_image_ready = nullptr;
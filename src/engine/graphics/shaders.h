@@ -9,8 +9,10 @@
 #ifndef shaders_h
 #define shaders_h
 
+#include "../platform.hpp"
 #include <array>
 #include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
 #include <objloader/objloader.h>
 #include <vulkan/vulkan.h>
 
@@ -60,6 +62,29 @@ namespace frametech
                     }
                 };
 
+                /// @brief The memory layout of the vertices, as read by the vertex shader
+                enum class VertexLayout
+                {
+                    /// @brief Full precision Vertex - 32 bytes per vertex
+                    STANDARD,
+                    /// @brief Quantized CompactVertex - 16 bytes per vertex
+                    COMPACT,
+                };
+
+                /// @brief Quantized version of Vertex, half of its size.
+                /// The position is relative to the bounds of the mesh: the dequantization
+                /// (bounds min + position * bounds extent) goes in the model matrix.
+                struct CompactVertex
+                {
+                    /// @brief Vertex position in the bounds of the mesh - UNORM 16 bits (XYZ, W unused)
+                    u16 m_position[4];
+                    /// @brief Vertex color, or normal - SNORM 8 bits (RGB, A unused)
+                    i8 m_color[4];
+                    /// @brief Texture UV - half floats (UV)
+                    u16 m_texture_coordinates[2];
+                };
+                static_assert(sizeof(CompactVertex) == 16, "CompactVertex should be 16 bytes long");
+
                 class VertexUtils
                 {
                 public:
@@ -67,21 +92,49 @@ namespace frametech
                     {
                         snprintf(str, 80, "Position: (%.2f,%.2f,%.2f)\nColor: (%d,%d,%d)", vertex.m_position.x, vertex.m_position.y, vertex.m_position.z, static_cast<int>(255.0 * vertex.m_color.r), static_cast<int>(255.0 * vertex.m_color.g), static_cast<int>(255.0 * vertex.m_color.b));
                     }
+                    /// @brief Returns the size of one vertex, in bytes, for the given layout
+                    /// @param layout The vertex layout
+                    /// @return The size of Vertex or CompactVertex
+                    [[maybe_unused]] static u32 getVertexStride(const VertexLayout layout) noexcept
+                    {
+                        return static_cast<u32>(layout == VertexLayout::COMPACT ? sizeof(CompactVertex) : sizeof(Vertex));
+                    }
+                    /// @brief Quantizes a vertex to the compact layout
+                    /// @param vertex The vertex to quantize
+                    /// @param bounds_min The minimum position of the mesh
+                    /// @param bounds_extent The size of the bounds of the mesh, on each axis
+                    /// @return A CompactVertex object
+                    [[maybe_unused]] static CompactVertex toCompactVertex(const Vertex& vertex, const glm::vec3& bounds_min, const glm::vec3& bounds_extent) noexcept
+                    {
+                        CompactVertex compact_vertex{};
+                        for (int axis = 0; axis < 3; ++axis)
+                        {
+                            // Flat axis: every vertex sits on the minimum
+                            const f32 relative = bounds_extent[axis] > 0.0f ? (vertex.m_position[axis] - bounds_min[axis]) / bounds_extent[axis] : 0.0f;
+                            compact_vertex.m_position[axis] = static_cast<u16>(glm::round(glm::clamp(relative, 0.0f, 1.0f) * 65535.0f));
+                            compact_vertex.m_color[axis] = static_cast<i8>(glm::round(glm::clamp(vertex.m_color[axis], -1.0f, 1.0f) * 127.0f));
+                        }
+                        compact_vertex.m_texture_coordinates[0] = glm::packHalf1x16(vertex.m_texture_coordinates.x);
+                        compact_vertex.m_texture_coordinates[1] = glm::packHalf1x16(vertex.m_texture_coordinates.y);
+                        return compact_vertex;
+                    }
                     /// @brief Returns the binding description of the Vertex structure
                     /// @param index_binding The binding index to set in the description data structure
+                    /// @param layout The vertex layout stored in the bound buffer
                     /// @return a VkVertexInputBindingDescription object
-                    [[maybe_unused]] static VkVertexInputBindingDescription getVertexBindingDescription(uint32_t index_binding = 0) noexcept
+                    [[maybe_unused]] static VkVertexInputBindingDescription getVertexBindingDescription(uint32_t index_binding = 0, const VertexLayout layout = VertexLayout::STANDARD) noexcept
                     {
                         VkVertexInputBindingDescription binding_description{
                             .binding = index_binding,                 // index of the binding in the overall array
-                            .stride = sizeof(Vertex),                 // specifies the number of bytes from one-entry to the next
+                            .stride = getVertexStride(layout),        // specifies the number of bytes from one-entry to the next
                             .inputRate = VK_VERTEX_INPUT_RATE_VERTEX, // move to the next data entry after each vertex
                         };
                         return binding_description;
                     }
                     /// @brief Returns an array of attribute descriptions of the Vertex structure
-                    /// @return an array of length 2: position and color of the shader (in this particular order)
-                    [[maybe_unused]] static std::array<VkVertexInputAttributeDescription, 3> getVertexAttributeDescriptions() noexcept
+                    /// @param layout The vertex layout stored in the bound buffer
+                    /// @return an array of length 3: position, color and UVs of the shader (in this particular order)
+                    [[maybe_unused]] static std::array<VkVertexInputAttributeDescription, 3> getVertexAttributeDescriptions(const VertexLayout layout = VertexLayout::STANDARD) noexcept
                     {
                         /* Attribute description type of data
                          * ----------------------------------
@@ -90,6 +143,29 @@ namespace frametech
                          * 2 : 2D UVs (XY)
                          * */
                         std::array<VkVertexInputAttributeDescription, 3> attribute_descriptions{};
+                        if (layout == VertexLayout::COMPACT)
+                        {
+                            // The shader still reads floats: the hardware converts each format
+                            attribute_descriptions[0] = VkVertexInputAttributeDescription{
+                                .location = 0,
+                                .binding = 0,
+                                .format = VK_FORMAT_R16G16B16A16_UNORM, // Position -> [0, 1] in the mesh bounds
+                                .offset = offsetof(CompactVertex, m_position),
+                            };
+                            attribute_descriptions[1] = VkVertexInputAttributeDescription{
+                                .location = 1,
+                                .binding = 0,
+                                .format = VK_FORMAT_R8G8B8A8_SNORM, // Color / normal -> [-1, 1]
+                                .offset = offsetof(CompactVertex, m_color),
+                            };
+                            attribute_descriptions[2] = VkVertexInputAttributeDescription{
+                                .location = 2,
+                                .binding = 0,
+                                .format = VK_FORMAT_R16G16_SFLOAT, // UV -> 2 half floats
+                                .offset = offsetof(CompactVertex, m_texture_coordinates),
+                            };
+                            return attribute_descriptions;
+                        }
                         // Vertices pos
                         attribute_descriptions[0] = VkVertexInputAttributeDescription{
                             .location = 0,
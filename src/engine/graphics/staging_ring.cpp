@@ -0,0 +1,60 @@
+//
+//  staging_ring.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#include "staging_ring.hpp"
+#include "../../ftstd/debug_tools.h"
+
+frametech::graphics::StagingRing::~StagingRing()
+{
+    destroy();
+}
+
+ftstd::VResult frametech::graphics::StagingRing::create(VmaAllocator resources_allocator, const u64 size) noexcept
+{
+    destroy();
+    if (size < 2 * STAGING_RING_ALIGNMENT)
+        return ftstd::VResult::Error((char*)"The staging ring is too small");
+    m_allocator = resources_allocator;
+    if (const auto result = Memory::initStagingBuffer(m_allocator, size / STAGING_RING_ALIGNMENT * STAGING_RING_ALIGNMENT, m_staging_buffer); result.IsError())
+        return result;
+    m_head = 0;
+    m_tail = 0;
+    Log("> Staging ring of %llu MB created", size >> 20);
+    return ftstd::VResult::Ok();
+}
+
+void frametech::graphics::StagingRing::destroy() noexcept
+{
+    if (VK_NULL_HANDLE == m_staging_buffer.m_buffer)
+        return;
+    Memory::destroyStagingBuffer(m_allocator, m_staging_buffer);
+    m_head = 0;
+    m_tail = 0;
+    Log("< Staging ring destroyed");
+}
+
+ftstd::Result<frametech::graphics::StagingRegion> frametech::graphics::StagingRing::allocate(const u64 size) noexcept
+{
+    if (0 == size || size > getMaxRegionSize())
+        return ftstd::Result<StagingRegion>::Error((char*)"The region does not fit in the staging ring");
+    const u64 ring_size = m_staging_buffer.m_size;
+    // The ring size is a multiple of the alignment: aligned positions are aligned offsets
+    u64 start = (m_head + STAGING_RING_ALIGNMENT - 1) / STAGING_RING_ALIGNMENT * STAGING_RING_ALIGNMENT;
+    // A region never wraps: the end of the ring is skipped
+    if (start % ring_size + size > ring_size)
+        start += ring_size - start % ring_size;
+    if (start + size - m_tail > ring_size)
+        return ftstd::Result<StagingRegion>::Error((char*)"The staging ring is full");
+    m_head = start + size;
+    const u64 offset = start % ring_size;
+    return ftstd::Result<StagingRegion>::Ok(StagingRegion{
+        .m_buffer = m_staging_buffer.m_buffer,
+        .m_offset = offset,
+        .m_data = m_staging_buffer.m_data + offset,
+        .m_size = size,
+    });
+}
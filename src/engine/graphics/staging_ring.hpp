@@ -0,0 +1,91 @@
+//
+//  staging_ring.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _staging_ring_hpp
+#define _staging_ring_hpp
+
+#include "../../ftstd/result.hpp"
+#include "../platform.hpp"
+#include "memory.hpp"
+#include <vk_mem_alloc.h>
+#include <vulkan/vulkan.h>
+
+namespace frametech
+{
+    namespace graphics
+    {
+        /// @brief A region of the staging ring, to write the data of a copy in
+        struct StagingRegion
+        {
+            /// @brief The buffer of the ring - source of the copy
+            VkBuffer m_buffer = VK_NULL_HANDLE;
+            /// @brief Offset of the region in m_buffer
+            u64 m_offset = 0;
+            /// @brief The mapped memory of the region
+            unsigned char* m_data = nullptr;
+            /// @brief Size of the region, in bytes
+            u64 m_size = 0;
+        };
+
+        /// @brief A staging buffer mapped once, shared by the uploads of the engine: each upload writes
+        /// its data in a region of the ring, and the region is released once the submission that
+        /// copies it is done (see TransferQueue). Uploads bigger than `getMaxRegionSize` are split in chunks.
+        /// Not thread safe: used by the thread that owns the transfer queue.
+        class StagingRing
+        {
+        public:
+            /// @brief Default size of the ring
+            static constexpr u64 DEFAULT_STAGING_RING_SIZE = 64ull * 1024 * 1024;
+            /// @brief Alignment of the regions - enough for the texel blocks, and for any
+            /// bufferOffset of vkCmdCopyBufferToImage
+            static constexpr u64 STAGING_RING_ALIGNMENT = 16;
+
+            StagingRing() = default;
+            ~StagingRing();
+            StagingRing(StagingRing const&) = delete;
+            StagingRing& operator=(StagingRing const&) = delete;
+
+            /// @brief Allocates and maps the ring
+            /// @param resources_allocator The allocator of the ring memory
+            /// @param size The size of the ring, in bytes
+            /// @return A VResult type
+            ftstd::VResult create(VmaAllocator resources_allocator, const u64 size = DEFAULT_STAGING_RING_SIZE) noexcept;
+            /// @brief Releases the ring - the copies from it must be done
+            void destroy() noexcept;
+            /// @brief Returns the biggest region that can be allocated - half the ring, so that
+            /// a chunk can always be written while the previous one is copied
+            u64 getMaxRegionSize() const noexcept { return m_staging_buffer.m_size / 2 / STAGING_RING_ALIGNMENT * STAGING_RING_ALIGNMENT; }
+            /// @brief Allocates a region of `size` bytes, if it fits in the free part of the ring
+            /// @param size The size of the region, at most `getMaxRegionSize()`
+            /// @return The region, or an error if it does not fit (yet)
+            ftstd::Result<StagingRegion> allocate(const u64 size) noexcept;
+            /// @brief Flushes the writes to `region` - no-op on host coherent memory
+            void flush(const StagingRegion& region) noexcept { vmaFlushAllocation(m_allocator, m_staging_buffer.m_allocation, region.m_offset, region.m_size); }
+            /// @brief Returns the position of the ring head: the regions allocated so far end before it
+            u64 getHead() const noexcept { return m_head; }
+            /// @brief Releases the regions that end before `head` (a previous value of `getHead()`)
+            void release(const u64 head) noexcept { m_tail = head; }
+            /// @brief Returns the size of the ring, in bytes
+            u64 getSize() const noexcept { return m_staging_buffer.m_size; }
+            /// @brief Returns the number of bytes in use (written, or not copied yet)
+            u64 getUsedSize() const noexcept { return m_head - m_tail; }
+
+        private:
+            /// @brief The allocator of the ring memory
+            VmaAllocator m_allocator = VK_NULL_HANDLE;
+            /// @brief The ring memory
+            StagingBuffer m_staging_buffer{};
+            /// @brief Total number of bytes allocated - the next region starts at m_head modulo the size
+            u64 m_head = 0;
+            /// @brief Total number of bytes released - the oldest region in use starts at m_tail modulo the size
+            u64 m_tail = 0;
+        };
+    } // namespace graphics
+} // namespace frametech
+
+#endif // _staging_ring_hpp
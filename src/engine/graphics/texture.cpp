@@ -8,18 +8,31 @@
 #include "texture.hpp"
 #include "debug_tools.h"
 #include "memory.hpp"
+#include "texture_file.hpp"
 #include "vma/vk_mem_alloc.h"
+#include "../../ftstd/hash.hpp"
 #include "../engine.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
 
+/// @brief Returns if the texels of `format` are sRGB encoded
+static bool isSrgbFormat(const VkFormat format)
+{
+    return VK_FORMAT_R8G8B8A8_SRGB == format || VK_FORMAT_B8G8R8A8_SRGB == format ||
+           VK_FORMAT_R8G8B8_SRGB == format || VK_FORMAT_B8G8R8_SRGB == format;
+}
+
 frametech::engine::graphics::Texture::Texture() : m_height(0), m_width(0), m_tag("Unknown") {}
 
 frametech::engine::graphics::Texture::~Texture()
 {
+    releaseData();
     const auto resource_allocator = frametech::Engine::getInstance()->m_allocator;
     const auto graphics_device = frametech::Engine::getInstance()->m_graphics_device.getLogicalDevice();
+    // The upload of the image can still be running on the transfer queue
+    if (auto& transfer_queue = frametech::Engine::getInstance()->m_transfer_queue; transfer_queue && VK_NULL_HANDLE != m_image)
+        transfer_queue->wait(transfer_queue->forgetImage(m_image));
     if (VK_NULL_HANDLE != m_image_view)
     {
         Log("< Destroying the image view object for tag %s...", m_tag.c_str());
@@ -57,7 +70,7 @@ ftstd::VResult frametech::engine::graphics::Texture::createImage(
             .height = static_cast<u32>(m_height),
             .depth = is_1D_texture ? static_cast<u32>(0) : static_cast<u32>(1), // FIXME !!! Big errors will happen for 3D textures - handle the depth via the image load function,
         },
-        .mipLevels = 1,
+        .mipLevels = m_mip_levels,
         .arrayLayers = 1,
         .samples = VK_SAMPLE_COUNT_1_BIT,  // Related to multisampling
         .tiling = VK_IMAGE_TILING_OPTIMAL, // TODO: switch maybe to Optimal in the future, or let the dev decides of it
@@ -79,6 +92,9 @@ ftstd::VResult frametech::engine::graphics::Texture::createImage(
     {
         return ftstd::VResult::Error((char*)"Failed to initialize memory for the image");
     }
+    VmaAllocationInfo allocation_info{};
+    vmaGetAllocationInfo(resource_allocator, m_staging_image_allocation, &allocation_info);
+    m_memory_size = allocation_info.size;
     return ftstd::VResult::Ok();
 }
 
@@ -96,7 +112,7 @@ ftstd::VResult frametech::engine::graphics::Texture::createImageView(
         .subresourceRange = {
             .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
             .baseMipLevel = 0,
-            .levelCount = 1,
+            .levelCount = m_mip_levels,
             .baseArrayLayer = 0,
             .layerCount = 1,
         }};
@@ -126,7 +142,7 @@ ftstd::VResult frametech::engine::graphics::Texture::createSampler() noexcept
         .compareEnable = VK_FALSE,
         .compareOp = VK_COMPARE_OP_ALWAYS,
         .minLod = 0.0f,
-        .maxLod = 0.0f,
+        .maxLod = static_cast<f32>(m_mip_levels), // The whole mip chain
         .borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK,
         .unnormalizedCoordinates = VK_FALSE,
     };
@@ -141,124 +157,450 @@ ftstd::VResult frametech::engine::graphics::Texture::createSampler() noexcept
     return ftstd::VResult::Ok();
 }
 
-ftstd::VResult frametech::engine::graphics::Texture::setup(
-    char* content,
+ftstd::VResult frametech::engine::graphics::Texture::decode(
+    const char* content,
     const int content_size,
-    const bool supports_alpha,
-    const frametech::engine::graphics::Texture::Type texture_type,
-    const VkFormat texture_format,
+    const TextureDecodeSettings& settings,
     const std::string& tag) noexcept
 {
-    const int req_comp = supports_alpha ? STBI_rgb_alpha : STBI_rgb;
-    m_supports_alpha = supports_alpha;
+    const int req_comp = settings.m_supports_alpha ? STBI_rgb_alpha : STBI_rgb;
+    m_supports_alpha = settings.m_supports_alpha;
     m_tag = tag;
 
-    unsigned char* image_data = NULL;
+    releaseData();
+    m_levels.clear();
 
-    // Load the data
-    if (image_data = stbi_load_from_memory((unsigned char*)content, content_size, &m_width, &m_height, &m_channels, req_comp); nullptr == image_data)
+    // Load the data - stb_image keeps no global state here, so this is thread safe
+    unsigned char* pixels = stbi_load_from_memory((const unsigned char*)content, content_size, &m_width, &m_height, &m_channels, req_comp);
+    if (nullptr == pixels)
     {
         LogE("Cannot load the texture with name '%s', should not happen", m_tag.c_str());
         return ftstd::VResult::Error((char*)"Error loading texture data");
     }
+    // The chain is generated straight in the staging memory it is uploaded from
+    m_levels = MipGenerator::getTexelLevels(static_cast<u32>(m_width), static_cast<u32>(m_height), static_cast<u32>(req_comp), settings.m_max_mip_levels);
+    auto result = frametech::graphics::Memory::initStagingBuffer(frametech::Engine::getInstance()->m_allocator, MipGenerator::getChainSize(m_levels), m_staging_buffer);
+    if (!result.IsError())
+        result = MipGenerator::generate(pixels, static_cast<u32>(req_comp), m_staging_buffer.m_data, m_levels, settings.m_srgb);
+    stbi_image_free(pixels);
+    if (result.IsError())
+    {
+        LogE("Cannot generate the mip chain of the texture with name '%s'", m_tag.c_str());
+        releaseData();
+        m_levels.clear();
+        return result;
+    }
+    m_mip_levels = static_cast<u32>(m_levels.size());
+    return ftstd::VResult::Ok();
+}
 
-    m_type = texture_type;
-    // Now, create the texture image & memory
-    VmaAllocator resource_allocator = frametech::Engine::getInstance()->m_allocator;
-    const int texture_size = getTextureSize();
-    // Use staging buffer (or temporary buffer) to transfer next from CPU to GPU
-    // This buffer can be used as source in a memory transfer operation
-    VkBuffer staging_buffer{};
-    VmaAllocation staging_buffer_allocation{};
-    if (const auto result = frametech::graphics::Memory::initBuffer(
-            resource_allocator,
-            &staging_buffer_allocation,
-            texture_size,
-            staging_buffer,
-            VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
-        result.IsError())
+ftstd::VResult frametech::engine::graphics::Texture::load(
+    const char* content,
+    const int content_size,
+    const TextureDecodeSettings& settings,
+    const std::string& tag) noexcept
+{
+    TextureCache* texture_cache = TextureCache::getInstance();
+    const u64 key = TextureCache::getKey(content, static_cast<u64>(content_size), settings);
+    const std::string cache_path = texture_cache->getPath(key);
+    if (texture_cache->find(key))
     {
-        LogE("Cannot initialize the buffer");
-        stbi_image_free(image_data);
+        if (!readTextureFile(cache_path.c_str(), tag).IsError())
+            return ftstd::VResult::Ok();
+        LogW("Invalid texture cache entry for the texture with name '%s'", tag.c_str());
+        texture_cache->remove(key);
+    }
+
+    if (const auto result = decode(content, content_size, settings, tag); result.IsError())
         return result;
+    // Keep the decoded texels if the compression fails: they can still be uploaded
+    if (settings.m_compress && compress().IsError())
+        return ftstd::VResult::Ok();
+    if (writeTextureFile(cache_path.c_str()).IsError())
+    {
+        LogW("Cannot cache the texture with name '%s'", m_tag.c_str());
+        return ftstd::VResult::Ok();
     }
+    texture_cache->insert(key);
+    return ftstd::VResult::Ok();
+}
 
-    // Now, fill the staging buffer with the actual data
-    void* data;
-    vmaMapMemory(resource_allocator, staging_buffer_allocation, &data);
-    memcpy(data, image_data, static_cast<int>(texture_size));
-    vmaUnmapMemory(resource_allocator, staging_buffer_allocation);
+ftstd::VResult frametech::engine::graphics::Texture::fromPixels(
+    const unsigned char* pixels,
+    const u32 width,
+    const u32 height,
+    const u32 max_mip_levels,
+    const bool has_alpha,
+    const std::string& tag) noexcept
+{
+    m_tag = tag;
+    m_width = static_cast<int>(width);
+    m_height = static_cast<int>(height);
+    m_supports_alpha = true;
+    m_channels = has_alpha ? 4 : 3;
+    releaseData();
+    m_levels = MipGenerator::getTexelLevels(width, height, 4, max_mip_levels);
+    auto result = frametech::graphics::Memory::initStagingBuffer(frametech::Engine::getInstance()->m_allocator, MipGenerator::getChainSize(m_levels), m_staging_buffer);
+    if (!result.IsError())
+        result = MipGenerator::generate(pixels, 4, m_staging_buffer.m_data, m_levels);
+    if (result.IsError())
+    {
+        LogE("Cannot generate the mip chain of the texture with name '%s'", m_tag.c_str());
+        releaseData();
+        m_levels.clear();
+        return result;
+    }
+    m_mip_levels = static_cast<u32>(m_levels.size());
+    return ftstd::VResult::Ok();
+}
 
-    // No need the raw data, as we mapped the data in VMA
-    stbi_image_free(image_data);
+bool frametech::engine::graphics::Texture::getImageSize(const char* content, const int content_size, int& width, int& height) noexcept
+{
+    int channels = 0;
+    return 0 != stbi_info_from_memory((const unsigned char*)content, content_size, &width, &height, &channels);
+}
 
-    if (const auto result = createImage(texture_type, texture_format, resource_allocator); result.IsError())
+ftstd::VResult frametech::engine::graphics::Texture::compress() noexcept
+{
+    if (nullptr == getPixels())
+        return ftstd::VResult::Error((char*)"No texture data to compress");
+    // Alpha blocks are twice bigger: only use them if the source has an alpha channel
+    const TextureBlockFormat block_format = hasAlpha() ? TextureBlockFormat::BC3 : TextureBlockFormat::BC1;
+    std::vector<TextureMipLevel> block_levels = TextureCompressor::getLevels(m_levels[0].m_width, m_levels[0].m_height, static_cast<u32>(m_levels.size()), block_format);
+    VmaAllocator resource_allocator = frametech::Engine::getInstance()->m_allocator;
+    frametech::graphics::StagingBuffer blocks{};
+    auto result = frametech::graphics::Memory::initStagingBuffer(resource_allocator, MipGenerator::getChainSize(block_levels), blocks);
+    if (!result.IsError())
+        result = TextureCompressor::compress(getPixels(), m_levels, m_supports_alpha ? 4 : 3, block_format, blocks.m_data, block_levels);
+    if (result.IsError())
     {
-        LogE("Failed to initialize memory for the image %s", tag.c_str());
-        vmaDestroyBuffer(resource_allocator, staging_buffer, staging_buffer_allocation);
+        LogE("Cannot compress the texture with name '%s'", m_tag.c_str());
+        frametech::graphics::Memory::destroyStagingBuffer(resource_allocator, blocks);
         return result;
     }
+    // The blocks replace the texels in the staging memory
+    releaseData();
+    m_staging_buffer = blocks;
+    m_block_format = block_format;
+    m_block_data = m_staging_buffer.m_data;
+    m_block_data_size = m_staging_buffer.m_size;
+    m_levels = std::move(block_levels);
+    return ftstd::VResult::Ok();
+}
 
-    if (const auto result = createImageView(texture_type, texture_format); result.IsError())
+ftstd::VResult frametech::engine::graphics::Texture::compressCached() noexcept
+{
+    if (nullptr == getPixels())
+        return ftstd::VResult::Error((char*)"No texture data to compress");
+    const TextureDecodeSettings settings{
+        .m_supports_alpha = m_supports_alpha,
+        .m_srgb = true,
+        .m_compress = true,
+        .m_max_mip_levels = m_mip_levels,
+    };
+    TextureCache* texture_cache = TextureCache::getInstance();
+    // The other levels are generated from the first one - whose bytes do not give its size
+    const u32 extent[] = {static_cast<u32>(m_width), static_cast<u32>(m_height)};
+    const u64 key = ftstd::hash::xxh64(extent, sizeof(extent), TextureCache::getKey(getPixels(), m_levels[0].m_size, settings));
+    const std::string cache_path = texture_cache->getPath(key);
+    if (texture_cache->find(key))
     {
-        LogE("Failed to initialize memory for the image view %s", tag.c_str());
-        vmaDestroyBuffer(resource_allocator, staging_buffer, staging_buffer_allocation);
+        if (!readTextureFile(cache_path.c_str(), m_tag).IsError())
+            return ftstd::VResult::Ok();
+        texture_cache->remove(key);
+    }
+    if (const auto result = compress(); result.IsError())
         return result;
+    if (writeTextureFile(cache_path.c_str()).IsError())
+    {
+        LogW("Cannot cache the texture with name '%s'", m_tag.c_str());
+        return ftstd::VResult::Ok();
     }
+    texture_cache->insert(key);
+    return ftstd::VResult::Ok();
+}
 
-    if (const auto result = createSampler(); result.IsError())
+ftstd::VResult frametech::engine::graphics::Texture::readTextureFile(const char* path, const std::string& tag) noexcept
+{
+    std::shared_ptr<ftstd::MappedFile> texture_file = nullptr;
+    TextureFileHeader header{};
+    if (const auto result = TextureFile::read(path, texture_file, header); result.IsError())
+        return result;
+    m_tag = tag;
+    releaseData();
+    const auto format = static_cast<TextureFileFormat>(header.m_format);
+    m_width = static_cast<int>(header.m_width);
+    m_height = static_cast<int>(header.m_height);
+    m_channels = static_cast<int>(header.m_channels);
+    m_supports_alpha = TextureFileFormat::BC3 == format || TextureFileFormat::RGBA8 == format;
+    m_mip_levels = header.m_mip_levels;
+    m_levels = TextureFile::getLevels(format, header.m_width, header.m_height, header.m_mip_levels);
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(texture_file->data() + header.m_data_offset);
+    if (TextureFileFormat::RGB8 == format || TextureFileFormat::RGBA8 == format)
     {
-        vmaDestroyBuffer(resource_allocator, staging_buffer, staging_buffer_allocation);
+        // Copied once, in the staging memory they are uploaded from
+        if (const auto result = frametech::graphics::Memory::initStagingBuffer(frametech::Engine::getInstance()->m_allocator, header.m_data_size, m_staging_buffer); result.IsError())
+            return result;
+        memcpy(m_staging_buffer.m_data, data, header.m_data_size);
+        return ftstd::VResult::Ok();
+    }
+    // The blocks stay in the mapping until they are uploaded
+    m_block_format = static_cast<TextureBlockFormat>(format);
+    m_blocks_source = texture_file;
+    m_block_data = data;
+    m_block_data_size = header.m_data_size;
+    return ftstd::VResult::Ok();
+}
+
+ftstd::VResult frametech::engine::graphics::Texture::writeTextureFile(const char* path) const noexcept
+{
+    if (isCompressed())
+        return TextureFile::write(path,
+                                  static_cast<TextureFileFormat>(m_block_format),
+                                  static_cast<u32>(m_width),
+                                  static_cast<u32>(m_height),
+                                  static_cast<u32>(m_channels),
+                                  m_mip_levels,
+                                  m_block_data,
+                                  m_block_data_size);
+    if (nullptr == getPixels())
+        return ftstd::VResult::Error((char*)"No texture data to write");
+    return TextureFile::write(path,
+                              m_supports_alpha ? TextureFileFormat::RGBA8 : TextureFileFormat::RGB8,
+                              static_cast<u32>(m_width),
+                              static_cast<u32>(m_height),
+                              static_cast<u32>(m_channels),
+                              m_mip_levels,
+                              getPixels(),
+                              m_staging_buffer.m_size);
+}
+
+void frametech::engine::graphics::Texture::releaseData() noexcept
+{
+    m_blocks_source = nullptr;
+    m_block_data = nullptr;
+    m_block_data_size = 0;
+    if (nullptr != m_staging_buffer.m_data)
+        frametech::graphics::Memory::destroyStagingBuffer(frametech::Engine::getInstance()->m_allocator, m_staging_buffer);
+}
+
+ftstd::VResult frametech::engine::graphics::Texture::setup(
+    char* content,
+    const int content_size,
+    const bool supports_alpha,
+    const frametech::engine::graphics::Texture::Type texture_type,
+    const VkFormat texture_format,
+    const std::string& tag) noexcept
+{
+    const TextureDecodeSettings settings{
+        .m_supports_alpha = supports_alpha,
+        .m_srgb = isSrgbFormat(texture_format),
+        .m_compress = frametech::Engine::getInstance()->m_graphics_device.supportsTextureCompressionBC(),
+    };
+    if (const auto result = load(content, content_size, settings, tag); result.IsError())
+        return result;
+    return upload(texture_type, texture_format);
+}
+
+ftstd::VResult frametech::engine::graphics::Texture::upload(
+    const frametech::engine::graphics::Texture::Type texture_type,
+    const VkFormat texture_format) noexcept
+{
+    VkCommandPool* transfert_command_pool = frametech::Engine::getInstance()->m_render->getTransfertCommand()->getPool();
+    frametech::graphics::UploadBatch upload_batch(*transfert_command_pool);
+    if (const auto result = upload_batch.begin(); result.IsError())
+    {
+        releaseData();
         return result;
     }
+    if (const auto result = upload(upload_batch, texture_type, texture_format); result.IsError())
+        return result;
+    // Not waited for: the graphics queue waits for the upload before sampling the image
+    return upload_batch.submit();
+}
 
-    // Transition - TOO COMPLEX, REDUCE COMPLEXITY OF TRANSITIONING HERE
-    VkQueue transfert_queue = frametech::Engine::getInstance()->m_graphics_device.getTransfertQueue();
-    auto transfert_command_buffer = frametech::Engine::getInstance()->m_render->getTransfertCommand();
-    VkCommandPool* transfert_command_pool = transfert_command_buffer->getPool();
+ftstd::VResult frametech::engine::graphics::Texture::upload(
+    frametech::graphics::UploadBatch& upload_batch,
+    const frametech::engine::graphics::Texture::Type texture_type,
+    const VkFormat texture_format) noexcept
+{
+    if (nullptr == getPixels() && !isCompressed())
+    {
+        LogE("Cannot upload the texture with name '%s': no decoded data", m_tag.c_str());
+        return ftstd::VResult::Error((char*)"No texture data to upload");
+    }
+    if (isCompressed() && !frametech::Engine::getInstance()->m_graphics_device.supportsTextureCompressionBC())
+    {
+        LogE("Cannot upload the texture with name '%s': the device does not support BC formats", m_tag.c_str());
+        releaseData();
+        return ftstd::VResult::Error((char*)"Compressed textures are not supported by the device");
+    }
+    // Compressed blocks win over the decoded texels
+    const VkFormat image_format = isCompressed() ? TextureCompressor::getVulkanFormat(m_block_format) : texture_format;
+    // The blocks mapped from a texture file are copied through the staging ring
+    const bool copy_from_ring = nullptr == m_staging_buffer.m_data;
+    // One copy region per mip level
+    std::vector<VkBufferImageCopy> copy_regions(m_levels.size());
+    for (u32 level = 0; level < m_levels.size(); ++level)
+    {
+        copy_regions[level] = VkBufferImageCopy{
+            .bufferOffset = m_levels[level].m_offset,
+            .bufferRowLength = 0,
+            .bufferImageHeight = 0,
+            .imageSubresource = {
+                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                .mipLevel = level,
+                .baseArrayLayer = 0,
+                .layerCount = 1,
+            },
+            .imageOffset = {0, 0, 0},
+            .imageExtent = {.width = m_levels[level].m_width, .height = m_levels[level].m_height, .depth = 1},
+        };
+    }
 
-    const u32 transfert_queue_family_index = transfert_command_buffer->m_queue_family_index_created_with;
+    m_type = texture_type;
+    // Now, create the texture image & memory
+    VmaAllocator resource_allocator = frametech::Engine::getInstance()->m_allocator;
+    // The texels and the compressed blocks have been written in their staging buffer already
+    if (!copy_from_ring)
+    {
+        m_levels.clear();
+        // No-op on host coherent memory
+        vmaFlushAllocation(resource_allocator, m_staging_buffer.m_allocation, 0, VK_WHOLE_SIZE);
+    }
 
+    if (const auto result = createImage(texture_type, image_format, resource_allocator); result.IsError())
     {
-        frametech::graphics::Command command_buffer(*transfert_command_pool);
-        command_buffer.createBuffer();
-        command_buffer.begin();
-        command_buffer.transition(
-            m_image,
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, // New
-            VK_IMAGE_LAYOUT_UNDEFINED,            // Old
-            transfert_queue_family_index,
-            transfert_queue_family_index);
-        command_buffer.end(transfert_queue, 1);
+        LogE("Failed to initialize memory for the image %s", m_tag.c_str());
+        releaseData();
+        return result;
     }
 
-    frametech::graphics::Memory::copyBufferToImage(
-        staging_buffer,
-        0,
+    if (const auto result = createImageView(texture_type, image_format); result.IsError())
+    {
+        LogE("Failed to initialize memory for the image view %s", m_tag.c_str());
+        releaseData();
+        return result;
+    }
+
+    if (const auto result = createSampler(); result.IsError())
+    {
+        releaseData();
+        return result;
+    }
+
+    // Transition - TOO COMPLEX, REDUCE COMPLEXITY OF TRANSITIONING HERE
+    upload_batch.transition(
         m_image,
-        transfert_command_pool,
-        transfert_queue,
-        m_height,
-        m_width);
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, // New
+        VK_IMAGE_LAYOUT_UNDEFINED,            // Old
+        VK_QUEUE_FAMILY_IGNORED,
+        VK_QUEUE_FAMILY_IGNORED,
+        m_mip_levels);
 
+    if (copy_from_ring)
     {
-        frametech::graphics::Command command_buffer(*transfert_command_pool);
-        command_buffer.createBuffer();
-        command_buffer.begin();
-        command_buffer.transition(
-            m_image,
-            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, // New
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,     // Old
-            transfert_queue_family_index,
-            transfert_queue_family_index);
-        command_buffer.end(transfert_queue, 1);
+        if (const auto result = copyMappedBlocks(upload_batch); result.IsError())
+        {
+            LogE("Failed to copy the blocks of the image %s", m_tag.c_str());
+            releaseData();
+            return result;
+        }
     }
+    else
+        upload_batch.copyBufferToImage(m_staging_buffer.m_buffer, m_image, copy_regions);
 
-    vmaDestroyBuffer(resource_allocator, staging_buffer, staging_buffer_allocation);
+    // Moves the image to SHADER_READ_ONLY_OPTIMAL, and hands it to the graphics queue
+    upload_batch.releaseImage(m_image, m_mip_levels);
+
+    // The staging buffer is released with the batch, once the copy is done
+    upload_batch.keepStagingBuffer(m_staging_buffer);
+    releaseData();
 
     return ftstd::VResult::Ok();
 }
 
+ftstd::VResult frametech::engine::graphics::Texture::copyMappedBlocks(frametech::graphics::UploadBatch& upload_batch) noexcept
+{
+    const u64 max_region_size = frametech::Engine::getInstance()->m_transfer_queue->getStagingRing().getMaxRegionSize();
+    // A band of block rows of a level, and where it is copied from in m_block_data
+    struct Band
+    {
+        u64 m_source_offset;
+        u64 m_size;
+        VkBufferImageCopy m_copy_region;
+    };
+    std::vector<Band> bands;
+    u64 bands_size = 0;
+    // Copies the bands packed so far with one command, from one region of the ring
+    const auto copyBands = [&]() -> ftstd::VResult {
+        if (bands.empty())
+            return ftstd::VResult::Ok();
+        auto allocated = upload_batch.allocate(bands_size);
+        if (allocated.IsError())
+            return ftstd::VResult::Error((char*)"Cannot allocate a region of the staging ring");
+        const frametech::graphics::StagingRegion region = allocated.GetValue();
+        std::vector<VkBufferImageCopy> copy_regions;
+        copy_regions.reserve(bands.size());
+        for (Band& band : bands)
+        {
+            memcpy(region.m_data + band.m_copy_region.bufferOffset, m_block_data + band.m_source_offset, band.m_size);
+            band.m_copy_region.bufferOffset += region.m_offset;
+            copy_regions.push_back(band.m_copy_region);
+        }
+        frametech::Engine::getInstance()->m_transfer_queue->getStagingRing().flush(region);
+        upload_batch.copyBufferToImage(region.m_buffer, m_image, copy_regions);
+        bands.clear();
+        bands_size = 0;
+        return ftstd::VResult::Ok();
+    };
+
+    for (u32 level = 0; level < m_levels.size(); ++level)
+    {
+        const TextureMipLevel& mip_level = m_levels[level];
+        const u32 block_rows_count = (mip_level.m_height + TextureCompressor::BLOCK_SIZE - 1) / TextureCompressor::BLOCK_SIZE;
+        const u64 block_row_size = mip_level.m_size / block_rows_count;
+        if (block_row_size > max_region_size)
+            return ftstd::VResult::Error((char*)"A row of blocks does not fit in the staging ring");
+        for (u32 block_row = 0; block_row < block_rows_count;)
+        {
+            if (bands_size + block_row_size > max_region_size)
+            {
+                if (const auto result = copyBands(); result.IsError())
+                    return result;
+            }
+            const u32 band_rows_count = static_cast<u32>(std::min<u64>(block_rows_count - block_row, (max_region_size - bands_size) / block_row_size));
+            const u32 band_y = block_row * TextureCompressor::BLOCK_SIZE;
+            const u64 band_size = band_rows_count * block_row_size;
+            bands.push_back(Band{
+                .m_source_offset = mip_level.m_offset + block_row * block_row_size,
+                .m_size = band_size,
+                .m_copy_region = VkBufferImageCopy{
+                    .bufferOffset = bands_size,
+                    .bufferRowLength = 0,
+                    .bufferImageHeight = 0,
+                    .imageSubresource = {
+                        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                        .mipLevel = level,
+                        .baseArrayLayer = 0,
+                        .layerCount = 1,
+                    },
+                    .imageOffset = {0, static_cast<i32>(band_y), 0},
+                    .imageExtent = {
+                        .width = mip_level.m_width,
+                        .height = std::min(band_rows_count * TextureCompressor::BLOCK_SIZE, mip_level.m_height - band_y),
+                        .depth = 1,
+                    },
+                },
+            });
+            bands_size += band_size;
+            block_row += band_rows_count;
+        }
+    }
+    m_levels.clear();
+    return copyBands();
+}
+
 inline int frametech::engine::graphics::Texture::getTextureSize() const noexcept
 {
     const int n_a_channels = m_supports_alpha ? 4 : 3;
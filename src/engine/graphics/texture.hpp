@@ -9,10 +9,18 @@
 #ifndef _texture_hpp
 #define _texture_hpp
 
+#include "../../ftstd/mapped_file.hpp"
 #include "../ftstd/result.hpp"
 #include "../platform.hpp"
+#include "memory.hpp"
+#include "mip_generator.hpp"
+#include "texture_cache.hpp"
+#include "texture_compressor.hpp"
+#include "upload_batch.hpp"
+#include <memory>
 #include <stb/stb_image.h>
 #include <string>
+#include <vector>
 #include <vk_mem_alloc.h>
 #include <vulkan/vulkan.h>
 
@@ -36,7 +44,87 @@ namespace frametech
                 ~Texture();
                 Texture(Texture const&) = delete;
                 Texture& operator=(Texture const&) = delete;
+                /// @brief Decodes the compressed texture data (PNG, JPG...), and generates its mip chain
+                /// in place in a mapped staging buffer - the decoded texels of stb_image are the only
+                /// other copy, released once the chain is built. `settings.m_compress` is ignored (see `compress`).
+                /// Only touches the allocator, which is internally synchronized, so it can be called from a worker thread.
+                /// @return A VResult type
+                ftstd::VResult decode(
+                    const char* content,
+                    const int content_size,
+                    const TextureDecodeSettings& settings,
+                    const std::string& tag = "Unknown") noexcept;
+                /// @brief Decodes, and compresses if `settings.m_compress` is set, the texture data
+                /// through the texture cache: on a hit, the cached mip chain is mapped instead.
+                /// On a miss, the result is written in the cache. CPU only, like `decode`.
+                /// @return A VResult type
+                ftstd::VResult load(
+                    const char* content,
+                    const int content_size,
+                    const TextureDecodeSettings& settings,
+                    const std::string& tag = "Unknown") noexcept;
+                /// @brief Builds the texture from raw RGBA texels, and generates its mip chain.
+                /// CPU only, like `decode`.
+                /// @param pixels The texels, 4 bytes per texel
+                /// @param max_mip_levels The maximum number of mip levels to generate
+                /// @param has_alpha If the alpha channel of `pixels` is meaningful
+                /// @return A VResult type
+                ftstd::VResult fromPixels(
+                    const unsigned char* pixels,
+                    const u32 width,
+                    const u32 height,
+                    const u32 max_mip_levels,
+                    const bool has_alpha,
+                    const std::string& tag = "Unknown") noexcept;
+                /// @brief Reads the size of an encoded texture (PNG, JPG...), without decoding it
+                /// @return If the size could be read
+                static bool getImageSize(const char* content, const int content_size, int& width, int& height) noexcept;
+                /// @brief Compresses each level of the decoded texture data to BC1 (opaque) or BC3 (with alpha)
+                /// blocks, in a new staging buffer, and releases the decoded texels. CPU only, like `decode`.
+                /// @return A VResult type
+                ftstd::VResult compress() noexcept;
+                /// @brief Like `compress`, through the texture cache - the key is the hash of the
+                /// decoded texels of the first level
+                /// @return A VResult type
+                ftstd::VResult compressCached() noexcept;
+                /// @brief Reads the mip chain of a texture file, instead of decoding (and compressing)
+                /// the source texture. Compressed blocks are mapped (and copied in the staging ring by `upload`),
+                /// decoded texels are copied in a staging buffer.
+                /// CPU only, like `decode`.
+                /// @param path The path of the texture file
+                /// @return A VResult type
+                ftstd::VResult readTextureFile(const char* path, const std::string& tag = "Unknown") noexcept;
+                /// @brief Writes the mip chain waiting to be uploaded (compressed blocks or decoded
+                /// texels) to a texture file, to skip the decoding and the compression next time
+                /// @param path The path of the texture file
+                /// @return A VResult type
+                ftstd::VResult writeTextureFile(const char* path) const noexcept;
+                /// @brief Returns if the texture data waiting to be uploaded is block compressed
+                bool isCompressed() const noexcept { return nullptr != m_block_data; }
+                /// @brief Uploads the decoded texture data to the GPU, and releases the CPU copy.
+                /// All the mip levels are copied from their staging buffer with one copy command.
+                /// Compressed blocks are uploaded as they are, in the matching BC sRGB format - the
+                /// blocks mapped from a texture file through the staging ring of the engine.
+                /// Must be called from the thread that owns the transfer queue.
+                /// Does not wait for the upload (see TransferQueue): use the batch overload to upload several
+                /// textures with one submission.
+                /// @param texture_format The format of the decoded texels - ignored for compressed blocks
+                /// @return A VResult type
+                ftstd::VResult upload(
+                    const frametech::engine::graphics::Texture::Type texture_type,
+                    const VkFormat texture_format = VK_FORMAT_R8G8B8A8_SRGB) noexcept;
+                /// @brief Records the upload of the texture in `upload_batch` - the graphics queue waits
+                /// for the batch before sampling the texture. The CPU copy is handed to the batch.
+                /// @param upload_batch The batch to record in, recording
+                /// @param texture_format The format of the decoded texels - ignored for compressed blocks
+                /// @return A VResult type
+                ftstd::VResult upload(
+                    frametech::graphics::UploadBatch& upload_batch,
+                    const frametech::engine::graphics::Texture::Type texture_type,
+                    const VkFormat texture_format = VK_FORMAT_R8G8B8A8_SRGB) noexcept;
                 /// @brief Load the compressed texture data and get the metadata from it
+                /// (decode, then compress if the device supports BC formats - both skipped on
+                /// a hit of the texture cache - then upload)
                 /// @return A VResult type
                 ftstd::VResult setup(
                     char* content,
@@ -46,12 +134,33 @@ namespace frametech
                     const VkFormat texture_format = VK_FORMAT_R8G8B8A8_SRGB,
                     const std::string& tag = "Unknown") noexcept;
                 inline int getTextureSize() const noexcept;
+                /// @brief Returns the number of mip levels of the texture
+                /// @return At least 1
+                u32 getMipLevels() const noexcept { return m_mip_levels; }
+                /// @brief Returns the video memory used by the uploaded image, in bytes
+                /// @return 0 if the texture has not been uploaded
+                u64 getMemorySize() const noexcept { return m_memory_size; }
+                /// @brief Returns the width of the texture, in texels
+                u32 getWidth() const noexcept { return static_cast<u32>(m_width); }
+                /// @brief Returns the height of the texture, in texels
+                u32 getHeight() const noexcept { return static_cast<u32>(m_height); }
+                /// @brief Returns if the decoded texels have 4 bytes per texel (3 otherwise)
+                bool supportsAlpha() const noexcept { return m_supports_alpha; }
+                /// @brief Returns if the texture has a meaningful alpha channel
+                bool hasAlpha() const noexcept { return m_supports_alpha && (4 == m_channels || 2 == m_channels); }
+                /// @brief Returns the decoded texels of the first mip level, waiting to be uploaded
+                /// @return nullptr if there are no decoded texels - 4 bytes per texel if the texture
+                /// supports alpha, 3 otherwise
+                const unsigned char* getPixels() const noexcept { return isCompressed() ? nullptr : m_staging_buffer.m_data; }
                 /// @brief Returns a copy of the registered sampler
                 /// @return VkSampler
                 VkSampler getSampler() noexcept { return m_sampler; }
                 /// @brief Returns a copy of the registered image view
                 /// @return VkImageView
                 VkImageView getImageView() noexcept { return m_image_view; }
+                /// @brief Returns a copy of the registered image
+                /// @return VkImage
+                VkImage getImage() noexcept { return m_image; }
 
             private:
                 /// @brief Height of the texture image
@@ -62,6 +171,25 @@ namespace frametech
                 int m_channels = 0;
                 /// @brief Alpha channel by default
                 bool m_supports_alpha = true;
+                /// @brief Mip chain waiting to be uploaded (decoded texels, or blocks compressed by
+                /// `compress`), written in place by the CPU - released once uploaded
+                frametech::graphics::StagingBuffer m_staging_buffer;
+                /// @brief Layout of the mip chain waiting to be uploaded (decoded texels or compressed blocks)
+                std::vector<TextureMipLevel> m_levels;
+                /// @brief Number of mip levels of the image
+                u32 m_mip_levels = 1;
+                /// @brief Format of the compressed blocks, if any
+                TextureBlockFormat m_block_format = TextureBlockFormat::BC1;
+                /// @brief Texture file the blocks are mapped from, if any
+                std::shared_ptr<ftstd::MappedFile> m_blocks_source = nullptr;
+                /// @brief Compressed blocks waiting to be uploaded (in m_staging_buffer or m_blocks_source) -
+                /// nullptr once uploaded
+                const unsigned char* m_block_data = nullptr;
+                /// @brief Size of m_block_data, in bytes
+                u64 m_block_data_size = 0;
+                /// @brief Releases the mip chain waiting to be uploaded: the staging buffer and the
+                /// mapped blocks
+                void releaseData() noexcept;
                 /// @brief Vulkan image object
                 VkImage m_image = VK_NULL_HANDLE;
                 /// @brief Vulkan image view to access the texture for the GPU
@@ -70,6 +198,8 @@ namespace frametech
                 VkSampler m_sampler = VK_NULL_HANDLE;
                 /// @brief Resource allocation object, required for VMA
                 VmaAllocation m_staging_image_allocation = VK_NULL_HANDLE;
+                /// @brief Size of m_staging_image_allocation, in bytes
+                u64 m_memory_size = 0;
                 /// @brief Creates the VkImage of the current object
                 /// @return As a result
                 ftstd::VResult createImage(const frametech::engine::graphics::Texture::Type texture_type,
@@ -82,6 +212,11 @@ namespace frametech
                 /// @brief Creates the VkSampler of the current object
                 /// @return As a result
                 ftstd::VResult createSampler() noexcept;
+                /// @brief Records the copy of the blocks mapped from a texture file to the image, through
+                /// the staging ring of the engine: the levels are packed in regions of the ring, and split in bands
+                /// of block rows if they do not fit in a region
+                /// @return As a result
+                ftstd::VResult copyMappedBlocks(frametech::graphics::UploadBatch& upload_batch) noexcept;
                 /// @brief Takes the filename as a tag
                 std::string m_tag;
                 Type m_type;
@@ -0,0 +1,140 @@
+//
+//  texture_atlas.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#include "texture_atlas.hpp"
+#include "../../ftstd/debug_tools.h"
+#include <algorithm>
+#include <cstring>
+
+#define STB_RECT_PACK_IMPLEMENTATION
+#include <stb/stb_rect_pack.h>
+
+/// @brief The textures are packed in units of texels that become one 4x4 block at the last
+/// mip level: at every level, each texture starts on a block boundary, so that no texel of
+/// the mip chain nor compressed block is shared by two textures
+constexpr u32 PACKING_UNIT = 4u << (frametech::engine::graphics::TextureAtlas::ATLAS_MIP_LEVELS - 1);
+static_assert(PACKING_UNIT % frametech::engine::graphics::TextureAtlas::ATLAS_PADDING == 0,
+              "the padding must be made of whole texels of the last mip level");
+
+bool frametech::engine::graphics::TextureAtlas::accepts(const u32 width, const u32 height) noexcept
+{
+    return width <= ATLAS_MAX_TEXTURE_SIZE && height <= ATLAS_MAX_TEXTURE_SIZE;
+}
+
+ftstd::VResult frametech::engine::graphics::TextureAtlas::add(const std::string& name, const Texture* texture) noexcept
+{
+    if (nullptr == texture || nullptr == texture->getPixels() || !texture->supportsAlpha())
+        return ftstd::VResult::Error((char*)"Cannot pack a texture without decoded RGBA texels");
+    if (!accepts(texture->getWidth(), texture->getHeight()))
+        return ftstd::VResult::Error((char*)"Texture too big to be packed in an atlas page");
+    m_entries.push_back(Entry{.m_name = name, .m_texture = texture});
+    return ftstd::VResult::Ok();
+}
+
+ftstd::VResult frametech::engine::graphics::TextureAtlas::build(
+    std::vector<Texture*>& pages,
+    std::map<std::string, TextureRegion>& regions) noexcept
+{
+    // Size of each texture with its padding, in packing units
+    std::vector<stbrp_rect> rects(m_entries.size());
+    for (size_t i = 0; i < m_entries.size(); ++i)
+    {
+        const Texture* texture = m_entries[i].m_texture;
+        rects[i] = stbrp_rect{
+            .id = static_cast<int>(i),
+            .w = static_cast<stbrp_coord>((texture->getWidth() + 2 * ATLAS_PADDING + PACKING_UNIT - 1) / PACKING_UNIT),
+            .h = static_cast<stbrp_coord>((texture->getHeight() + 2 * ATLAS_PADDING + PACKING_UNIT - 1) / PACKING_UNIT),
+        };
+    }
+
+    constexpr int page_units = static_cast<int>(ATLAS_PAGE_SIZE / PACKING_UNIT);
+    std::vector<stbrp_node> nodes(page_units);
+    while (!rects.empty())
+    {
+        stbrp_context context{};
+        stbrp_init_target(&context, page_units, page_units, nodes.data(), page_units);
+        stbrp_pack_rects(&context, rects.data(), static_cast<int>(rects.size()));
+
+        // Crop the page to the packed textures
+        u32 page_width = 0;
+        u32 page_height = 0;
+        for (const stbrp_rect& rect : rects)
+        {
+            if (!rect.was_packed)
+                continue;
+            page_width = std::max(page_width, static_cast<u32>(rect.x + rect.w) * PACKING_UNIT);
+            page_height = std::max(page_height, static_cast<u32>(rect.y + rect.h) * PACKING_UNIT);
+        }
+        if (0 == page_width || 0 == page_height)
+        {
+            LogE("Cannot pack %zu textures in an atlas page", rects.size());
+            m_entries.clear();
+            return ftstd::VResult::Error((char*)"Failed to pack the atlas textures");
+        }
+
+        // Copy each texture in the page, and repeat its border texels in its padding
+        std::vector<unsigned char> page_pixels(static_cast<size_t>(page_width) * page_height * 4, 0);
+        bool page_has_alpha = false;
+        std::vector<stbrp_rect> remaining_rects;
+        for (const stbrp_rect& rect : rects)
+        {
+            if (!rect.was_packed)
+            {
+                remaining_rects.push_back(rect);
+                continue;
+            }
+            const Entry& entry = m_entries[rect.id];
+            const u32 width = entry.m_texture->getWidth();
+            const u32 height = entry.m_texture->getHeight();
+            const unsigned char* pixels = entry.m_texture->getPixels();
+            const u32 rect_x = static_cast<u32>(rect.x) * PACKING_UNIT;
+            const u32 rect_y = static_cast<u32>(rect.y) * PACKING_UNIT;
+            const u32 rect_width = static_cast<u32>(rect.w) * PACKING_UNIT;
+            const u32 rect_height = static_cast<u32>(rect.h) * PACKING_UNIT;
+            for (u32 y = 0; y < rect_height; ++y)
+            {
+                const u32 source_y = static_cast<u32>(std::clamp<i64>(static_cast<i64>(y) - ATLAS_PADDING, 0, height - 1));
+                for (u32 x = 0; x < rect_width; ++x)
+                {
+                    const u32 source_x = static_cast<u32>(std::clamp<i64>(static_cast<i64>(x) - ATLAS_PADDING, 0, width - 1));
+                    memcpy(&page_pixels[((static_cast<size_t>(rect_y) + y) * page_width + rect_x + x) * 4],
+                           &pixels[(static_cast<size_t>(source_y) * width + source_x) * 4],
+                           4);
+                }
+            }
+            page_has_alpha = page_has_alpha || entry.m_texture->hasAlpha();
+            regions[entry.m_name] = TextureRegion{
+                .m_texture = static_cast<TextureHandle>(pages.size()),
+                .m_uv_rect = glm::vec4(
+                    static_cast<f32>(rect_x + ATLAS_PADDING) / static_cast<f32>(page_width),
+                    static_cast<f32>(rect_y + ATLAS_PADDING) / static_cast<f32>(page_height),
+                    static_cast<f32>(width) / static_cast<f32>(page_width),
+                    static_cast<f32>(height) / static_cast<f32>(page_height)),
+                .m_is_atlas_page = true,
+            };
+        }
+
+        const std::string page_tag = "Atlas page " + std::to_string(pages.size());
+        Texture* page = new Texture();
+        if (const auto result = page->fromPixels(page_pixels.data(), page_width, page_height, ATLAS_MIP_LEVELS, page_has_alpha, page_tag); result.IsError())
+        {
+            delete page;
+            for (const stbrp_rect& rect : rects)
+            {
+                if (rect.was_packed)
+                    regions.erase(m_entries[rect.id].m_name);
+            }
+            m_entries.clear();
+            return result;
+        }
+        pages.push_back(page);
+        Log("> %s: %zu textures packed in %ux%u texels", page_tag.c_str(), rects.size() - remaining_rects.size(), page_width, page_height);
+        rects = std::move(remaining_rects);
+    }
+    m_entries.clear();
+    return ftstd::VResult::Ok();
+}
@@ -0,0 +1,91 @@
+//
+//  texture_atlas.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _texture_atlas_hpp
+#define _texture_atlas_hpp
+
+#include "../../ftstd/result.hpp"
+#include "../platform.hpp"
+#include "texture.hpp"
+#include "texture_residency.hpp"
+#include <glm/glm.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace frametech
+{
+    namespace engine
+    {
+        namespace graphics
+        {
+            /// @brief Part of a texture to sample: a sub-rectangle of an atlas page,
+            /// or the whole of a standalone texture
+            struct TextureRegion
+            {
+                /// @brief The texture to sample
+                TextureHandle m_texture = INVALID_TEXTURE_HANDLE;
+                /// @brief Offset (xy) and scale (zw) to apply to the UVs of the meshes
+                glm::vec4 m_uv_rect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+                /// @brief If m_texture is an atlas page, shared with other regions
+                bool m_is_atlas_page = false;
+                /// @brief For a region of an atlas page: the same texture streamed on its own, for the
+                /// meshes with UVs out of [0, 1] - INVALID_TEXTURE_HANDLE otherwise
+                TextureHandle m_standalone_texture = INVALID_TEXTURE_HANDLE;
+            };
+
+            /// @brief Packs small decoded textures into shared atlas pages, with stb_rect_pack
+            class TextureAtlas
+            {
+            public:
+                /// @brief Maximum size of an atlas page, in texels
+                static constexpr u32 ATLAS_PAGE_SIZE = 2048;
+                /// @brief Maximum size of a texture to pack, in texels, on both axes
+                static constexpr u32 ATLAS_MAX_TEXTURE_SIZE = 256;
+                /// @brief Mip levels of the atlas pages
+                static constexpr u32 ATLAS_MIP_LEVELS = 3;
+                /// @brief Border around each texture, filled with its edge texels, sized for the mip
+                /// levels: still one texel at the last one, so that bilinear filtering does not bleed
+                /// from the neighbours at any level
+                static constexpr u32 ATLAS_PADDING = 1u << (ATLAS_MIP_LEVELS - 1);
+
+                /// @brief Returns if a texture of this size should go in an atlas page.
+                /// A packed texture is only sampled with UVs in [0, 1]: the sampler repeats the
+                /// whole page, not the region, so the UVs out of [0, 1] would read the neighbouring
+                /// textures. The meshes with such UVs sample the standalone version of the texture
+                /// instead (see TextureRegion::m_standalone_texture).
+                static bool accepts(const u32 width, const u32 height) noexcept;
+                /// @brief Registers a decoded texture to pack in the next `build` call.
+                /// The texture is not owned, and must stay alive until `build` returns.
+                /// @return A VResult type - an error if the texture has no decoded texels
+                ftstd::VResult add(const std::string& name, const Texture* texture) noexcept;
+                /// @brief Returns the number of registered textures
+                size_t size() const noexcept { return m_entries.size(); }
+                /// @brief Packs the registered textures in as many atlas pages as needed, and
+                /// forgets them. The pages are decoded textures (with their mip chain), not uploaded yet.
+                /// @param pages The created atlas pages, owned by the caller
+                /// @param regions The region of each registered texture, by name - the texture of
+                /// each region is the index of its page in `pages`, until the pages are registered
+                /// @return A VResult type
+                ftstd::VResult build(std::vector<Texture*>& pages, std::map<std::string, TextureRegion>& regions) noexcept;
+
+            private:
+                /// @brief A texture waiting to be packed
+                struct Entry
+                {
+                    std::string m_name;
+                    const Texture* m_texture;
+                };
+                /// @brief Textures waiting to be packed
+                std::vector<Entry> m_entries;
+            };
+        } // namespace graphics
+    } // namespace engine
+} // namespace frametech
+
+#endif // _texture_atlas_hpp
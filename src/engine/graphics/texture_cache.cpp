@@ -0,0 +1,146 @@
+//
+//  texture_cache.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#include "texture_cache.hpp"
+#include "../../ftstd/debug_tools.h"
+#include "../../ftstd/hash.hpp"
+#include "../../ftstd/mutex.hpp"
+#include "texture_file.hpp"
+#include <stdio.h>
+
+frametech::engine::graphics::TextureCache::TextureCache()
+{
+    std::error_code error;
+    std::filesystem::create_directories(TEXTURE_CACHE_FOLDER, error);
+    if (error)
+    {
+        LogW("Cannot create the texture cache folder '%s'", TEXTURE_CACHE_FOLDER);
+        return;
+    }
+    for (const auto& file : std::filesystem::directory_iterator(TEXTURE_CACHE_FOLDER, error))
+    {
+        if (!file.is_regular_file(error))
+            continue;
+        // Leftovers of an interrupted write
+        if (!TextureFile::isTextureFile(file.path().string().c_str()))
+        {
+            std::filesystem::remove(file.path(), error);
+            continue;
+        }
+        const std::string name = file.path().stem().string();
+        char* name_end = nullptr;
+        const u64 key = strtoull(name.c_str(), &name_end, 16);
+        if (name.empty() || '\0' != *name_end)
+            continue;
+        const Entry entry{
+            .m_size = static_cast<u64>(file.file_size(error)),
+            .m_last_use = file.last_write_time(error),
+        };
+        m_entries[key] = entry;
+        m_size += entry.m_size;
+    }
+    Log("> Texture cache: %zu entries, %llu MB", m_entries.size(), m_size / (1024 * 1024));
+    evict();
+}
+
+frametech::engine::graphics::TextureCache* frametech::engine::graphics::TextureCache::getInstance() noexcept
+{
+    // Thread safe initialization: the first call can come from any worker
+    static TextureCache instance;
+    return &instance;
+}
+
+u64 frametech::engine::graphics::TextureCache::getKey(const void* content, const u64 content_size, const TextureDecodeSettings& settings) noexcept
+{
+    // Hash the fields one by one: the padding of the structure is not initialized
+    const u64 settings_fields[] = {
+        TextureFile::TEXTURE_FILE_VERSION,
+        settings.m_supports_alpha ? 1ull : 0ull,
+        settings.m_srgb ? 1ull : 0ull,
+        settings.m_compress ? 1ull : 0ull,
+        settings.m_max_mip_levels,
+    };
+    const u64 seed = ftstd::hash::xxh64(settings_fields, sizeof(settings_fields));
+    return ftstd::hash::xxh64(content, content_size, seed);
+}
+
+std::string frametech::engine::graphics::TextureCache::getPath(const u64 key) const noexcept
+{
+    char name[17];
+    snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+    return std::string(TEXTURE_CACHE_FOLDER) + "/" + name + TextureFile::TEXTURE_FILE_EXTENSION;
+}
+
+bool frametech::engine::graphics::TextureCache::find(const u64 key) noexcept
+{
+    ftstd::mutex::ScopedMutex guard(&m_lock, (char*)"TextureCache::find");
+    const auto entry = m_entries.find(key);
+    if (entry == m_entries.end())
+        return false;
+    entry->second.m_last_use = std::filesystem::file_time_type::clock::now();
+    // Persist the use for the next launches - the content of the file does not change
+    std::error_code error;
+    std::filesystem::last_write_time(getPath(key), entry->second.m_last_use, error);
+    return true;
+}
+
+void frametech::engine::graphics::TextureCache::insert(const u64 key) noexcept
+{
+    std::error_code error;
+    const std::string path = getPath(key);
+    const u64 file_size = static_cast<u64>(std::filesystem::file_size(path, error));
+    if (error)
+        return;
+    ftstd::mutex::ScopedMutex guard(&m_lock, (char*)"TextureCache::insert");
+    // Two threads can insert the same content: the last file replaced the first one
+    if (const auto entry = m_entries.find(key); entry != m_entries.end())
+        m_size -= entry->second.m_size;
+    m_entries[key] = Entry{
+        .m_size = file_size,
+        .m_last_use = std::filesystem::file_time_type::clock::now(),
+    };
+    m_size += file_size;
+    evict();
+}
+
+void frametech::engine::graphics::TextureCache::remove(const u64 key) noexcept
+{
+    ftstd::mutex::ScopedMutex guard(&m_lock, (char*)"TextureCache::remove");
+    const auto entry = m_entries.find(key);
+    if (entry == m_entries.end())
+        return;
+    m_size -= entry->second.m_size;
+    m_entries.erase(entry);
+    std::error_code error;
+    std::filesystem::remove(getPath(key), error);
+}
+
+u64 frametech::engine::graphics::TextureCache::size() noexcept
+{
+    ftstd::mutex::ScopedMutex guard(&m_lock, (char*)"TextureCache::size");
+    return m_size;
+}
+
+void frametech::engine::graphics::TextureCache::evict() noexcept
+{
+    while (m_size > TEXTURE_CACHE_MAX_SIZE && !m_entries.empty())
+    {
+        // Few hundred entries at most: a linear search is enough
+        auto oldest_entry = m_entries.begin();
+        for (auto entry = m_entries.begin(); entry != m_entries.end(); ++entry)
+        {
+            if (entry->second.m_last_use < oldest_entry->second.m_last_use)
+                oldest_entry = entry;
+        }
+        // Textures already mapped from this file keep their pages until they are uploaded
+        std::error_code error;
+        std::filesystem::remove(getPath(oldest_entry->first), error);
+        Log("< Texture cache: evicting entry %016llx (%llu bytes)", static_cast<unsigned long long>(oldest_entry->first), oldest_entry->second.m_size);
+        m_size -= oldest_entry->second.m_size;
+        m_entries.erase(oldest_entry);
+    }
+}
@@ -0,0 +1,94 @@
+//
+//  texture_cache.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _texture_cache_hpp
+#define _texture_cache_hpp
+
+#include "../platform.hpp"
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace frametech
+{
+    namespace engine
+    {
+        namespace graphics
+        {
+            /// @brief Parameters of the decoding of a texture - part of the key of its cache entry
+            struct TextureDecodeSettings
+            {
+                /// @brief Decode to 4 bytes per texel (3 otherwise)
+                bool m_supports_alpha = true;
+                /// @brief If the texels are sRGB - the mip levels are then filtered in linear space
+                bool m_srgb = true;
+                /// @brief Compress the mip chain to BC1 / BC3 blocks
+                bool m_compress = false;
+                /// @brief Maximum number of mip levels to generate
+                u32 m_max_mip_levels = UINT32_MAX;
+            };
+
+            /// @brief On-disk cache of the decoded (or compressed) textures, keyed by the hash of
+            /// the source content and of the decode settings: a renamed or touched file still hits,
+            /// an edited one misses. Each entry is a texture file (see TextureFile).
+            /// The least recently used entries are removed once the cache is bigger than
+            /// TEXTURE_CACHE_MAX_SIZE. Thread safe.
+            class TextureCache
+            {
+            public:
+                /// @brief Folder of the cache entries, relative to the working directory
+                static constexpr const char* TEXTURE_CACHE_FOLDER = ".ftcache/textures";
+                /// @brief Maximum size of all the entries, in bytes
+                static constexpr u64 TEXTURE_CACHE_MAX_SIZE = 1024ull * 1024 * 1024;
+
+                TextureCache(TextureCache const&) = delete;
+                TextureCache& operator=(TextureCache const&) = delete;
+                /// @brief Returns the unique cache - the entries on disk are listed on first call
+                static TextureCache* getInstance() noexcept;
+                /// @brief Returns the key of the entry of an encoded texture (PNG, JPG...)
+                /// decoded with `settings`
+                static u64 getKey(const void* content, const u64 content_size, const TextureDecodeSettings& settings) noexcept;
+                /// @brief Returns the path of the texture file of the entry `key`
+                std::string getPath(const u64 key) const noexcept;
+                /// @brief Returns if the entry `key` exists, and marks it as the most recently used one
+                bool find(const u64 key) noexcept;
+                /// @brief Records the entry `key`, once its texture file has been written at `getPath(key)`.
+                /// Evicts the least recently used entries if the cache is too big.
+                void insert(const u64 key) noexcept;
+                /// @brief Removes the entry `key` - for entries that cannot be read anymore
+                void remove(const u64 key) noexcept;
+                /// @brief Returns the size of all the entries, in bytes
+                u64 size() noexcept;
+
+            private:
+                TextureCache();
+                /// @brief An entry of the cache
+                struct Entry
+                {
+                    /// @brief Size of the texture file, in bytes
+                    u64 m_size;
+                    /// @brief Last time the entry has been used - persisted as the
+                    /// modification time of the texture file
+                    std::filesystem::file_time_type m_last_use;
+                };
+                /// @brief Protects all the members
+                std::mutex m_lock;
+                /// @brief The entries, by key
+                std::unordered_map<u64, Entry> m_entries;
+                /// @brief Size of all the entries, in bytes
+                u64 m_size = 0;
+                /// @brief Removes the least recently used entries until the cache fits in
+                /// TEXTURE_CACHE_MAX_SIZE - m_lock must be held
+                void evict() noexcept;
+            };
+        } // namespace graphics
+    } // namespace engine
+} // namespace frametech
+
+#endif // _texture_cache_hpp
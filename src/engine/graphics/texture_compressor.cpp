@@ -0,0 +1,115 @@
+//
+//  texture_compressor.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#include "texture_compressor.hpp"
+#include "../../ftstd/debug_tools.h"
+#include "../../ftstd/thread_pool.hpp"
+#include <algorithm>
+#include <cstring>
+
+#define STB_DXT_IMPLEMENTATION
+#include <stb/stb_dxt.h>
+
+u32 frametech::engine::graphics::TextureCompressor::getBlockBytes(const TextureBlockFormat format) noexcept
+{
+    return format == TextureBlockFormat::BC3 ? 16 : 8;
+}
+
+u64 frametech::engine::graphics::TextureCompressor::getCompressedSize(const u32 width, const u32 height, const TextureBlockFormat format) noexcept
+{
+    const u64 blocks_x = (width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    const u64 blocks_y = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    return blocks_x * blocks_y * getBlockBytes(format);
+}
+
+VkFormat frametech::engine::graphics::TextureCompressor::getVulkanFormat(const TextureBlockFormat format) noexcept
+{
+    return format == TextureBlockFormat::BC3 ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+}
+
+std::vector<frametech::engine::graphics::TextureMipLevel> frametech::engine::graphics::TextureCompressor::getLevels(
+    const u32 width,
+    const u32 height,
+    const u32 levels_count,
+    const TextureBlockFormat format) noexcept
+{
+    return MipGenerator::getLevels(width, height, levels_count, [format](const u32 level_width, const u32 level_height) {
+        return getCompressedSize(level_width, level_height, format);
+    });
+}
+
+ftstd::VResult frametech::engine::graphics::TextureCompressor::compress(
+    const unsigned char* pixels,
+    const std::vector<TextureMipLevel>& levels,
+    const u32 channels,
+    const TextureBlockFormat format,
+    std::vector<unsigned char>& blocks,
+    std::vector<TextureMipLevel>& block_levels) noexcept
+{
+    if (nullptr == pixels || levels.empty())
+        return ftstd::VResult::Error((char*)"no texels to compress");
+    block_levels = getLevels(levels[0].m_width, levels[0].m_height, static_cast<u32>(levels.size()), format);
+    blocks.resize(MipGenerator::getChainSize(block_levels));
+    return compress(pixels, levels, channels, format, blocks.data(), block_levels);
+}
+
+ftstd::VResult frametech::engine::graphics::TextureCompressor::compress(
+    const unsigned char* pixels,
+    const std::vector<TextureMipLevel>& levels,
+    const u32 channels,
+    const TextureBlockFormat format,
+    unsigned char* blocks,
+    const std::vector<TextureMipLevel>& block_levels) noexcept
+{
+    if (nullptr == pixels || nullptr == blocks || levels.empty())
+        return ftstd::VResult::Error((char*)"no texels to compress");
+    if (3 != channels && 4 != channels)
+        return ftstd::VResult::Error((char*)"only RGB and RGBA texels can be compressed");
+    if (block_levels.size() != levels.size())
+        return ftstd::VResult::Error((char*)"the layout of the blocks does not match the mip chain");
+
+    const u32 block_bytes = getBlockBytes(format);
+    const int has_alpha = format == TextureBlockFormat::BC3 ? 1 : 0;
+    // Zeroed: the padding between the levels is written as is in the compressed texture files
+    memset(blocks, 0, MipGenerator::getChainSize(block_levels));
+
+    for (size_t level = 0; level < levels.size(); ++level)
+    {
+        const u32 width = levels[level].m_width;
+        const u32 height = levels[level].m_height;
+        const unsigned char* level_pixels = pixels + levels[level].m_offset;
+        unsigned char* output = blocks + block_levels[level].m_offset;
+        const u32 blocks_x = (width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        const u32 blocks_y = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+        // One job per row of blocks: each job writes its own range of the output
+        ftstd::ThreadPool::getInstance()->parallelFor(blocks_y, [=](const size_t block_y) {
+            // stb_dxt always reads 4 bytes per texel
+            unsigned char block_texels[BLOCK_SIZE * BLOCK_SIZE * 4];
+            for (u32 block_x = 0; block_x < blocks_x; ++block_x)
+            {
+                for (u32 y = 0; y < BLOCK_SIZE; ++y)
+                {
+                    // Partial blocks repeat the last row / column of the level
+                    const u64 source_y = std::min<u64>(block_y * BLOCK_SIZE + y, height - 1);
+                    for (u32 x = 0; x < BLOCK_SIZE; ++x)
+                    {
+                        const u64 source_x = std::min<u64>(block_x * BLOCK_SIZE + x, width - 1);
+                        const unsigned char* texel = level_pixels + (source_y * width + source_x) * channels;
+                        unsigned char* block_texel = block_texels + (y * BLOCK_SIZE + x) * 4;
+                        block_texel[0] = texel[0];
+                        block_texel[1] = texel[1];
+                        block_texel[2] = texel[2];
+                        block_texel[3] = 4 == channels ? texel[3] : 255;
+                    }
+                }
+                stb_compress_dxt_block(output + (block_y * blocks_x + block_x) * block_bytes, block_texels, has_alpha, STB_DXT_HIGHQUAL);
+            }
+        });
+    }
+    return ftstd::VResult::Ok();
+}
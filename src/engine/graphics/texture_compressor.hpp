@@ -0,0 +1,83 @@
+//
+//  texture_compressor.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _texture_compressor_hpp
+#define _texture_compressor_hpp
+
+#include "../../ftstd/result.hpp"
+#include "../platform.hpp"
+#include "mip_generator.hpp"
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace frametech
+{
+    namespace engine
+    {
+        namespace graphics
+        {
+            /// @brief Block compression formats supported by the engine.
+            /// Both encode blocks of 4x4 texels.
+            enum struct TextureBlockFormat : u32
+            {
+                /// @brief RGB, 8 bytes per block - for opaque textures
+                BC1 = 0,
+                /// @brief RGBA, 16 bytes per block (BC1 color + interpolated alpha)
+                BC3 = 1,
+            };
+
+            /// @brief Compresses decoded texels to BC1 / BC3 blocks, with stb_dxt
+            class TextureCompressor
+            {
+            public:
+                /// @brief Width and height of a block, in texels
+                static constexpr u32 BLOCK_SIZE = 4;
+
+                /// @brief Returns the size of one block, in bytes
+                static u32 getBlockBytes(const TextureBlockFormat format) noexcept;
+                /// @brief Returns the size of a compressed image, in bytes.
+                /// Partial blocks on the right and bottom borders count as full blocks.
+                static u64 getCompressedSize(const u32 width, const u32 height, const TextureBlockFormat format) noexcept;
+                /// @brief Returns the sRGB Vulkan format to sample the blocks of `format`
+                static VkFormat getVulkanFormat(const TextureBlockFormat format) noexcept;
+                /// @brief Returns the layout of a compressed mip chain
+                /// @return The levels, from the biggest to the smallest one
+                static std::vector<TextureMipLevel> getLevels(const u32 width, const u32 height, const u32 levels_count, const TextureBlockFormat format) noexcept;
+                /// @brief Compresses each level of the mip chain `pixels` to `blocks`, in the row-major
+                /// order expected by vkCmdCopyBufferToImage. The rows of blocks are spread across the thread pool.
+                /// @param pixels The decoded mip chain, `channels` bytes per texel (3 or 4)
+                /// @param levels The layout of `pixels`
+                /// @param channels The number of bytes per texel in `pixels`
+                /// @param format The block format to encode
+                /// @param blocks The output blocks - resized by the function
+                /// @param block_levels The output layout of `blocks`
+                /// @return A VResult type
+                static ftstd::VResult compress(
+                    const unsigned char* pixels,
+                    const std::vector<TextureMipLevel>& levels,
+                    const u32 channels,
+                    const TextureBlockFormat format,
+                    std::vector<unsigned char>& blocks,
+                    std::vector<TextureMipLevel>& block_levels) noexcept;
+                /// @brief Like `compress`, in memory owned by the caller (e.g. a mapped staging buffer)
+                /// @param blocks The output blocks, of `MipGenerator::getChainSize(block_levels)` bytes
+                /// @param block_levels The layout of `blocks`, from `getLevels` with the levels count of `levels`
+                /// @return A VResult type
+                static ftstd::VResult compress(
+                    const unsigned char* pixels,
+                    const std::vector<TextureMipLevel>& levels,
+                    const u32 channels,
+                    const TextureBlockFormat format,
+                    unsigned char* blocks,
+                    const std::vector<TextureMipLevel>& block_levels) noexcept;
+            };
+        } // namespace graphics
+    } // namespace engine
+} // namespace frametech
+
+#endif // _texture_compressor_hpp
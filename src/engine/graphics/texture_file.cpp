@@ -0,0 +1,122 @@
+//
+//  texture_file.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#include "texture_file.hpp"
+#include "../../ftstd/debug_tools.h"
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <stdio.h>
+#include <thread>
+
+bool frametech::engine::graphics::TextureFile::isTextureFile(const char* path) noexcept
+{
+    return std::filesystem::path(path).extension() == TEXTURE_FILE_EXTENSION;
+}
+
+std::vector<frametech::engine::graphics::TextureMipLevel> frametech::engine::graphics::TextureFile::getLevels(
+    const TextureFileFormat format,
+    const u32 width,
+    const u32 height,
+    const u32 mip_levels) noexcept
+{
+    if (TextureFileFormat::BC1 == format || TextureFileFormat::BC3 == format)
+        return TextureCompressor::getLevels(width, height, mip_levels, static_cast<TextureBlockFormat>(format));
+    const u64 texel_bytes = TextureFileFormat::RGBA8 == format ? 4 : 3;
+    return MipGenerator::getLevels(width, height, mip_levels, [texel_bytes](const u32 level_width, const u32 level_height) {
+        return static_cast<u64>(level_width) * level_height * texel_bytes;
+    });
+}
+
+ftstd::VResult frametech::engine::graphics::TextureFile::read(
+    const char* path,
+    std::shared_ptr<ftstd::MappedFile>& file,
+    TextureFileHeader& header) noexcept
+{
+    auto texture_file = std::make_shared<ftstd::MappedFile>();
+    // The mip chain is going to be copied in the staging buffer right after
+    if (texture_file->open(path, ftstd::MappedFile::Access::WILL_NEED).IsError())
+        return ftstd::VResult::Error((char*)"cannot map the texture file");
+
+    const u64 file_size = texture_file->size();
+    if (file_size < sizeof(TextureFileHeader))
+        return ftstd::VResult::Error((char*)"truncated texture file");
+    memcpy(&header, texture_file->data(), sizeof(TextureFileHeader));
+
+    if (0 != memcmp(header.m_magic, TEXTURE_FILE_MAGIC, sizeof(TEXTURE_FILE_MAGIC)))
+        return ftstd::VResult::Error((char*)"not a texture file");
+    if (TEXTURE_FILE_VERSION != header.m_version)
+    {
+        LogW("texture file '%s' has version %u, expected version %u", path, header.m_version, TEXTURE_FILE_VERSION);
+        return ftstd::VResult::Error((char*)"unsupported texture file version");
+    }
+    if (header.m_format > static_cast<u32>(TextureFileFormat::RGBA8))
+        return ftstd::VResult::Error((char*)"unknown format in the texture file");
+    const auto format = static_cast<TextureFileFormat>(header.m_format);
+    if (0 == header.m_width || 0 == header.m_height ||
+        0 == header.m_mip_levels || header.m_mip_levels > MipGenerator::getLevelsCount(header.m_width, header.m_height) ||
+        0 != header.m_data_offset % TEXTURE_FILE_ALIGNMENT ||
+        header.m_data_size != MipGenerator::getChainSize(getLevels(format, header.m_width, header.m_height, header.m_mip_levels)) ||
+        header.m_data_size > file_size ||
+        header.m_data_offset > file_size - header.m_data_size)
+        return ftstd::VResult::Error((char*)"corrupted texture file");
+
+    file = texture_file;
+    return ftstd::VResult::Ok();
+}
+
+ftstd::VResult frametech::engine::graphics::TextureFile::write(
+    const char* path,
+    const TextureFileFormat format,
+    const u32 width,
+    const u32 height,
+    const u32 channels,
+    const u32 mip_levels,
+    const unsigned char* data,
+    const u64 data_size) noexcept
+{
+    TextureFileHeader header{
+        .m_version = TEXTURE_FILE_VERSION,
+        .m_format = static_cast<u32>(format),
+        .m_width = width,
+        .m_height = height,
+        .m_mip_levels = mip_levels,
+        .m_channels = channels,
+        .m_padding = 0,
+        .m_data_size = data_size,
+        .m_data_offset = (sizeof(TextureFileHeader) + TEXTURE_FILE_ALIGNMENT - 1) / TEXTURE_FILE_ALIGNMENT * TEXTURE_FILE_ALIGNMENT,
+    };
+    memcpy(header.m_magic, TEXTURE_FILE_MAGIC, sizeof(TEXTURE_FILE_MAGIC));
+
+    // One temporary file per thread: two threads can write the same file
+    const std::string temporary_path = std::string(path) + "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+    FILE* pFile = fopen(temporary_path.c_str(), "wb");
+    if (NULL == pFile)
+        return ftstd::VResult::Error((char*)"cannot open the texture file to write");
+
+    static const char padding[TEXTURE_FILE_ALIGNMENT] = {};
+    const u64 data_padding = header.m_data_offset - sizeof(TextureFileHeader);
+    const bool written =
+        1 == fwrite(&header, sizeof(TextureFileHeader), 1, pFile) &&
+        data_padding == fwrite(padding, 1, data_padding, pFile) &&
+        data_size == fwrite(data, 1, data_size, pFile);
+    if (0 != fclose(pFile) || !written)
+    {
+        remove(temporary_path.c_str());
+        return ftstd::VResult::Error((char*)"cannot write the texture file");
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary_path, path, error);
+    if (error)
+    {
+        remove(temporary_path.c_str());
+        return ftstd::VResult::Error((char*)"cannot move the texture file");
+    }
+    Log("> Texture file '%s' written (%ux%u, %u mip levels, %llu bytes)", path, width, height, mip_levels, data_size);
+    return ftstd::VResult::Ok();
+}
@@ -0,0 +1,110 @@
+//
+//  texture_file.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _texture_file_hpp
+#define _texture_file_hpp
+
+#include "../../ftstd/mapped_file.hpp"
+#include "../../ftstd/result.hpp"
+#include "../platform.hpp"
+#include "texture_compressor.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace frametech
+{
+    namespace engine
+    {
+        namespace graphics
+        {
+            /// @brief Format of the mip chain stored in a texture file
+            enum struct TextureFileFormat : u32
+            {
+                /// @brief BC1 blocks - same value as TextureBlockFormat::BC1
+                BC1 = 0,
+                /// @brief BC3 blocks - same value as TextureBlockFormat::BC3
+                BC3 = 1,
+                /// @brief Decoded texels, 3 bytes per texel
+                RGB8 = 2,
+                /// @brief Decoded texels, 4 bytes per texel
+                RGBA8 = 3,
+            };
+
+            /// @brief Header of a texture file (.ftex).
+            /// Each mip level follows, in the layout of the staging buffer (see
+            /// TextureFile::getLevels), starting on a TEXTURE_FILE_ALIGNMENT boundary.
+            struct TextureFileHeader
+            {
+                /// @brief Always TEXTURE_FILE_MAGIC
+                char m_magic[4];
+                /// @brief Version of the format - files with another version are rejected
+                u32 m_version;
+                /// @brief The TextureFileFormat of the mip chain
+                u32 m_format;
+                /// @brief Width of the texture, in texels
+                u32 m_width;
+                /// @brief Height of the texture, in texels
+                u32 m_height;
+                /// @brief Number of mip levels
+                u32 m_mip_levels;
+                /// @brief Number of channels of the source image (before any conversion)
+                u32 m_channels;
+                /// @brief Keeps the next fields aligned - always 0
+                u32 m_padding;
+                /// @brief Size of all the levels, in bytes
+                u64 m_data_size;
+                /// @brief Offset of the first level, from the beginning of the file
+                u64 m_data_offset;
+            };
+
+            /// @brief Reads and writes texture files, used as entries of the texture
+            /// cache (decoded or compressed mip chains)
+            class TextureFile
+            {
+            public:
+                /// @brief Magic number of the compressed texture files
+                static constexpr char TEXTURE_FILE_MAGIC[4] = {'F', 'T', 'T', 'X'};
+                /// @brief Current version of the format
+                static constexpr u32 TEXTURE_FILE_VERSION = 3;
+                /// @brief Alignment of the levels in the file
+                static constexpr u64 TEXTURE_FILE_ALIGNMENT = 16;
+                /// @brief Extension of the texture files
+                static constexpr const char* TEXTURE_FILE_EXTENSION = ".ftex";
+
+                /// @brief Returns if `path` is a texture file, from its extension
+                static bool isTextureFile(const char* path) noexcept;
+                /// @brief Returns the layout of a mip chain of `format`
+                /// @return The levels, from the biggest to the smallest one
+                static std::vector<TextureMipLevel> getLevels(const TextureFileFormat format, const u32 width, const u32 height, const u32 mip_levels) noexcept;
+                /// @brief Maps the texture file at `path`, and checks its header.
+                /// The mip chain is at `header.m_data_offset` in `file`.
+                /// @return A VResult type - an error if the file is missing or invalid
+                static ftstd::VResult read(
+                    const char* path,
+                    std::shared_ptr<ftstd::MappedFile>& file,
+                    TextureFileHeader& header) noexcept;
+                /// @brief Writes `data` (a mip chain of `mip_levels` levels) in the texture file at `path`.
+                /// The file is written aside, then moved: a reader never sees a partial file.
+                /// @param channels The number of channels of the source image
+                /// @return A VResult type
+                static ftstd::VResult write(
+                    const char* path,
+                    const TextureFileFormat format,
+                    const u32 width,
+                    const u32 height,
+                    const u32 channels,
+                    const u32 mip_levels,
+                    const unsigned char* data,
+                    const u64 data_size) noexcept;
+            };
+        } // namespace graphics
+    } // namespace engine
+} // namespace frametech
+
+#endif // _texture_file_hpp
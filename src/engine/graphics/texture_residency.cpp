@@ -0,0 +1,218 @@
+//
+//  texture_residency.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#include "texture_residency.hpp"
+#include "../../ftstd/debug_tools.h"
+#include "../engine.hpp"
+#include "texture_file.hpp"
+
+frametech::engine::graphics::TextureHandle frametech::engine::graphics::TextureResidency::add(
+    const std::string& source_path,
+    const TextureDecodeSettings& settings,
+    const std::string& tag,
+    const std::shared_ptr<const frametech::engine::AssetArchive>& archive) noexcept
+{
+    Entry entry{};
+    entry.m_source_path = source_path;
+    entry.m_archive = archive;
+    entry.m_settings = settings;
+    entry.m_tag = tag;
+    m_entries.push_back(std::move(entry));
+    return static_cast<TextureHandle>(m_entries.size() - 1);
+}
+
+frametech::engine::graphics::TextureHandle frametech::engine::graphics::TextureResidency::addResident(Texture* texture) noexcept
+{
+    if (nullptr == texture)
+    {
+        LogW("tried to add a NULL resident texture, forbidden");
+        return INVALID_TEXTURE_HANDLE;
+    }
+    Entry entry{};
+    entry.m_texture = texture;
+    entry.m_size = texture->getMemorySize();
+    entry.m_last_use = m_frame;
+    entry.m_pinned = true;
+    m_resident_size += entry.m_size;
+    m_entries.push_back(std::move(entry));
+    return static_cast<TextureHandle>(m_entries.size() - 1);
+}
+
+void frametech::engine::graphics::TextureResidency::remove(const TextureHandle handle) noexcept
+{
+    if (handle >= m_entries.size() || m_entries[handle].m_removed)
+        return;
+    Entry& entry = m_entries[handle];
+    if (nullptr != entry.m_texture)
+        retire(entry);
+    entry.m_removed = true;
+    entry.m_source_path.clear();
+    entry.m_archive = nullptr;
+}
+
+bool frametech::engine::graphics::TextureResidency::replace(const TextureHandle handle, Texture* texture) noexcept
+{
+    if (nullptr == texture)
+        return false;
+    if (handle >= m_entries.size() || m_entries[handle].m_removed || m_entries[handle].m_pinned || nullptr == m_entries[handle].m_texture)
+    {
+        delete texture;
+        return false;
+    }
+    Entry& entry = m_entries[handle];
+    if (const auto result = texture->upload(Texture::Type::T2D, entry.m_settings.m_srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM); result.IsError())
+    {
+        LogE("Cannot upload the new version of the texture '%s', keeping the previous one", entry.m_tag.c_str());
+        delete texture;
+        return false;
+    }
+    retire(entry);
+    entry.m_texture = texture;
+    entry.m_size = texture->getMemorySize();
+    entry.m_last_use = m_frame;
+    m_resident_size += entry.m_size;
+    ++m_loads;
+    Log("> Texture '%s' has been replaced (%llu kB)", entry.m_tag.c_str(), entry.m_size >> 10);
+    evict();
+    return true;
+}
+
+frametech::engine::graphics::Texture* frametech::engine::graphics::TextureResidency::request(const TextureHandle handle) noexcept
+{
+    if (handle >= m_entries.size() || m_entries[handle].m_removed)
+        return nullptr;
+    Entry& entry = m_entries[handle];
+    entry.m_last_use = m_frame;
+    if (nullptr != entry.m_texture)
+        return entry.m_texture;
+    if (load(entry).IsError())
+    {
+        LogE("Cannot load the texture with name '%s'", entry.m_tag.c_str());
+        return nullptr;
+    }
+    evict();
+    return entry.m_texture;
+}
+
+ftstd::VResult frametech::engine::graphics::TextureResidency::load(Entry& entry) noexcept
+{
+    Texture* texture = new Texture();
+    ftstd::VResult result = ftstd::VResult::Ok();
+    // A cooked texture file (see ftcook) only has to be mapped
+    if (nullptr == entry.m_archive && TextureFile::isTextureFile(entry.m_source_path.c_str()))
+        result = texture->readTextureFile(entry.m_source_path.c_str(), entry.m_tag);
+    else
+    {
+        frametech::engine::AssetContent contents;
+        const auto opened = nullptr != entry.m_archive ? contents.open(entry.m_archive, entry.m_source_path)
+                                                       : contents.open(entry.m_source_path.c_str());
+        result = opened.IsError() || contents.isEmpty() ? ftstd::VResult::Error((char*)"Cannot open the texture source")
+                                                        : texture->load(contents.data(), static_cast<int>(contents.size()), entry.m_settings, entry.m_tag);
+    }
+    if (result.IsError())
+    {
+        delete texture;
+        return result;
+    }
+    result = texture->upload(Texture::Type::T2D, entry.m_settings.m_srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM);
+    if (result.IsError())
+    {
+        delete texture;
+        return result;
+    }
+    entry.m_texture = texture;
+    entry.m_size = texture->getMemorySize();
+    m_resident_size += entry.m_size;
+    ++m_loads;
+    Log("> Texture '%s' is resident (%llu kB)", entry.m_tag.c_str(), entry.m_size >> 10);
+    return ftstd::VResult::Ok();
+}
+
+void frametech::engine::graphics::TextureResidency::retire(Entry& entry) noexcept
+{
+    m_retired_textures.push_back(RetiredTexture{.m_texture = entry.m_texture, .m_frame = m_frame});
+    m_resident_size -= entry.m_size;
+    entry.m_texture = nullptr;
+    entry.m_size = 0;
+}
+
+void frametech::engine::graphics::TextureResidency::evict() noexcept
+{
+    while (m_resident_size > m_budget)
+    {
+        Entry* oldest_entry = nullptr;
+        for (Entry& entry : m_entries)
+        {
+            if (nullptr == entry.m_texture || entry.m_pinned || entry.m_last_use >= m_frame)
+                continue;
+            if (nullptr == oldest_entry || entry.m_last_use < oldest_entry->m_last_use)
+                oldest_entry = &entry;
+        }
+        // Everything left is used by the current frame: go over the budget
+        if (nullptr == oldest_entry)
+            return;
+        Log("< Evicting the texture '%s' (%llu kB)", oldest_entry->m_tag.c_str(), oldest_entry->m_size >> 10);
+        retire(*oldest_entry);
+        ++m_evictions;
+    }
+}
+
+void frametech::engine::graphics::TextureResidency::beginFrame(const u64 frame) noexcept
+{
+    m_frame = frame;
+    // Before recording `frame`, the frames older than the frames in flight have signaled their fence
+    const u64 frames_in_flight = frametech::Engine::getMaxFramesInFlight();
+    for (auto retired_texture = m_retired_textures.begin(); retired_texture != m_retired_textures.end();)
+    {
+        if (retired_texture->m_frame + frames_in_flight > frame)
+        {
+            ++retired_texture;
+            continue;
+        }
+        delete retired_texture->m_texture;
+        retired_texture = m_retired_textures.erase(retired_texture);
+    }
+}
+
+void frametech::engine::graphics::TextureResidency::setBudget(const u64 budget) noexcept
+{
+    m_budget = budget;
+    evict();
+}
+
+frametech::engine::graphics::TextureResidencyStats frametech::engine::graphics::TextureResidency::getStats() const noexcept
+{
+    TextureResidencyStats stats{
+        .m_registered = 0,
+        .m_resident = 0,
+        .m_resident_size = m_resident_size,
+        .m_budget = m_budget,
+        .m_loads = m_loads,
+        .m_evictions = m_evictions,
+        .m_pending_destructions = static_cast<u32>(m_retired_textures.size()),
+    };
+    for (const Entry& entry : m_entries)
+    {
+        if (entry.m_removed)
+            continue;
+        ++stats.m_registered;
+        if (nullptr != entry.m_texture)
+            ++stats.m_resident;
+    }
+    return stats;
+}
+
+void frametech::engine::graphics::TextureResidency::clear() noexcept
+{
+    for (Entry& entry : m_entries)
+        delete entry.m_texture;
+    m_entries.clear();
+    for (RetiredTexture& retired_texture : m_retired_textures)
+        delete retired_texture.m_texture;
+    m_retired_textures.clear();
+    m_resident_size = 0;
+}
@@ -0,0 +1,163 @@
+//
+//  texture_residency.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _texture_residency_hpp
+#define _texture_residency_hpp
+
+#include "../asset_archive.hpp"
+#include "../platform.hpp"
+#include "texture.hpp"
+#include "texture_cache.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace frametech
+{
+    namespace engine
+    {
+        namespace graphics
+        {
+            /// @brief Lightweight reference to a texture registered in a TextureResidency
+            using TextureHandle = u32;
+            /// @brief A handle that does not reference any texture
+            constexpr TextureHandle INVALID_TEXTURE_HANDLE = UINT32_MAX;
+
+            /// @brief Counters of a TextureResidency, for the debug tools
+            struct TextureResidencyStats
+            {
+                /// @brief Number of registered textures
+                u32 m_registered;
+                /// @brief Number of textures in video memory
+                u32 m_resident;
+                /// @brief Video memory used by the resident textures, in bytes
+                u64 m_resident_size;
+                /// @brief Video memory budget of the streamed textures, in bytes
+                u64 m_budget;
+                /// @brief Number of uploads since the start
+                u64 m_loads;
+                /// @brief Number of evictions since the start
+                u64 m_evictions;
+                /// @brief Number of evicted textures the GPU may still be using
+                u32 m_pending_destructions;
+            };
+
+            /// @brief Keeps in video memory only the textures that are used.
+            /// Streamed textures are registered as handles, and are uploaded on first request
+            /// (through the texture cache, so a reload only maps the cached mip chain).
+            /// Once the resident textures exceed the budget, the least recently used ones are
+            /// evicted. An evicted texture is destroyed once the frames that could sample it
+            /// are done (see `beginFrame`).
+            /// Not thread safe - must be used from the thread that owns the transfer queue.
+            class TextureResidency
+            {
+            public:
+                /// @brief Default video memory budget of the streamed textures, in bytes
+                static constexpr u64 DEFAULT_VRAM_BUDGET = 256ull * 1024 * 1024;
+
+                TextureResidency() = default;
+                ~TextureResidency() { clear(); }
+                TextureResidency(TextureResidency const&) = delete;
+                TextureResidency& operator=(TextureResidency const&) = delete;
+                /// @brief Registers a streamed texture, without loading it
+                /// @param source_path The encoded texture (PNG, JPG...) to load on request - the
+                /// name of its entry if `archive` is set
+                /// @param settings How to decode the source
+                /// @param tag The name of the texture
+                /// @param archive The asset archive of the source, if any - kept alive by the handle
+                /// @return The handle of the texture
+                TextureHandle add(const std::string& source_path,
+                                  const TextureDecodeSettings& settings,
+                                  const std::string& tag,
+                                  const std::shared_ptr<const frametech::engine::AssetArchive>& archive = nullptr) noexcept;
+                /// @brief Takes the ownership of an uploaded texture, that cannot be reloaded
+                /// from a file (atlas pages...) - it is never evicted
+                /// @return The handle of the texture
+                TextureHandle addResident(Texture* texture) noexcept;
+                /// @brief Unregisters a texture - destroyed once the GPU is done with it
+                void remove(const TextureHandle handle) noexcept;
+                /// @brief Swaps the texture of a streamed handle with `texture`, loaded but not
+                /// uploaded (see Texture::load), whose ownership is taken.
+                /// If the previous texture is resident, `texture` is uploaded in its place and the
+                /// previous one is destroyed once the GPU is done with it. Otherwise `texture` is
+                /// dropped: the next request reloads the source.
+                /// @return If the resident texture changed - the descriptors sampling it must be updated
+                bool replace(const TextureHandle handle, Texture* texture) noexcept;
+                /// @brief Returns the texture of `handle`, uploaded if it was not resident, and
+                /// marks it as used by the current frame. May evict other textures.
+                /// @return nullptr if the handle is invalid, or if the texture cannot be loaded
+                Texture* request(const TextureHandle handle) noexcept;
+                /// @brief Starts the frame `frame`, and destroys the evicted textures the
+                /// GPU cannot use anymore: the frames that could sample them have gone
+                /// through the in-flight fence.
+                /// @param frame The number of the frame about to be recorded
+                void beginFrame(const u64 frame) noexcept;
+                /// @brief Sets the video memory budget - evicts the textures above it
+                void setBudget(const u64 budget) noexcept;
+                /// @brief Returns the counters, for the debug tools
+                TextureResidencyStats getStats() const noexcept;
+                /// @brief Destroys all the textures - the GPU must be idle
+                void clear() noexcept;
+
+            private:
+                /// @brief A registered texture
+                struct Entry
+                {
+                    /// @brief Encoded source of a streamed texture - empty for the resident ones
+                    std::string m_source_path;
+                    /// @brief Asset archive of m_source_path, if any
+                    std::shared_ptr<const frametech::engine::AssetArchive> m_archive = nullptr;
+                    /// @brief How to decode m_source_path
+                    TextureDecodeSettings m_settings;
+                    /// @brief Name of the texture
+                    std::string m_tag;
+                    /// @brief The texture if resident, nullptr otherwise
+                    Texture* m_texture = nullptr;
+                    /// @brief Video memory of m_texture, in bytes
+                    u64 m_size = 0;
+                    /// @brief Last frame that requested the texture
+                    u64 m_last_use = 0;
+                    /// @brief Never evicted
+                    bool m_pinned = false;
+                    /// @brief Unregistered: the handle is not valid anymore
+                    bool m_removed = false;
+                };
+                /// @brief A texture waiting for the GPU to be done with it
+                struct RetiredTexture
+                {
+                    Texture* m_texture;
+                    /// @brief Frame during which the texture has been evicted
+                    u64 m_frame;
+                };
+                /// @brief Registered textures, indexed by handle
+                std::vector<Entry> m_entries;
+                /// @brief Evicted textures, by eviction frame
+                std::vector<RetiredTexture> m_retired_textures;
+                /// @brief Current frame
+                u64 m_frame = 0;
+                /// @brief Video memory budget, in bytes
+                u64 m_budget = DEFAULT_VRAM_BUDGET;
+                /// @brief Video memory used by the resident textures, in bytes
+                u64 m_resident_size = 0;
+                /// @brief Counters
+                u64 m_loads = 0;
+                u64 m_evictions = 0;
+                /// @brief Loads and uploads the texture of `entry`
+                /// @return A VResult type
+                ftstd::VResult load(Entry& entry) noexcept;
+                /// @brief Moves the texture of `entry` to the retired textures
+                void retire(Entry& entry) noexcept;
+                /// @brief Evicts the least recently used textures (except the ones used by the
+                /// current frame) until the resident textures fit in the budget
+                void evict() noexcept;
+            };
+        } // namespace graphics
+    } // namespace engine
+} // namespace frametech
+
+#endif // _texture_residency_hpp
@@ -0,0 +1,298 @@
+//
+//  transfer_queue.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#include "transfer_queue.hpp"
+#include "../../ftstd/debug_tools.h"
+#include "../../ftstd/profile_tools.h"
+#include "../engine.hpp"
+#include <algorithm>
+
+frametech::graphics::TransferQueue::~TransferQueue()
+{
+    destroy();
+}
+
+ftstd::VResult frametech::graphics::TransferQueue::create(VmaAllocator resources_allocator, const u64 staging_ring_size) noexcept
+{
+    destroy();
+    frametech::graphics::Device& graphics_device = frametech::Engine::getInstance()->m_graphics_device;
+    m_allocator = resources_allocator;
+    m_queue = graphics_device.getTransfertQueue();
+    m_family_index = graphics_device.m_transfert_queue_family_index;
+    m_graphics_family_index = graphics_device.m_graphics_queue_family_index;
+
+    VkSemaphoreTypeCreateInfo semaphore_type_info{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+        .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+        .initialValue = 0,
+    };
+    VkSemaphoreCreateInfo semaphore_info{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+        .pNext = &semaphore_type_info,
+    };
+    if (VK_SUCCESS != vkCreateSemaphore(graphics_device.getLogicalDevice(), &semaphore_info, nullptr, &m_timeline))
+    {
+        m_timeline = VK_NULL_HANDLE;
+        return ftstd::VResult::Error((char*)"Cannot create the transfer timeline semaphore");
+    }
+    m_submissions_count = 0;
+    m_retired_submission = 0;
+    if (const auto result = m_staging_ring.create(m_allocator, staging_ring_size); result.IsError())
+    {
+        destroy();
+        return result;
+    }
+    Log("> Transfer queue created (%s)", transfersOwnership() ? "dedicated queue family" : "shared with the graphics queue family");
+    return ftstd::VResult::Ok();
+}
+
+void frametech::graphics::TransferQueue::destroy() noexcept
+{
+    if (VK_NULL_HANDLE == m_timeline)
+        return;
+    while (reclaimOldest(true))
+        ;
+    m_acquires.clear();
+    m_staging_ring.destroy();
+    vkDestroySemaphore(frametech::Engine::getInstance()->m_graphics_device.getLogicalDevice(), m_timeline, nullptr);
+    m_timeline = VK_NULL_HANDLE;
+    Log("< Transfer queue destroyed");
+}
+
+ftstd::Result<frametech::graphics::StagingRegion> frametech::graphics::TransferQueue::allocate(const u64 size) noexcept
+{
+    if (0 == size || size > m_staging_ring.getMaxRegionSize())
+        return ftstd::Result<StagingRegion>::Error((char*)"The region does not fit in the staging ring");
+    reclaim();
+    while (true)
+    {
+        if (auto region = m_staging_ring.allocate(size); !region.IsError())
+            return region;
+        // Full: the regions not submitted yet cannot be released
+        if (!reclaimOldest(true))
+            return ftstd::Result<StagingRegion>::Error((char*)"The staging ring is full of regions not submitted");
+    }
+}
+
+ftstd::Result<u64> frametech::graphics::TransferQueue::submit(Command& command,
+                                                              VkCommandPool command_pool,
+                                                              std::vector<StagingBuffer>&& staging_buffers,
+                                                              std::vector<TransferAcquire>&& acquires) noexcept
+{
+    ftstd::profile::ScopedProfileMarker scope((char*)"frametech::graphics::TransferQueue::submit");
+    const u64 value = ++m_submissions_count;
+    const VkCommandBuffer command_buffer = *command.getBuffer();
+    const auto result = command.submit(m_queue, m_timeline, value);
+    if (result.IsError())
+    {
+        // The timeline values are consecutive: signal this one anyway, after the previous ones,
+        // for the submission to be released like the others
+        const VkTimelineSemaphoreSubmitInfo timeline_info{
+            .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+            .signalSemaphoreValueCount = 1,
+            .pSignalSemaphoreValues = &value,
+        };
+        const VkSubmitInfo submit_info{
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            .pNext = &timeline_info,
+            .signalSemaphoreCount = 1,
+            .pSignalSemaphores = &m_timeline,
+        };
+        vkQueueSubmit(m_queue, 1, &submit_info, VK_NULL_HANDLE);
+    }
+    m_submissions.push_back(Submission{
+        .m_value = value,
+        .m_staging_ring_head = m_staging_ring.getHead(),
+        .m_command_pool = command_pool,
+        .m_command_buffer = command_buffer,
+        .m_staging_buffers = std::move(staging_buffers),
+    });
+    if (result.IsError())
+        return ftstd::Result<u64>::Error((char*)"Cannot submit to the transfer queue");
+    for (TransferAcquire& acquire : acquires)
+    {
+        acquire.m_submission = value;
+        m_acquires.push_back(acquire);
+    }
+    return ftstd::Result<u64>::Ok(value);
+}
+
+void frametech::graphics::TransferQueue::reclaim() noexcept
+{
+    while (reclaimOldest(false))
+        ;
+}
+
+bool frametech::graphics::TransferQueue::isRetired(const u64 submission) noexcept
+{
+    if (submission <= m_retired_submission)
+        return true;
+    reclaim();
+    return submission <= m_retired_submission;
+}
+
+void frametech::graphics::TransferQueue::wait(const u64 submission) noexcept
+{
+    while (m_retired_submission < submission && reclaimOldest(true))
+        ;
+}
+
+bool frametech::graphics::TransferQueue::reclaimOldest(const bool wait) noexcept
+{
+    if (m_submissions.empty())
+        return false;
+    const VkDevice graphics_device = frametech::Engine::getInstance()->m_graphics_device.getLogicalDevice();
+    Submission& submission = m_submissions.front();
+    if (wait)
+    {
+        const VkSemaphoreWaitInfo wait_info{
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+            .semaphoreCount = 1,
+            .pSemaphores = &m_timeline,
+            .pValues = &submission.m_value,
+        };
+        vkWaitSemaphores(graphics_device, &wait_info, UINT64_MAX);
+    }
+    else
+    {
+        u64 timeline_value = 0;
+        if (VK_SUCCESS != vkGetSemaphoreCounterValue(graphics_device, m_timeline, &timeline_value) || timeline_value < submission.m_value)
+            return false;
+    }
+    vkFreeCommandBuffers(graphics_device, submission.m_command_pool, 1, &submission.m_command_buffer);
+    for (StagingBuffer& staging_buffer : submission.m_staging_buffers)
+        Memory::destroyStagingBuffer(m_allocator, staging_buffer);
+    m_staging_ring.release(submission.m_staging_ring_head);
+    m_retired_submission = submission.m_value;
+    m_submissions.pop_front();
+    // The written resources are kept until acquired, even without ownership transfer: the host
+    // seeing the submission done does not make its writes visible to the graphics queue
+    return true;
+}
+
+u64 frametech::graphics::TransferQueue::acquireImage(VkCommandBuffer command_buffer, VkImage image) noexcept
+{
+    u64 submission = 0;
+    if (VK_NULL_HANDLE == image)
+        return submission;
+    // One entry per upload to the image
+    for (size_t i = 0; i < m_acquires.size();)
+    {
+        if (m_acquires[i].m_image == image)
+            submission = std::max(submission, acquire(command_buffer, i));
+        else
+            ++i;
+    }
+    return submission;
+}
+
+u64 frametech::graphics::TransferQueue::acquireBuffer(VkCommandBuffer command_buffer, VkBuffer buffer) noexcept
+{
+    u64 submission = 0;
+    if (VK_NULL_HANDLE == buffer)
+        return submission;
+    // One entry per upload to the buffer - e.g. the ranges of the geometry pool
+    for (size_t i = 0; i < m_acquires.size();)
+    {
+        if (m_acquires[i].m_buffer == buffer)
+            submission = std::max(submission, acquire(command_buffer, i));
+        else
+            ++i;
+    }
+    return submission;
+}
+
+u64 frametech::graphics::TransferQueue::acquire(VkCommandBuffer command_buffer, const size_t index) noexcept
+{
+    const TransferAcquire acquire = m_acquires[index];
+    m_acquires.erase(m_acquires.begin() + index);
+    if (transfersOwnership() && !acquire.m_concurrent)
+    {
+        // Same layouts and queue families as the release barrier of the transfer queue; the
+        // semaphore wait of the submission covers m_dst_stage_mask
+        if (VK_NULL_HANDLE != acquire.m_image)
+        {
+            const VkImageMemoryBarrier image_barrier{
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                .srcAccessMask = 0,
+                .dstAccessMask = acquire.m_dst_access_mask,
+                .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                .newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                .srcQueueFamilyIndex = m_family_index,
+                .dstQueueFamilyIndex = m_graphics_family_index,
+                .image = acquire.m_image,
+                .subresourceRange = {
+                    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .baseMipLevel = 0,
+                    .levelCount = acquire.m_level_count,
+                    .baseArrayLayer = 0,
+                    .layerCount = 1,
+                },
+            };
+            vkCmdPipelineBarrier(command_buffer,
+                                 acquire.m_dst_stage_mask, acquire.m_dst_stage_mask,
+                                 0,
+                                 0, nullptr,
+                                 0, nullptr,
+                                 1, &image_barrier);
+        }
+        else
+        {
+            const VkBufferMemoryBarrier buffer_barrier{
+                .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+                .srcAccessMask = 0,
+                .dstAccessMask = acquire.m_dst_access_mask,
+                .srcQueueFamilyIndex = m_family_index,
+                .dstQueueFamilyIndex = m_graphics_family_index,
+                .buffer = acquire.m_buffer,
+                .offset = 0,
+                .size = VK_WHOLE_SIZE,
+            };
+            vkCmdPipelineBarrier(command_buffer,
+                                 acquire.m_dst_stage_mask, acquire.m_dst_stage_mask,
+                                 0,
+                                 0, nullptr,
+                                 1, &buffer_barrier,
+                                 0, nullptr);
+        }
+    }
+    // Waited for even if done already: the semaphore wait is the memory dependency between the
+    // writes of the transfer queue and the reads of the graphics queue
+    return acquire.m_submission;
+}
+
+u64 frametech::graphics::TransferQueue::forgetImage(VkImage image) noexcept
+{
+    u64 submission = 0;
+    for (auto acquire = m_acquires.begin(); acquire != m_acquires.end();)
+    {
+        if (acquire->m_image == image)
+        {
+            submission = std::max(submission, acquire->m_submission);
+            acquire = m_acquires.erase(acquire);
+        }
+        else
+            ++acquire;
+    }
+    return submission;
+}
+
+u64 frametech::graphics::TransferQueue::forgetBuffer(VkBuffer buffer) noexcept
+{
+    u64 submission = 0;
+    for (auto acquire = m_acquires.begin(); acquire != m_acquires.end();)
+    {
+        if (acquire->m_buffer == buffer)
+        {
+            submission = std::max(submission, acquire->m_submission);
+            acquire = m_acquires.erase(acquire);
+        }
+        else
+            ++acquire;
+    }
+    return submission;
+}
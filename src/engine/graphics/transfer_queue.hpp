@@ -0,0 +1,160 @@
+//
+//  transfer_queue.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _transfer_queue_hpp
+#define _transfer_queue_hpp
+
+#include "../../ftstd/result.hpp"
+#include "../platform.hpp"
+#include "command.hpp"
+#include "memory.hpp"
+#include "staging_ring.hpp"
+#include <deque>
+#include <vector>
+#include <vk_mem_alloc.h>
+#include <vulkan/vulkan.h>
+
+namespace frametech
+{
+    namespace graphics
+    {
+        /// @brief A resource written by the transfer queue, to acquire before its first use
+        /// on the graphics queue
+        struct TransferAcquire
+        {
+            /// @brief The image written - VK_NULL_HANDLE for a buffer
+            VkImage m_image = VK_NULL_HANDLE;
+            /// @brief Number of mip levels of m_image
+            u32 m_level_count = 1;
+            /// @brief The buffer written - VK_NULL_HANDLE for an image
+            VkBuffer m_buffer = VK_NULL_HANDLE;
+            /// @brief How the graphics queue accesses the resource
+            VkAccessFlags m_dst_access_mask = 0;
+            /// @brief Stage of the first access of the graphics queue
+            VkPipelineStageFlags m_dst_stage_mask = 0;
+            /// @brief If the resource is shared by the queue families (VK_SHARING_MODE_CONCURRENT):
+            /// it is not acquired, only waited for
+            bool m_concurrent = false;
+            /// @brief Value of the transfer timeline once the resource is written
+            u64 m_submission = 0;
+        };
+
+        /// @brief Submits the uploads to the transfer queue without blocking: each submission signals
+        /// the transfer timeline semaphore with the next value, and its command buffer and staging memory
+        /// are released once the timeline reaches it. The graphics queue waits for the timeline only in
+        /// the frames that use a resource written since the last ones (see `acquireImage` / `acquireBuffer`).
+        /// If the transfer and the graphics queue families differ, the written resources are released
+        /// by the transfer family and acquired by the graphics one.
+        /// Not thread safe: used by the thread that owns the transfer queue.
+        class TransferQueue
+        {
+        public:
+            TransferQueue() = default;
+            ~TransferQueue();
+            TransferQueue(TransferQueue const&) = delete;
+            TransferQueue& operator=(TransferQueue const&) = delete;
+
+            /// @brief Creates the transfer timeline and the staging ring
+            /// @param resources_allocator The allocator of the staging memory
+            /// @param staging_ring_size The size of the staging ring, in bytes
+            /// @return A VResult type
+            ftstd::VResult create(VmaAllocator resources_allocator, const u64 staging_ring_size = StagingRing::DEFAULT_STAGING_RING_SIZE) noexcept;
+            /// @brief Waits for the pending submissions, and releases the transfer timeline and the staging ring
+            void destroy() noexcept;
+            /// @brief Returns the staging ring the uploads are written in
+            StagingRing& getStagingRing() noexcept { return m_staging_ring; }
+            /// @brief Allocates a region of the staging ring. Waits for the oldest submissions if the ring is full.
+            /// @param size The size of the region, at most `StagingRing::getMaxRegionSize()`
+            /// @return The region, or an error if it cannot fit
+            ftstd::Result<StagingRegion> allocate(const u64 size) noexcept;
+            /// @brief Returns if the resources written by the transfer queue change of queue family
+            bool transfersOwnership() const noexcept { return m_family_index != m_graphics_family_index; }
+            /// @brief Returns the transfer queue family index
+            u32 getFamilyIndex() const noexcept { return m_family_index; }
+            /// @brief Returns the graphics queue family index
+            u32 getGraphicsFamilyIndex() const noexcept { return m_graphics_family_index; }
+            /// @brief Returns the transfer timeline semaphore
+            VkSemaphore getTimeline() const noexcept { return m_timeline; }
+            /// @brief Submits the command buffer recorded in `command`, without waiting. The command buffer,
+            /// the regions of the staging ring allocated so far and `staging_buffers` are released once done.
+            /// @param command The command, recording - a new buffer must be created to record again
+            /// @param command_pool The pool of the command buffer
+            /// @param staging_buffers Staging buffers the copies read from
+            /// @param acquires The resources written by the copies
+            /// @return The value the transfer timeline reaches once the submission is done
+            ftstd::Result<u64> submit(Command& command,
+                                      VkCommandPool command_pool,
+                                      std::vector<StagingBuffer>&& staging_buffers,
+                                      std::vector<TransferAcquire>&& acquires) noexcept;
+            /// @brief Returns the value of the last submission
+            u64 getLastSubmission() const noexcept { return m_submissions_count; }
+            /// @brief Releases the submissions that are done, without waiting
+            void reclaim() noexcept;
+            /// @brief Returns if `submission` is done
+            bool isRetired(const u64 submission) noexcept;
+            /// @brief Waits for `submission`, and releases it
+            void wait(const u64 submission) noexcept;
+            /// @brief Records the acquire barriers of `image` in `command_buffer` (of the graphics queue family),
+            /// for the writes of the transfer queue not acquired yet
+            /// @return The value of the transfer timeline to wait for before using it - 0 if no write is left to acquire.
+            /// Returned even if the write is done: the submission that uses it must wait for it
+            u64 acquireImage(VkCommandBuffer command_buffer, VkImage image) noexcept;
+            /// @brief Same as `acquireImage`, for a buffer
+            u64 acquireBuffer(VkCommandBuffer command_buffer, VkBuffer buffer) noexcept;
+            /// @brief Forgets `image`, about to be destroyed
+            /// @return The value of the transfer timeline to wait for before destroying it - 0 if it has been written already
+            u64 forgetImage(VkImage image) noexcept;
+            /// @brief Same as `forgetImage`, for a buffer
+            u64 forgetBuffer(VkBuffer buffer) noexcept;
+
+        private:
+            /// @brief A submission to the transfer queue
+            struct Submission
+            {
+                /// @brief Value of the transfer timeline once done
+                u64 m_value;
+                /// @brief Head of the staging ring at the submission: the regions before are released once done
+                u64 m_staging_ring_head;
+                /// @brief The pool of m_command_buffer
+                VkCommandPool m_command_pool;
+                /// @brief The command buffer submitted
+                VkCommandBuffer m_command_buffer;
+                /// @brief Staging buffers to destroy once done
+                std::vector<StagingBuffer> m_staging_buffers;
+            };
+            /// @brief Releases the oldest submission, waiting for it if `wait` is set
+            /// @return If a submission has been released
+            bool reclaimOldest(const bool wait) noexcept;
+            /// @brief Records the acquire barrier of the resource of m_acquires[index], and forgets it
+            /// @return The value to wait for
+            u64 acquire(VkCommandBuffer command_buffer, const size_t index) noexcept;
+            /// @brief The allocator of the staging memory
+            VmaAllocator m_allocator = VK_NULL_HANDLE;
+            /// @brief The transfer queue
+            VkQueue m_queue = VK_NULL_HANDLE;
+            /// @brief The transfer queue family index
+            u32 m_family_index = 0;
+            /// @brief The graphics queue family index
+            u32 m_graphics_family_index = 0;
+            /// @brief The staging ring the uploads are written in
+            StagingRing m_staging_ring;
+            /// @brief Timeline semaphore, signaled by each submission with its value
+            VkSemaphore m_timeline = VK_NULL_HANDLE;
+            /// @brief Number of submissions so far - value of the last one
+            u64 m_submissions_count = 0;
+            /// @brief Value of the last released submission
+            u64 m_retired_submission = 0;
+            /// @brief The submissions not released yet, from the oldest one
+            std::deque<Submission> m_submissions;
+            /// @brief The resources written, not acquired yet
+            std::vector<TransferAcquire> m_acquires;
+        };
+    } // namespace graphics
+} // namespace frametech
+
+#endif // _transfer_queue_hpp
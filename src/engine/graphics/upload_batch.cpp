@@ -0,0 +1,219 @@
+//
+//  upload_batch.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#include "upload_batch.hpp"
+#include "../../ftstd/debug_tools.h"
+#include "../../ftstd/profile_tools.h"
+#include "../engine.hpp"
+
+frametech::graphics::UploadBatch::UploadBatch(VkCommandPool transfert_command_pool) : m_command(transfert_command_pool)
+{
+    m_pool = transfert_command_pool;
+    m_transfer_queue = frametech::Engine::getInstance()->m_transfer_queue.get();
+}
+
+frametech::graphics::UploadBatch::~UploadBatch()
+{
+    // Never submitted: the operations recorded are dropped
+    if (m_recording)
+    {
+        vkFreeCommandBuffers(frametech::Engine::getInstance()->m_graphics_device.getLogicalDevice(), m_pool, 1, m_command.getBuffer());
+        m_recording = false;
+    }
+    VmaAllocator resource_allocator = frametech::Engine::getInstance()->m_allocator;
+    for (StagingBuffer& staging_buffer : m_staging_buffers)
+        Memory::destroyStagingBuffer(resource_allocator, staging_buffer);
+}
+
+ftstd::VResult frametech::graphics::UploadBatch::begin() noexcept
+{
+    assert(!m_recording);
+    if (const auto result = m_command.createBuffer(); result.IsError())
+        return result;
+    if (const auto result = m_command.begin(); result.IsError())
+    {
+        vkFreeCommandBuffers(frametech::Engine::getInstance()->m_graphics_device.getLogicalDevice(), m_pool, 1, m_command.getBuffer());
+        return result;
+    }
+    m_recording = true;
+    m_has_operations = false;
+    m_ring_size = 0;
+    return ftstd::VResult::Ok();
+}
+
+ftstd::Result<frametech::graphics::StagingRegion> frametech::graphics::UploadBatch::allocate(const u64 size) noexcept
+{
+    assert(m_recording);
+    // The regions of the batch are reclaimed once submitted only: submit before they fill the ring
+    const u64 aligned_size = (size + StagingRing::STAGING_RING_ALIGNMENT - 1) / StagingRing::STAGING_RING_ALIGNMENT * StagingRing::STAGING_RING_ALIGNMENT;
+    if (m_ring_size > 0 && m_ring_size + aligned_size > m_transfer_queue->getStagingRing().getMaxRegionSize())
+    {
+        if (const auto result = flush(); result.IsError())
+            return ftstd::Result<StagingRegion>::Error((char*)"Cannot submit the upload batch");
+    }
+    auto region = m_transfer_queue->allocate(size);
+    if (region.IsError())
+        return region;
+    m_ring_size += aligned_size;
+    m_has_operations = true;
+    return region;
+}
+
+void frametech::graphics::UploadBatch::copyBuffer(VkBuffer src, const u64 src_offset, VkBuffer dst, const u64 dst_offset, const u64 size) noexcept
+{
+    assert(m_recording);
+    const VkBufferCopy copy_region{
+        .srcOffset = src_offset,
+        .dstOffset = dst_offset,
+        .size = size,
+    };
+    vkCmdCopyBuffer(*m_command.getBuffer(), src, dst, 1, &copy_region);
+    m_has_operations = true;
+}
+
+void frametech::graphics::UploadBatch::copyBufferToImage(VkBuffer src, VkImage dst, const std::vector<VkBufferImageCopy>& copy_regions) noexcept
+{
+    assert(m_recording);
+    vkCmdCopyBufferToImage(
+        *m_command.getBuffer(),
+        src,
+        dst,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        static_cast<u32>(copy_regions.size()),
+        copy_regions.data());
+    m_has_operations = true;
+}
+
+void frametech::graphics::UploadBatch::transition(
+    const VkImage& image,
+    const VkImageLayout new_layout,
+    const VkImageLayout old_layout,
+    const u32 src_queue_family_index,
+    const u32 dst_queue_family_index,
+    const u32 level_count) const noexcept
+{
+    assert(m_recording);
+    m_command.transition(image, new_layout, old_layout, src_queue_family_index, dst_queue_family_index, level_count);
+}
+
+void frametech::graphics::UploadBatch::releaseImage(VkImage image, const u32 level_count) noexcept
+{
+    assert(m_recording);
+    if (m_transfer_queue->transfersOwnership())
+    {
+        // Release half of the queue family ownership transfer - the graphics queue records the
+        // acquire half, with the same layouts (see TransferQueue::acquireImage)
+        const VkImageMemoryBarrier image_barrier{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .dstAccessMask = 0,
+            .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            .newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            .srcQueueFamilyIndex = m_transfer_queue->getFamilyIndex(),
+            .dstQueueFamilyIndex = m_transfer_queue->getGraphicsFamilyIndex(),
+            .image = image,
+            .subresourceRange = {
+                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                .baseMipLevel = 0,
+                .levelCount = level_count,
+                .baseArrayLayer = 0,
+                .layerCount = 1,
+            },
+        };
+        vkCmdPipelineBarrier(*m_command.getBuffer(),
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                             0,
+                             0, nullptr,
+                             0, nullptr,
+                             1, &image_barrier);
+    }
+    else
+    {
+        m_command.transition(image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, level_count);
+    }
+    m_acquires.push_back(TransferAcquire{
+        .m_image = image,
+        .m_level_count = level_count,
+        .m_dst_access_mask = VK_ACCESS_SHADER_READ_BIT,
+        .m_dst_stage_mask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+    });
+    m_has_operations = true;
+}
+
+void frametech::graphics::UploadBatch::releaseBuffer(VkBuffer buffer, const VkAccessFlags dst_access_mask, const VkPipelineStageFlags dst_stage_mask, const bool concurrent) noexcept
+{
+    assert(m_recording);
+    if (m_transfer_queue->transfersOwnership() && !concurrent)
+    {
+        const VkBufferMemoryBarrier buffer_barrier{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .dstAccessMask = 0,
+            .srcQueueFamilyIndex = m_transfer_queue->getFamilyIndex(),
+            .dstQueueFamilyIndex = m_transfer_queue->getGraphicsFamilyIndex(),
+            .buffer = buffer,
+            .offset = 0,
+            .size = VK_WHOLE_SIZE,
+        };
+        vkCmdPipelineBarrier(*m_command.getBuffer(),
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                             0,
+                             0, nullptr,
+                             1, &buffer_barrier,
+                             0, nullptr);
+    }
+    // Same queue family, or shared buffer: the semaphore wait of the graphics queue makes the writes visible
+    m_acquires.push_back(TransferAcquire{
+        .m_buffer = buffer,
+        .m_dst_access_mask = dst_access_mask,
+        .m_dst_stage_mask = dst_stage_mask,
+        .m_concurrent = concurrent,
+    });
+    m_has_operations = true;
+}
+
+void frametech::graphics::UploadBatch::keepStagingBuffer(StagingBuffer& staging_buffer) noexcept
+{
+    if (VK_NULL_HANDLE == staging_buffer.m_buffer)
+        return;
+    m_staging_buffers.push_back(staging_buffer);
+    staging_buffer = StagingBuffer{};
+}
+
+ftstd::VResult frametech::graphics::UploadBatch::submit() noexcept
+{
+    ftstd::profile::ScopedProfileMarker scope((char*)"frametech::graphics::UploadBatch::submit");
+    assert(m_recording);
+    m_recording = false;
+    auto result = m_transfer_queue->submit(m_command, m_pool, std::move(m_staging_buffers), std::move(m_acquires));
+    m_staging_buffers.clear();
+    m_acquires.clear();
+    if (result.IsError())
+        return ftstd::VResult::Error((char*)"Cannot submit the upload batch");
+    m_last_submission = result.GetValue();
+    return ftstd::VResult::Ok();
+}
+
+bool frametech::graphics::UploadBatch::isDone() noexcept
+{
+    return !m_recording && m_transfer_queue->isRetired(m_last_submission);
+}
+
+void frametech::graphics::UploadBatch::wait() noexcept
+{
+    ftstd::profile::ScopedProfileMarker scope((char*)"frametech::graphics::UploadBatch::wait");
+    m_transfer_queue->wait(m_last_submission);
+}
+
+ftstd::VResult frametech::graphics::UploadBatch::flush() noexcept
+{
+    if (!m_has_operations)
+        return ftstd::VResult::Ok();
+    if (const auto result = submit(); result.IsError())
+        return result;
+    return begin();
+}
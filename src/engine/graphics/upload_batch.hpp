@@ -0,0 +1,136 @@
+//
+//  upload_batch.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _upload_batch_hpp
+#define _upload_batch_hpp
+
+#include "../../ftstd/result.hpp"
+#include "../platform.hpp"
+#include "command.hpp"
+#include "memory.hpp"
+#include "staging_ring.hpp"
+#include "transfer_queue.hpp"
+#include <algorithm>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace frametech
+{
+    namespace graphics
+    {
+        /// @brief Records the copies and the layout transitions of many uploads in one command buffer,
+        /// submitted once to the transfer queue of the engine (see TransferQueue) - instead of one
+        /// submission and one wait per operation. The submission is not waited for: the graphics
+        /// queue waits for it before using the resources released by the batch.
+        /// The staging memory of the batch (regions of the staging ring, or staging buffers handed
+        /// with `keepStagingBuffer`) is released once the submission is done.
+        /// Not thread safe: used by the thread that owns the transfer queue.
+        class UploadBatch
+        {
+        public:
+            /// @brief Public constructor
+            /// @param transfert_command_pool The Transfert command pool
+            UploadBatch(VkCommandPool transfert_command_pool);
+            /// @brief Public destructor - drops the operations if the batch has not been submitted
+            ~UploadBatch();
+            UploadBatch(UploadBatch const&) = delete;
+            UploadBatch& operator=(UploadBatch const&) = delete;
+            /// @brief Starts recording the batch
+            /// @return A VResult type
+            ftstd::VResult begin() noexcept;
+            /// @brief Allocates a region of the staging ring, for a copy of the batch. Submits
+            /// the operations recorded so far if the ring is filled by the batch.
+            /// @param size The size of the region, at most `StagingRing::getMaxRegionSize()`
+            /// @return The region, or an error if it cannot fit
+            ftstd::Result<StagingRegion> allocate(const u64 size) noexcept;
+            /// @brief Records a copy between two buffers
+            void copyBuffer(VkBuffer src, const u64 src_offset, VkBuffer dst, const u64 dst_offset, const u64 size) noexcept;
+            /// @brief Records a copy of several regions of a buffer (e.g. the mip levels of a texture) to an image
+            void copyBufferToImage(VkBuffer src, VkImage dst, const std::vector<VkBufferImageCopy>& copy_regions) noexcept;
+            /// @brief Records a transition barrier for an image (see `Command::transition`)
+            void transition(
+                const VkImage& image,
+                const VkImageLayout new_layout,
+                const VkImageLayout old_layout = VK_IMAGE_LAYOUT_UNDEFINED,
+                const u32 src_queue_family_index = VK_QUEUE_FAMILY_IGNORED,
+                const u32 dst_queue_family_index = VK_QUEUE_FAMILY_IGNORED,
+                const u32 level_count = 1) const noexcept;
+            /// @brief Copies `size` bytes to `dst_buffer`, through the staging ring: `write(data, offset, size)`
+            /// fills each chunk with the bytes [offset, offset + size) of the upload
+            /// @param dst_buffer The buffer to copy to
+            /// @param dst_offset Offset of the upload in `dst_buffer`
+            /// @param size Size of the upload, in bytes
+            /// @param write Fills a chunk of the upload
+            /// @return A VResult type
+            template <typename F>
+            ftstd::VResult uploadToBuffer(VkBuffer dst_buffer, const u64 dst_offset, const u64 size, F&& write) noexcept
+            {
+                const u64 max_chunk_size = m_transfer_queue->getStagingRing().getMaxRegionSize();
+                for (u64 offset = 0; offset < size;)
+                {
+                    const u64 chunk_size = std::min(size - offset, max_chunk_size);
+                    auto allocated = allocate(chunk_size);
+                    if (allocated.IsError())
+                        return ftstd::VResult::Error((char*)"Cannot allocate a region of the staging ring");
+                    const StagingRegion region = allocated.GetValue();
+                    write(region.m_data, offset, chunk_size);
+                    m_transfer_queue->getStagingRing().flush(region);
+                    copyBuffer(region.m_buffer, region.m_offset, dst_buffer, dst_offset + offset, chunk_size);
+                    offset += chunk_size;
+                }
+                return ftstd::VResult::Ok();
+            }
+            /// @brief Records the end of the writes to `image`, in TRANSFER_DST_OPTIMAL layout: moves it
+            /// to SHADER_READ_ONLY_OPTIMAL, and releases it to the graphics queue family if needed
+            /// @param level_count The number of mip levels of the image
+            void releaseImage(VkImage image, const u32 level_count) noexcept;
+            /// @brief Records the end of the writes to `buffer`, and releases it to the graphics queue family if needed
+            /// @param dst_access_mask How the graphics queue accesses the buffer
+            /// @param dst_stage_mask Stage of the first access of the graphics queue
+            /// @param concurrent If the buffer is shared by the queue families (VK_SHARING_MODE_CONCURRENT): it
+            /// is not released, the graphics queue only waits for the writes
+            void releaseBuffer(VkBuffer buffer, const VkAccessFlags dst_access_mask, const VkPipelineStageFlags dst_stage_mask, const bool concurrent = false) noexcept;
+            /// @brief Takes the ownership of `staging_buffer`, the source of copies of the batch:
+            /// it is destroyed once the batch is done
+            void keepStagingBuffer(StagingBuffer& staging_buffer) noexcept;
+            /// @brief Submits the operations recorded, without waiting
+            /// @return A VResult type
+            ftstd::VResult submit() noexcept;
+            /// @brief Returns if the operations submitted are done
+            bool isDone() noexcept;
+            /// @brief Waits for the operations submitted - the graphics queue waits for them by itself
+            /// (see TransferQueue), only the CPU reads of the written resources require it
+            void wait() noexcept;
+
+        private:
+            /// @brief Submits the operations recorded so far, and records the next ones in a new command buffer
+            /// @return A VResult type
+            ftstd::VResult flush() noexcept;
+            /// @brief The Transfert command pool
+            VkCommandPool m_pool = VK_NULL_HANDLE;
+            /// @brief The transfer queue of the engine
+            TransferQueue* m_transfer_queue = nullptr;
+            /// @brief The command buffer recording
+            Command m_command;
+            /// @brief If m_command is recording
+            bool m_recording = false;
+            /// @brief If operations have been recorded in m_command
+            bool m_has_operations = false;
+            /// @brief Bytes of the staging ring allocated since the last submission
+            u64 m_ring_size = 0;
+            /// @brief Value of the transfer timeline once the batch is done - 0 if not submitted
+            u64 m_last_submission = 0;
+            /// @brief Staging buffers read by the operations recorded, to hand to the transfer queue
+            std::vector<StagingBuffer> m_staging_buffers;
+            /// @brief Resources released by the operations recorded, to hand to the transfer queue
+            std::vector<TransferAcquire> m_acquires;
+        };
+    } // namespace graphics
+} // namespace frametech
+
+#endif // _upload_batch_hpp
@@ -14,31 +14,53 @@
 #pragma GCC diagnostic ignored "-Wformat-security"
 
 #include <cassert>
+#include <cstring>
+#include <mutex>
 #include <stdio.h>
 #include <string>
 #include <time.h>
 
+/// @brief Serializes the log statements of the threads - a line is never interleaved with another one
+inline std::mutex& get_log_mutex()
+{
+    static std::mutex log_mutex;
+    return log_mutex;
+}
+
 /// @brief Build and prints a log statement.
 /// The prefix argument is optional.
+/// Thread safe: the line is built in a local buffer, then printed at once.
 template <typename... Args>
 void build_log(FILE* stream, const char* prefix, Args... message)
 {
-    // Get timestamp
-    time_t ltime;
-    ltime = time(NULL);
-    char* time = asctime(localtime(&ltime));
-    assert(time != nullptr);
-    // Remove the newline character
-    if (time != nullptr)
-        time[strlen(time) - 1] = '\0';
-    // Print the date and the prefix
+    // Get timestamp - localtime_r / localtime_s and strftime, as asctime / localtime share a static buffer
+    const time_t ltime = time(NULL);
+    struct tm local_time;
+    char time[32] = "";
+#ifdef _WIN32
+    // MSVC: arguments in the opposite order, returns 0 on success
+    const bool has_local_time = 0 == localtime_s(&local_time, &ltime);
+#else
+    const bool has_local_time = nullptr != localtime_r(&ltime, &local_time);
+#endif
+    if (has_local_time)
+        strftime(time, sizeof(time), "%a %b %e %H:%M:%S %Y", &local_time);
+    // Build the full message
+    char line[1024];
+    const int length = snprintf(line, sizeof(line), message...);
+    std::string long_line;
+    if (length >= static_cast<int>(sizeof(line)))
+    {
+        long_line.resize(length + 1);
+        snprintf(long_line.data(), long_line.size(), message...);
+    }
+    const char* full_message = long_line.empty() ? line : long_line.c_str();
+    // Print the date, the prefix and the message
+    std::lock_guard<std::mutex> lock(get_log_mutex());
     if (prefix == nullptr)
-        fprintf(stream, "[%s] ", time);
+        fprintf(stream, "[%s] %s\n", time, full_message);
     else
-        fprintf(stream, "[%s] %s: ", time, prefix);
-    // Print the full message
-    fprintf(stream, message...);
-    fprintf(stream, "\n");
+        fprintf(stream, "[%s] %s: %s\n", time, prefix, full_message);
 }
 
 #pragma GCC diagnostic pop
@@ -0,0 +1,124 @@
+//
+//  file_watcher.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _file_watcher_hpp
+#define _file_watcher_hpp
+
+#include "debug_tools.h"
+#include "result.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+#include <errno.h>
+#include <limits.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace ftstd
+{
+    /// @brief Reports the files written in a set of folders (not recursive).
+    /// Only implemented with inotify on Linux: `watch` fails on the other platforms.
+    class FileWatcher
+    {
+    public:
+        FileWatcher() = default;
+        ~FileWatcher()
+        {
+#ifdef __linux__
+            if (-1 != m_inotify)
+                ::close(m_inotify);
+#endif
+        }
+        FileWatcher(FileWatcher const&) = delete;
+        FileWatcher& operator=(FileWatcher const&) = delete;
+
+        /// @brief Returns if the files can be watched on this platform
+        static constexpr bool isSupported() noexcept
+        {
+#ifdef __linux__
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /// @brief Starts to watch the files of `folder`
+        /// @return A VResult type
+        VResult watch(const std::string& folder) noexcept
+        {
+#ifdef __linux__
+            if (-1 == m_inotify)
+            {
+                m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+                if (-1 == m_inotify)
+                    return VResult::Error((char*)"Cannot initialize inotify");
+            }
+            // Written and closed, or moved in (editors that save in a temporary file first)
+            const int watch_descriptor = inotify_add_watch(m_inotify, folder.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+            if (-1 == watch_descriptor)
+            {
+                LogE("Cannot watch the folder '%s'", folder.c_str());
+                return VResult::Error((char*)"Cannot watch the folder");
+            }
+            m_folders[watch_descriptor] = folder;
+            return VResult::Ok();
+#else
+            return VResult::Error((char*)"Watching files is not supported on this platform");
+#endif
+        }
+
+        /// @brief Appends the paths of the files written since the last call to `changed_paths`
+        /// (`folder/filename`, once per file). Never blocks.
+        void poll(std::vector<std::string>& changed_paths) noexcept
+        {
+#ifdef __linux__
+            if (-1 == m_inotify)
+                return;
+            alignas(inotify_event) char buffer[16 * (sizeof(inotify_event) + NAME_MAX + 1)];
+            while (true)
+            {
+                const ssize_t length = ::read(m_inotify, buffer, sizeof(buffer));
+                // EAGAIN: no more events
+                if (length <= 0)
+                    return;
+                for (ssize_t offset = 0; offset < length;)
+                {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                    offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                    if (0 == event->len || 0 != (event->mask & IN_ISDIR))
+                        continue;
+                    const auto folder = m_folders.find(event->wd);
+                    if (folder == m_folders.end())
+                        continue;
+                    const std::string path = folder->second + "/" + event->name;
+                    bool is_known_path = false;
+                    for (const std::string& changed_path : changed_paths)
+                        is_known_path = is_known_path || changed_path == path;
+                    if (!is_known_path)
+                        changed_paths.push_back(path);
+                }
+            }
+#else
+            (void)changed_paths;
+#endif
+        }
+
+    private:
+#ifdef __linux__
+        /// @brief The inotify instance - -1 until the first folder is watched
+        int m_inotify = -1;
+#endif
+        /// @brief Watched folders, by watch descriptor
+        std::unordered_map<int, std::string> m_folders;
+    };
+} // namespace ftstd
+
+#endif // _file_watcher_hpp
@@ -0,0 +1,125 @@
+//
+//  hash.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _hash_hpp
+#define _hash_hpp
+
+#include <cstdint>
+#include <cstring>
+
+namespace ftstd
+{
+    namespace hash
+    {
+        /// @brief Primes of the XXH64 algorithm
+        constexpr uint64_t XXH64_PRIME_1 = 0x9E3779B185EBCA87ULL;
+        constexpr uint64_t XXH64_PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+        constexpr uint64_t XXH64_PRIME_3 = 0x165667B19E3779F9ULL;
+        constexpr uint64_t XXH64_PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+        constexpr uint64_t XXH64_PRIME_5 = 0x27D4EB2F165667C5ULL;
+
+        namespace details
+        {
+            inline uint64_t rotateLeft(const uint64_t value, const int bits) noexcept
+            {
+                return (value << bits) | (value >> (64 - bits));
+            }
+            /// @brief Unaligned little-endian reads
+            inline uint64_t read64(const unsigned char* data) noexcept
+            {
+                uint64_t value;
+                memcpy(&value, data, sizeof(value));
+                return value;
+            }
+            inline uint32_t read32(const unsigned char* data) noexcept
+            {
+                uint32_t value;
+                memcpy(&value, data, sizeof(value));
+                return value;
+            }
+            inline uint64_t round(uint64_t accumulator, const uint64_t input) noexcept
+            {
+                accumulator += input * XXH64_PRIME_2;
+                accumulator = rotateLeft(accumulator, 31);
+                return accumulator * XXH64_PRIME_1;
+            }
+            inline uint64_t mergeRound(uint64_t accumulator, const uint64_t value) noexcept
+            {
+                accumulator ^= round(0, value);
+                return accumulator * XXH64_PRIME_1 + XXH64_PRIME_4;
+            }
+        } // namespace details
+
+        /// @brief Hashes `size` bytes with XXH64 - the result matches the reference implementation
+        /// on little-endian platforms.
+        /// Not a cryptographic hash: only use it to identify content (caches...).
+        /// @param seed Different seeds give unrelated hashes for the same bytes
+        inline uint64_t xxh64(const void* data, const uint64_t size, const uint64_t seed = 0) noexcept
+        {
+            const unsigned char* input = static_cast<const unsigned char*>(data);
+            const unsigned char* const end = input + size;
+            uint64_t hash;
+
+            if (size >= 32)
+            {
+                // 4 independent lanes of 8 bytes, to keep the CPU pipeline busy
+                const unsigned char* const limit = end - 32;
+                uint64_t v1 = seed + XXH64_PRIME_1 + XXH64_PRIME_2;
+                uint64_t v2 = seed + XXH64_PRIME_2;
+                uint64_t v3 = seed;
+                uint64_t v4 = seed - XXH64_PRIME_1;
+                do
+                {
+                    v1 = details::round(v1, details::read64(input));
+                    v2 = details::round(v2, details::read64(input + 8));
+                    v3 = details::round(v3, details::read64(input + 16));
+                    v4 = details::round(v4, details::read64(input + 24));
+                    input += 32;
+                } while (input <= limit);
+
+                hash = details::rotateLeft(v1, 1) + details::rotateLeft(v2, 7) + details::rotateLeft(v3, 12) + details::rotateLeft(v4, 18);
+                hash = details::mergeRound(hash, v1);
+                hash = details::mergeRound(hash, v2);
+                hash = details::mergeRound(hash, v3);
+                hash = details::mergeRound(hash, v4);
+            }
+            else
+            {
+                hash = seed + XXH64_PRIME_5;
+            }
+
+            hash += size;
+            for (; input + 8 <= end; input += 8)
+            {
+                hash ^= details::round(0, details::read64(input));
+                hash = details::rotateLeft(hash, 27) * XXH64_PRIME_1 + XXH64_PRIME_4;
+            }
+            if (input + 4 <= end)
+            {
+                hash ^= static_cast<uint64_t>(details::read32(input)) * XXH64_PRIME_1;
+                hash = details::rotateLeft(hash, 23) * XXH64_PRIME_2 + XXH64_PRIME_3;
+                input += 4;
+            }
+            for (; input < end; ++input)
+            {
+                hash ^= (*input) * XXH64_PRIME_5;
+                hash = details::rotateLeft(hash, 11) * XXH64_PRIME_1;
+            }
+
+            // Avalanche
+            hash ^= hash >> 33;
+            hash *= XXH64_PRIME_2;
+            hash ^= hash >> 29;
+            hash *= XXH64_PRIME_3;
+            hash ^= hash >> 32;
+            return hash;
+        }
+    } // namespace hash
+} // namespace ftstd
+
+#endif // _hash_hpp
@@ -0,0 +1,216 @@
+//
+//  mapped_file.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _mapped_file_hpp
+#define _mapped_file_hpp
+
+#include "debug_tools.h"
+#include "result.hpp"
+#include <cstdint>
+#include <utility>
+
+#ifdef WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else // APPLE / UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ftstd
+{
+    /// @brief Read-only view of a whole file, mapped in the address space of the process.
+    /// The file is unmapped once the object is destroyed.
+    /// Pages are loaded by the OS on first access: nothing is copied to the heap.
+    class MappedFile
+    {
+    public:
+        /// @brief How the mapping is going to be read - forwarded to the OS as a hint
+        enum struct Access
+        {
+            /// @brief Read once, from the beginning to the end (decoders, parsers)
+            SEQUENTIAL,
+            /// @brief Read at random offsets (tables of contents, archives)
+            RANDOM,
+            /// @brief The whole file is going to be needed soon: start reading ahead now
+            WILL_NEED,
+        };
+
+        MappedFile() = default;
+        ~MappedFile()
+        {
+            close();
+        }
+        MappedFile(MappedFile const&) = delete;
+        MappedFile& operator=(MappedFile const&) = delete;
+        MappedFile(MappedFile&& other) noexcept
+        {
+            *this = std::move(other);
+        }
+        MappedFile& operator=(MappedFile&& other) noexcept
+        {
+            if (this != &other)
+            {
+                close();
+                std::swap(m_data, other.m_data);
+                std::swap(m_size, other.m_size);
+#ifdef WIN32
+                std::swap(m_file, other.m_file);
+                std::swap(m_mapping, other.m_mapping);
+#endif
+            }
+            return *this;
+        }
+
+        /// @brief Maps the file at `filepath`, and unmaps the previous one if any.
+        /// An empty file is valid, and gives an empty mapping.
+        /// @param filepath The path of the file to map
+        /// @param access_hint The way the content is going to be read
+        /// @return A VResult type
+        VResult open(const char* filepath, const Access access_hint = Access::SEQUENTIAL) noexcept
+        {
+            close();
+#ifdef WIN32
+            m_file = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+            if (INVALID_HANDLE_VALUE == m_file)
+            {
+                LogE("Cannot open file '%s' to map it", filepath);
+                return VResult::Error((char*)"Cannot open the file to map");
+            }
+            LARGE_INTEGER file_size{};
+            if (!GetFileSizeEx(m_file, &file_size))
+            {
+                close();
+                return VResult::Error((char*)"Cannot get the size of the file to map");
+            }
+            m_size = static_cast<uint64_t>(file_size.QuadPart);
+            if (0 == m_size)
+                return VResult::Ok();
+            m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (NULL == m_mapping)
+            {
+                close();
+                return VResult::Error((char*)"Cannot create the file mapping");
+            }
+            m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+            if (nullptr == m_data)
+            {
+                close();
+                return VResult::Error((char*)"Cannot map the view of the file");
+            }
+#else
+            const int file_descriptor = ::open(filepath, O_RDONLY);
+            if (-1 == file_descriptor)
+            {
+                LogE("Cannot open file '%s' to map it", filepath);
+                return VResult::Error((char*)"Cannot open the file to map");
+            }
+            struct stat file_stats
+            {
+            };
+            if (-1 == fstat(file_descriptor, &file_stats))
+            {
+                ::close(file_descriptor);
+                return VResult::Error((char*)"Cannot get the size of the file to map");
+            }
+            m_size = static_cast<uint64_t>(file_stats.st_size);
+            if (0 == m_size)
+            {
+                ::close(file_descriptor);
+                return VResult::Ok();
+            }
+            void* data = mmap(nullptr, static_cast<size_t>(m_size), PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+            // The mapping keeps its own reference on the file
+            ::close(file_descriptor);
+            if (MAP_FAILED == data)
+            {
+                m_size = 0;
+                LogE("Cannot map file '%s'", filepath);
+                return VResult::Error((char*)"Cannot map the file");
+            }
+            m_data = static_cast<const char*>(data);
+#endif
+            advise(access_hint);
+            return VResult::Ok();
+        }
+
+        /// @brief Forwards a new access hint for the whole mapping to the OS.
+        /// Only a hint: does nothing on platforms without madvise.
+        void advise(const Access access_hint) const noexcept
+        {
+#ifndef WIN32
+            if (nullptr == m_data)
+                return;
+            int advice = MADV_SEQUENTIAL;
+            switch (access_hint)
+            {
+                case Access::SEQUENTIAL:
+                    advice = MADV_SEQUENTIAL;
+                    break;
+                case Access::RANDOM:
+                    advice = MADV_RANDOM;
+                    break;
+                case Access::WILL_NEED:
+                    advice = MADV_WILLNEED;
+                    break;
+            }
+            madvise(const_cast<char*>(m_data), static_cast<size_t>(m_size), advice);
+#else
+            (void)access_hint;
+#endif
+        }
+
+        /// @brief Unmaps the file - the object can be reused with `open`
+        void close() noexcept
+        {
+#ifdef WIN32
+            if (nullptr != m_data)
+                UnmapViewOfFile(m_data);
+            if (NULL != m_mapping)
+                CloseHandle(m_mapping);
+            if (INVALID_HANDLE_VALUE != m_file)
+                CloseHandle(m_file);
+            m_mapping = NULL;
+            m_file = INVALID_HANDLE_VALUE;
+#else
+            if (nullptr != m_data)
+                munmap(const_cast<char*>(m_data), static_cast<size_t>(m_size));
+#endif
+            m_data = nullptr;
+            m_size = 0;
+        }
+
+        /// @brief Returns the first byte of the mapping, or nullptr if nothing is mapped
+        const char* data() const noexcept { return m_data; }
+        /// @brief Returns the size of the mapping, in bytes
+        uint64_t size() const noexcept { return m_size; }
+        /// @brief Returns if the object maps a non-empty file
+        bool isMapped() const noexcept { return nullptr != m_data; }
+
+    private:
+        /// @brief First byte of the mapping
+        const char* m_data = nullptr;
+        /// @brief Size of the mapping, in bytes
+        uint64_t m_size = 0;
+#ifdef WIN32
+        /// @brief The opened file
+        HANDLE m_file = INVALID_HANDLE_VALUE;
+        /// @brief The file mapping object
+        HANDLE m_mapping = NULL;
+#endif
+    };
+} // namespace ftstd
+
+#endif // _mapped_file_hpp
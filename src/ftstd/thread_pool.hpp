@@ -0,0 +1,159 @@
+//
+//  thread_pool.hpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+#pragma once
+#ifndef _thread_pool_hpp
+#define _thread_pool_hpp
+
+#include "debug_tools.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ftstd
+{
+    /// @brief A fixed-size pool of worker threads, fed by a FIFO of jobs.
+    /// Jobs must not touch any Vulkan object that requires external
+    /// synchronization (queues, command pools...): keep those on the main thread.
+    class ThreadPool
+    {
+    private:
+        /// @brief The worker threads
+        std::vector<std::thread> m_workers;
+        /// @brief Jobs waiting for a worker
+        std::deque<std::function<void()>> m_jobs;
+        /// @brief Protects m_jobs and m_stop
+        std::mutex m_jobs_mutex;
+        /// @brief Wakes up the workers when a job is pushed, or the pool stopped
+        std::condition_variable m_jobs_cv;
+        /// @brief Set to true to ask the workers to return
+        bool m_stop = false;
+
+        /// @brief Worker loop: pops and runs jobs until the pool is stopped
+        void work()
+        {
+            while (true)
+            {
+                std::function<void()> job;
+                {
+                    std::unique_lock<std::mutex> lock(m_jobs_mutex);
+                    m_jobs_cv.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+                    if (m_stop && m_jobs.empty())
+                        return;
+                    job = std::move(m_jobs.front());
+                    m_jobs.pop_front();
+                }
+                job();
+            }
+        }
+
+    public:
+        /// @brief Spawns `nb_workers` threads - defaults to the number of hardware threads
+        explicit ThreadPool(uint32_t nb_workers = 0)
+        {
+            if (0 == nb_workers)
+                nb_workers = std::max(1u, std::thread::hardware_concurrency());
+            m_workers.reserve(nb_workers);
+            for (uint32_t i = 0; i < nb_workers; ++i)
+                m_workers.emplace_back([this] { work(); });
+        }
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_jobs_mutex);
+                m_stop = true;
+            }
+            m_jobs_cv.notify_all();
+            for (std::thread& worker : m_workers)
+                worker.join();
+        }
+        ThreadPool(ThreadPool const&) = delete;
+        ThreadPool& operator=(ThreadPool const&) = delete;
+
+        /// @brief Returns the engine-wide pool, created on first use
+        static ThreadPool* getInstance()
+        {
+            static ThreadPool instance;
+            return &instance;
+        }
+
+        /// @brief Returns the number of worker threads
+        uint32_t size() const noexcept { return static_cast<uint32_t>(m_workers.size()); }
+
+        /// @brief Pushes a job to the pool
+        /// @return A future to wait for the result of the job
+        template <typename F>
+        auto submit(F&& job) -> std::future<decltype(job())>
+        {
+            using R = decltype(job());
+            auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(job));
+            std::future<R> result = task->get_future();
+            {
+                std::lock_guard<std::mutex> lock(m_jobs_mutex);
+                m_jobs.emplace_back([task] { (*task)(); });
+            }
+            m_jobs_cv.notify_one();
+            return result;
+        }
+
+        /// @brief Calls `job(i)` for each i in [0, count), spread across the workers.
+        /// The calling thread takes its share of the work, so it is safe to call
+        /// this function from a job already running in the pool.
+        template <typename F>
+        void parallelFor(const size_t count, F&& job)
+        {
+            if (0 == count)
+                return;
+            if (1 == count)
+            {
+                job(static_cast<size_t>(0));
+                return;
+            }
+            struct SharedState
+            {
+                std::atomic<size_t> next{0};
+                std::atomic<size_t> done{0};
+                std::mutex done_mutex;
+                std::condition_variable done_cv;
+            };
+            auto state = std::make_shared<SharedState>();
+            auto run = [state, count, &job]() {
+                size_t processed = 0;
+                for (size_t i = state->next++; i < count; i = state->next++)
+                {
+                    job(i);
+                    ++processed;
+                }
+                if (processed > 0 && (state->done += processed) == count)
+                {
+                    std::lock_guard<std::mutex> lock(state->done_mutex);
+                    state->done_cv.notify_all();
+                }
+            };
+            const size_t nb_helpers = std::min(count - 1, static_cast<size_t>(size()));
+            {
+                std::lock_guard<std::mutex> lock(m_jobs_mutex);
+                for (size_t i = 0; i < nb_helpers; ++i)
+                    m_jobs.emplace_back(run);
+            }
+            m_jobs_cv.notify_all();
+            run();
+            // Helpers that did not grab any index before the end are harmless:
+            // they only read `state`, which they keep alive
+            std::unique_lock<std::mutex> lock(state->done_mutex);
+            state->done_cv.wait(lock, [&state, count] { return state->done.load() == count; });
+        }
+    };
+} // namespace ftstd
+
+#endif // _thread_pool_hpp
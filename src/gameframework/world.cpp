@@ -37,14 +37,76 @@ void frametech::gameframework::World::setup() noexcept
 
 void frametech::gameframework::World::clean() noexcept
 {
-    if (!m_textures_cache.empty())
+    m_textures_cache.clear();
+    m_texture_residency.clear();
+    m_placeholder_texture = frametech::engine::graphics::INVALID_TEXTURE_HANDLE;
+}
+
+ftstd::VResult frametech::gameframework::World::createPlaceholderTexture() noexcept
+{
+    // Grey checkerboard, 8x8 texels
+    constexpr u32 placeholder_size = 8;
+    std::vector<unsigned char> pixels(placeholder_size * placeholder_size * 4);
+    for (u32 y = 0; y < placeholder_size; ++y)
     {
-        for (const auto& [key, value] : m_textures_cache)
+        for (u32 x = 0; x < placeholder_size; ++x)
         {
-            delete value;
+            const unsigned char value = 0 == ((x + y) & 1) ? 96 : 160;
+            unsigned char* pixel = &pixels[(y * placeholder_size + x) * 4];
+            pixel[0] = value;
+            pixel[1] = value;
+            pixel[2] = value;
+            pixel[3] = 255;
         }
-        m_textures_cache.clear();
     }
+    auto* texture = new frametech::engine::graphics::Texture();
+    if (const auto result = texture->fromPixels(pixels.data(), placeholder_size, placeholder_size, 1, false, "placeholder"); result.IsError())
+    {
+        delete texture;
+        return result;
+    }
+    if (const auto result = texture->upload(frametech::engine::graphics::Texture::Type::T2D, VK_FORMAT_R8G8B8A8_SRGB); result.IsError())
+    {
+        delete texture;
+        return result;
+    }
+    m_placeholder_texture = m_texture_residency.addResident(texture);
+    return ftstd::VResult::Ok();
+}
+
+void frametech::gameframework::World::setTextureRegion(const std::string& name, const frametech::engine::graphics::TextureRegion& region) noexcept
+{
+    if (const auto cached_region = m_textures_cache.find(name); cached_region != m_textures_cache.end())
+    {
+        // Atlas pages are shared with other regions: only standalone textures can go
+        if (!cached_region->second.m_is_atlas_page && cached_region->second.m_texture != region.m_texture)
+            m_texture_residency.remove(cached_region->second.m_texture);
+        const frametech::engine::graphics::TextureHandle standalone_texture = cached_region->second.m_standalone_texture;
+        if (frametech::engine::graphics::INVALID_TEXTURE_HANDLE != standalone_texture &&
+            standalone_texture != region.m_texture && standalone_texture != region.m_standalone_texture)
+            m_texture_residency.remove(standalone_texture);
+    }
+    m_textures_cache[name] = region;
+}
+
+std::optional<frametech::engine::graphics::TextureRegion> frametech::gameframework::World::getSampledRegion(const std::string& name, const bool has_uvs_in_unit_square) const noexcept
+{
+    const auto region = m_textures_cache.find(name);
+    if (region == m_textures_cache.end())
+        return std::nullopt;
+    // The sampler would repeat the whole atlas page: the whole texture is sampled instead
+    if (!has_uvs_in_unit_square && region->second.m_is_atlas_page && frametech::engine::graphics::INVALID_TEXTURE_HANDLE != region->second.m_standalone_texture)
+        return frametech::engine::graphics::TextureRegion{.m_texture = region->second.m_standalone_texture};
+    return region->second;
+}
+
+frametech::engine::graphics::Texture* frametech::gameframework::World::requestTexture(const std::string& name, const bool has_uvs_in_unit_square) noexcept
+{
+    const auto region = getSampledRegion(name, has_uvs_in_unit_square);
+    frametech::engine::graphics::Texture* texture = region.has_value() ? m_texture_residency.request(region->m_texture) : nullptr;
+    if (nullptr == texture)
+        texture = m_texture_residency.request(m_placeholder_texture);
+    return texture;
 }
 
 bool frametech::gameframework::World::hasBeenSetup() const noexcept
@@ -10,10 +10,13 @@
 #define _world_hpp
 
 #include "../engine/graphics/texture.hpp"
+#include "../engine/graphics/texture_atlas.hpp"
+#include "../engine/graphics/texture_residency.hpp"
 #include "camera.hpp"
 #include "movable.hpp"
 #include <map> // For cache maps
 #include <optional>
+#include <vector>
 
 namespace frametech
 {
@@ -44,8 +47,28 @@ namespace frametech
             /// @return A boolean value
             bool hasBeenSetup() const noexcept;
             /// @brief Textures cache, attached to the world
-            /// Each texture is a unique_ptr used by anywhere here
-            std::map<std::string, frametech::engine::graphics::Texture*> m_textures_cache;
+            /// Each name maps to the region to sample: a sub-rectangle of an atlas page,
+            /// or a whole standalone texture. The textures are registered in m_texture_residency.
+            std::map<std::string, frametech::engine::graphics::TextureRegion> m_textures_cache;
+            /// @brief Returns the residency manager of the textures of the world
+            frametech::engine::graphics::TextureResidency& getTextureResidency() noexcept { return m_texture_residency; }
+            /// @brief Registers, or replaces, the region to sample for `name`.
+            /// A replaced standalone texture is unregistered.
+            /// @param name The name of the texture
+            /// @param region The region to sample - its texture should be registered in the world
+            void setTextureRegion(const std::string& name, const frametech::engine::graphics::TextureRegion& region) noexcept;
+            /// @brief Creates and uploads the placeholder texture - the engine must be initialized
+            /// @return A VResult type
+            ftstd::VResult createPlaceholderTexture() noexcept;
+            /// @brief Returns the region to sample for `name`
+            /// @param has_uvs_in_unit_square If the UVs of the mesh are all in [0, 1] - otherwise, a region
+            /// of an atlas page is replaced by its standalone texture
+            /// @return The region, or std::nullopt if there is no such texture
+            std::optional<frametech::engine::graphics::TextureRegion> getSampledRegion(const std::string& name, const bool has_uvs_in_unit_square) const noexcept;
+            /// @brief Returns the texture of the region `name` to sample (see getSampledRegion), uploaded if needed
+            /// @return The placeholder texture if there is no such texture (not loaded yet), or if
+            /// it cannot be loaded - nullptr if there is no placeholder either
+            frametech::engine::graphics::Texture* requestTexture(const std::string& name, const bool has_uvs_in_unit_square = true) noexcept;
             /// @brief Returns m_selected_texture
             /// @return A standard string object
             std::string getSelectedTexture() const noexcept { return m_selected_texture; };
@@ -63,6 +86,11 @@ namespace frametech
             bool m_has_been_setup = false;
             /// @brief Current selected texture (one for all objects)
             std::string m_selected_texture;
+            /// @brief Textures of the world, referenced by m_textures_cache - only the
+            /// requested ones stay in video memory
+            frametech::engine::graphics::TextureResidency m_texture_residency;
+            /// @brief Sampled while the selected texture is not available
+            frametech::engine::graphics::TextureHandle m_placeholder_texture = frametech::engine::graphics::INVALID_TEXTURE_HANDLE;
         };
     } // namespace gameframework
 } // namespace frametech
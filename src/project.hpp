@@ -60,6 +60,12 @@ namespace Project
         std::optional<u8> fps_target;
         /// @brief All the asset archives to load
         std::vector<std::string> asset_folders;
+        /// @brief Video memory budget of the streamed textures, in MB - the engine default if unset
+        std::optional<u32> texture_budget_mb;
+        /// @brief Video memory of the vertex buffer shared by the meshes, in MB - the engine default if unset
+        std::optional<u32> vertex_pool_mb;
+        /// @brief Video memory of each index buffer shared by the meshes, in MB - the engine default if unset
+        std::optional<u32> index_pool_mb;
         /// @brief Application version
         ftstd::Version version;
 
@@ -95,6 +101,9 @@ namespace Project
                 return ftstd::VResult::Error((char*)"The game settings file does not contain any application version (REQUIRED)");
             }
             this->version = ftstd::Version(raw_version.value());
+            this->texture_budget_mb = toml_config["APPLICATION_TEXTURE_BUDGET_MB"].value<u32>();
+            this->vertex_pool_mb = toml_config["APPLICATION_VERTEX_POOL_MB"].value<u32>();
+            this->index_pool_mb = toml_config["APPLICATION_INDEX_POOL_MB"].value<u32>();
             auto assets = toml_config["APPLICATION_DEPENDENCIES"];
             if (toml::array* assets_array = assets.as_array())
             {
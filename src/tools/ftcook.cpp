@@ -0,0 +1,392 @@
+//
+//  ftcook.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+// Cooks the raw assets of a game project into engine-ready files:
+//     ftcook [--force] [--no-compress] <game.toml> <output folder>
+// Each asset folder of APPLICATION_DEPENDENCIES is cooked in the same folder of the output folder:
+// - the OBJ files are imported (see MeshUtils::importObj) in binary mesh files, named like the
+//   cache of MeshUtils::loadFromFile,
+// - the PNG / JPG / TGA / BMP files are decoded, mipmapped and compressed to BC1 / BC3 blocks
+//   (but the ones small enough to be packed in an atlas page) in texture files,
+// - the other files are copied.
+// Each cooked folder gets a manifest (see AssetManifest): an asset is only cooked again once its
+// content, or the cooking, changed. The assets are cooked in parallel, on the thread pool.
+// The game.toml file is copied as well: the output folder is a project that only maps and uploads.
+
+#include "../engine/asset_archive.hpp"
+#include "../engine/asset_manifest.hpp"
+#include "../engine/graphics/mesh.hpp"
+#include "../engine/graphics/mip_generator.hpp"
+#include "../engine/graphics/texture_atlas.hpp"
+#include "../engine/graphics/texture_compressor.hpp"
+#include "../engine/graphics/texture_file.hpp"
+#include "../ftstd/debug_tools.h"
+#include "../ftstd/hash.hpp"
+#include "../ftstd/mapped_file.hpp"
+#include "../ftstd/thread_pool.hpp"
+#include "../ftstd/timer.h"
+#include "../project.hpp"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// The tool does not link the engine: the decoder of stb_image is built here
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb/stb_image.h>
+
+using frametech::engine::AssetManifest;
+using frametech::engine::AssetManifestEntry;
+using frametech::engine::CookedAssetType;
+
+namespace
+{
+    /// @brief Version of the cooking - bump it when the cooking changes, to cook every asset again
+    constexpr u32 COOK_VERSION = 1;
+
+    /// @brief An asset to cook
+    struct CookJob
+    {
+        /// @brief The cooked asset folder of the asset
+        std::filesystem::path m_output_folder;
+        /// @brief Path of the source file
+        std::filesystem::path m_source_path;
+        /// @brief The manifest entry of the asset - m_source and m_output set when listed
+        AssetManifestEntry m_entry;
+        /// @brief The entry of the previous cooking, if any
+        const AssetManifestEntry* m_previous_entry = nullptr;
+        /// @brief Set if the previous cooking is still valid
+        bool m_up_to_date = false;
+        /// @brief Set if the cooking failed
+        bool m_failed = false;
+    };
+
+    /// @brief A cooked asset folder
+    struct CookFolder
+    {
+        /// @brief Name of the folder, as in game.toml
+        std::string m_name;
+        /// @brief The manifest of the previous cooking
+        AssetManifest m_previous_manifest;
+    };
+
+    /// @brief Prints how to call the tool
+    void printUsage(const char* program)
+    {
+        fprintf(stderr, "usage: %s [--force] [--no-compress] <game.toml> <output folder>\n", program);
+    }
+
+    /// @brief Returns how a file is cooked, from its extension - false if the file is not an asset
+    bool getCookedAssetType(const std::filesystem::path& path, CookedAssetType& type)
+    {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](const unsigned char c) { return static_cast<char>(tolower(c)); });
+        // Caches of the runtime and leftovers of an interrupted cooking
+        if (frametech::graphics::MeshFile::MESH_FILE_EXTENSION == extension ||
+            frametech::engine::graphics::TextureFile::TEXTURE_FILE_EXTENSION == extension ||
+            ".tmp" == extension ||
+            AssetManifest::ASSET_MANIFEST_FILENAME == path.filename().string())
+            return false;
+        if (".obj" == extension)
+            type = CookedAssetType::MESH;
+        else if (".png" == extension || ".jpg" == extension || ".jpeg" == extension || ".tga" == extension || ".bmp" == extension)
+            type = CookedAssetType::TEXTURE;
+        else
+            type = CookedAssetType::FILE;
+        return true;
+    }
+
+    /// @brief Returns the path of the cooked file of `source`, relative to its asset folder
+    std::string getOutputName(const std::string& source, const CookedAssetType type)
+    {
+        switch (type)
+        {
+            case CookedAssetType::MESH:
+                return frametech::graphics::MeshFile::getCachePath(source.c_str());
+            case CookedAssetType::TEXTURE:
+                // Keeps the name of the source: the textures are looked up by file name
+                return source + frametech::engine::graphics::TextureFile::TEXTURE_FILE_EXTENSION;
+            default:
+                return source;
+        }
+    }
+
+    /// @brief Decodes the image `content`, generates its mip chain and compresses it (if `compress`
+    /// is set and the texture is too big for the atlas pages) in the texture file at `output_path`
+    /// @param memory_size The size of the mip chain, in bytes
+    /// @return A VResult type
+    ftstd::VResult cookTexture(const char* content, const u64 content_size, const char* output_path, const bool compress, u64& memory_size)
+    {
+        using namespace frametech::engine::graphics;
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        unsigned char* pixels = stbi_load_from_memory((const unsigned char*)content, static_cast<int>(content_size), &width, &height, &channels, STBI_rgb_alpha);
+        if (nullptr == pixels)
+            return ftstd::VResult::Error((char*)"cannot decode the image");
+        std::vector<unsigned char> chain;
+        std::vector<TextureMipLevel> levels;
+        const auto result = MipGenerator::generate(pixels, static_cast<u32>(width), static_cast<u32>(height), 4, chain, levels);
+        stbi_image_free(pixels);
+        if (result.IsError())
+            return result;
+
+        // The small textures are packed in atlas pages at runtime, from their decoded texels
+        if (!compress || (static_cast<u32>(width) <= TextureAtlas::ATLAS_MAX_TEXTURE_SIZE && static_cast<u32>(height) <= TextureAtlas::ATLAS_MAX_TEXTURE_SIZE))
+        {
+            memory_size = MipGenerator::getChainSize(levels);
+            return TextureFile::write(output_path,
+                                      TextureFileFormat::RGBA8,
+                                      static_cast<u32>(width),
+                                      static_cast<u32>(height),
+                                      static_cast<u32>(channels),
+                                      static_cast<u32>(levels.size()),
+                                      chain.data(),
+                                      memory_size);
+        }
+        // Alpha blocks are twice bigger: only use them if the source has an alpha channel
+        const TextureBlockFormat block_format = (4 == channels || 2 == channels) ? TextureBlockFormat::BC3 : TextureBlockFormat::BC1;
+        std::vector<unsigned char> blocks;
+        std::vector<TextureMipLevel> block_levels;
+        if (const auto compressed = TextureCompressor::compress(chain.data(), levels, 4, block_format, blocks, block_levels); compressed.IsError())
+            return compressed;
+        memory_size = MipGenerator::getChainSize(block_levels);
+        return TextureFile::write(output_path,
+                                  static_cast<TextureFileFormat>(block_format),
+                                  static_cast<u32>(width),
+                                  static_cast<u32>(height),
+                                  static_cast<u32>(channels),
+                                  static_cast<u32>(block_levels.size()),
+                                  blocks.data(),
+                                  memory_size);
+    }
+
+    /// @brief Imports the OBJ `content` in the binary mesh file at `output_path`
+    /// @param memory_size The size of the vertices and of the 32 bits indices, in bytes
+    /// @return A VResult type
+    ftstd::VResult cookMesh(const char* content, const u64 content_size, const char* name, const char* output_path, u64& memory_size)
+    {
+        const frametech::graphics::MeshImportSettings settings{};
+        auto imported = frametech::graphics::MeshUtils::importObj(content, content_size, name, settings);
+        if (imported.IsError())
+            return ftstd::VResult::Error((char*)"cannot import the mesh");
+        const frametech::graphics::Mesh mesh = imported.GetValue();
+        memory_size = mesh.getVerticesCount() * sizeof(frametech::engine::graphics::shaders::Vertex) + mesh.getIndicesCount() * sizeof(u32);
+        return frametech::graphics::MeshFile::write(output_path, mesh, frametech::graphics::MeshUtils::getSettingsHash(settings));
+    }
+
+    /// @brief Cooks the asset of `job`, unless its previous cooking is still valid
+    void cook(CookJob& job, const u64 settings_hash, const bool force, const bool compress)
+    {
+        AssetManifestEntry& entry = job.m_entry;
+        const std::filesystem::path output_path = job.m_output_folder / entry.m_output;
+        std::error_code error;
+        ftstd::MappedFile source_file;
+        const u64 source_size = std::filesystem::file_size(job.m_source_path, error);
+        if (error || (source_size > 0 && source_file.open(job.m_source_path.string().c_str(), ftstd::MappedFile::Access::SEQUENTIAL).IsError()))
+        {
+            LogE("Cannot read the asset '%s'", job.m_source_path.string().c_str());
+            job.m_failed = true;
+            return;
+        }
+        const char* content = source_size > 0 ? source_file.data() : "";
+        entry.m_source_hash = ftstd::hash::xxh64(content, source_size, settings_hash);
+
+        const AssetManifestEntry* previous_entry = job.m_previous_entry;
+        if (!force && nullptr != previous_entry &&
+            previous_entry->m_type == entry.m_type &&
+            previous_entry->m_output == entry.m_output &&
+            previous_entry->m_source_hash == entry.m_source_hash &&
+            std::filesystem::file_size(output_path, error) == previous_entry->m_file_size && !error)
+        {
+            entry = *previous_entry;
+            job.m_up_to_date = true;
+            return;
+        }
+
+        ftstd::VResult result = ftstd::VResult::Ok();
+        switch (entry.m_type)
+        {
+            case CookedAssetType::MESH:
+                result = cookMesh(content, source_size, job.m_source_path.string().c_str(), output_path.string().c_str(), entry.m_memory_size);
+                break;
+            case CookedAssetType::TEXTURE:
+                result = cookTexture(content, source_size, output_path.string().c_str(), compress, entry.m_memory_size);
+                break;
+            default:
+                entry.m_memory_size = 0;
+                if (!std::filesystem::copy_file(job.m_source_path, output_path, std::filesystem::copy_options::overwrite_existing, error))
+                    result = ftstd::VResult::Error((char*)"cannot copy the file");
+                break;
+        }
+        entry.m_file_size = result.IsError() ? 0 : std::filesystem::file_size(output_path, error);
+        if (result.IsError() || error)
+        {
+            LogE("Cannot cook the asset '%s': %s", job.m_source_path.string().c_str(), result.IsError() ? result.GetError() : "cannot read the cooked file");
+            job.m_failed = true;
+            return;
+        }
+        Log("> Cooked '%s' to '%s'", job.m_source_path.string().c_str(), output_path.string().c_str());
+    }
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+    bool force = false;
+    bool compress = true;
+    std::vector<const char*> positional_arguments;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (0 == strcmp(argv[i], "--force"))
+            force = true;
+        else if (0 == strcmp(argv[i], "--no-compress"))
+            compress = false;
+        else
+            positional_arguments.push_back(argv[i]);
+    }
+    if (positional_arguments.size() != 2)
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const std::filesystem::path game_settings_path = positional_arguments[0];
+    const std::filesystem::path output_root = positional_arguments[1];
+    Project::GameProjectSettings game_settings;
+    if (auto result = game_settings.loadFrom(game_settings_path.string().c_str()); result.IsError())
+    {
+        LogE("Cannot load the project settings '%s': %s", game_settings_path.string().c_str(), result.GetError());
+        return EXIT_FAILURE;
+    }
+    // The asset folders are relative to the project
+    const std::filesystem::path project_root = game_settings_path.parent_path();
+    std::error_code error;
+    std::filesystem::create_directories(output_root, error);
+    if (error || !std::filesystem::copy_file(game_settings_path, output_root / game_settings_path.filename(), std::filesystem::copy_options::overwrite_existing, error))
+    {
+        LogE("Cannot copy the project settings in '%s'", output_root.string().c_str());
+        return EXIT_FAILURE;
+    }
+
+    // The cooking settings seed the hash of each asset: changing them cooks everything again
+    const u32 settings[] = {COOK_VERSION, frametech::graphics::MeshFile::MESH_FILE_VERSION, frametech::engine::graphics::TextureFile::TEXTURE_FILE_VERSION, compress ? 1u : 0u};
+    const u64 settings_hash = ftstd::hash::xxh64(settings, sizeof(settings));
+
+    // List the assets of every folder, with their previous cooking
+    std::vector<CookFolder> folders(game_settings.asset_folders.size());
+    std::vector<CookJob> jobs;
+    for (size_t folder_index = 0; folder_index < folders.size(); ++folder_index)
+    {
+        CookFolder& folder = folders[folder_index];
+        folder.m_name = game_settings.asset_folders[folder_index];
+        const std::filesystem::path source_folder = project_root / folder.m_name;
+        const std::filesystem::path output_folder = output_root / folder.m_name;
+        if (!std::filesystem::is_directory(source_folder, error))
+        {
+            // Asset archives are packed already: they are copied as they are
+            if (frametech::engine::AssetArchive::isAssetArchive(folder.m_name.c_str()) &&
+                std::filesystem::copy_file(source_folder, output_folder, std::filesystem::copy_options::update_existing, error))
+                continue;
+            LogE("'%s' is not a directory", source_folder.string().c_str());
+            return EXIT_FAILURE;
+        }
+        // Missing or outdated: everything is cooked again
+        folder.m_previous_manifest.read((output_folder / AssetManifest::ASSET_MANIFEST_FILENAME).string().c_str());
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(source_folder, error))
+        {
+            CookedAssetType type = CookedAssetType::FILE;
+            if (!entry.is_regular_file(error) || !getCookedAssetType(entry.path(), type))
+                continue;
+            CookJob job{
+                .m_output_folder = output_folder,
+                .m_source_path = entry.path(),
+            };
+            job.m_entry.m_type = type;
+            job.m_entry.m_source = entry.path().lexically_relative(source_folder).generic_string();
+            job.m_entry.m_output = getOutputName(job.m_entry.m_source, type);
+            // Created before the cooking starts: the jobs only write files
+            std::filesystem::create_directories((output_folder / job.m_entry.m_output).parent_path(), error);
+            if (error)
+            {
+                LogE("Cannot create the folder of '%s'", (output_folder / job.m_entry.m_output).string().c_str());
+                return EXIT_FAILURE;
+            }
+            jobs.push_back(std::move(job));
+        }
+        if (error)
+        {
+            LogE("Cannot list the folder '%s'", source_folder.string().c_str());
+            return EXIT_FAILURE;
+        }
+    }
+    // The manifests of the folders are not modified anymore: the previous entries can be referenced
+    for (CookJob& job : jobs)
+    {
+        for (const CookFolder& folder : folders)
+        {
+            if (job.m_output_folder == output_root / folder.m_name)
+                job.m_previous_entry = folder.m_previous_manifest.find(job.m_entry.m_source);
+        }
+    }
+
+    ftstd::Timer timer;
+    ftstd::ThreadPool* thread_pool = ftstd::ThreadPool::getInstance();
+    thread_pool->parallelFor(jobs.size(), [&jobs, settings_hash, force, compress](const size_t job_index) {
+        cook(jobs[job_index], settings_hash, force, compress);
+    });
+
+    // One manifest per folder, sorted by source - the outputs of the removed sources are removed too
+    u32 nb_cooked = 0;
+    u32 nb_up_to_date = 0;
+    u32 nb_failed = 0;
+    u64 cooked_size = 0;
+    for (const CookFolder& folder : folders)
+    {
+        const std::filesystem::path output_folder = output_root / folder.m_name;
+        if (!std::filesystem::is_directory(output_folder, error))
+            continue;
+        std::map<std::string, const AssetManifestEntry*> entries;
+        for (const CookJob& job : jobs)
+        {
+            if (job.m_output_folder != output_folder)
+                continue;
+            nb_failed += job.m_failed ? 1 : 0;
+            nb_up_to_date += job.m_up_to_date ? 1 : 0;
+            nb_cooked += job.m_failed || job.m_up_to_date ? 0 : 1;
+            if (job.m_failed)
+                continue;
+            entries[job.m_entry.m_source] = &job.m_entry;
+            cooked_size += job.m_entry.m_file_size;
+        }
+        AssetManifest manifest;
+        for (const auto& [source, entry] : entries)
+            manifest.add(*entry);
+        for (const AssetManifestEntry& previous_entry : folder.m_previous_manifest.getEntries())
+        {
+            if (nullptr == manifest.find(previous_entry.m_source))
+                std::filesystem::remove(output_folder / previous_entry.m_output, error);
+        }
+        if (auto result = manifest.write((output_folder / AssetManifest::ASSET_MANIFEST_FILENAME).string().c_str()); result.IsError())
+        {
+            LogE("Cannot write the manifest of '%s': %s", output_folder.string().c_str(), result.GetError());
+            return EXIT_FAILURE;
+        }
+    }
+    printf("%s: %u assets cooked, %u up-to-date, %u failed (%llu kB) in %llu ms on %u threads\n",
+           output_root.string().c_str(),
+           nb_cooked,
+           nb_up_to_date,
+           nb_failed,
+           cooked_size >> 10,
+           timer.diff(),
+           thread_pool->size());
+    return 0 == nb_failed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,82 @@
+//
+//  ftpack.cpp
+//  FrameTech
+//
+//  Created by Antonin on 16/10/2026.
+//
+
+// Builds an asset archive (.ftpak) from asset folders:
+//     ftpack [--compress] <archive.ftpak> <folder> [<folder>...]
+// The entries are named after their path in their folder ('/' separators).
+// With multiple folders, a file overrides the file with the same name in a previous folder.
+
+#include "../engine/asset_archive.hpp"
+#include "../ftstd/debug_tools.h"
+#include <filesystem>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+// The tool does not link the engine: the zlib decoder of stb_image is built here
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb/stb_image.h>
+
+/// @brief Prints how to call the tool
+static void printUsage(const char* program)
+{
+    fprintf(stderr, "usage: %s [--compress] <archive%s> <folder> [<folder>...]\n", program, frametech::engine::AssetArchive::ASSET_ARCHIVE_EXTENSION);
+}
+
+int main(int argc, const char* argv[])
+{
+    bool compress = false;
+    std::vector<const char*> positional_arguments;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (0 == strcmp(argv[i], "--compress"))
+            compress = true;
+        else
+            positional_arguments.push_back(argv[i]);
+    }
+    if (positional_arguments.size() < 2)
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char* archive_path = positional_arguments[0];
+    std::vector<frametech::engine::AssetArchiveSource> sources;
+    for (size_t folder_index = 1; folder_index < positional_arguments.size(); ++folder_index)
+    {
+        const std::filesystem::path folder = positional_arguments[folder_index];
+        std::error_code error;
+        if (!std::filesystem::is_directory(folder, error))
+        {
+            LogE("'%s' is not a directory", folder.string().c_str());
+            return EXIT_FAILURE;
+        }
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(folder, error))
+        {
+            if (!entry.is_regular_file(error))
+                continue;
+            sources.push_back(frametech::engine::AssetArchiveSource{
+                .m_name = entry.path().lexically_relative(folder).generic_string(),
+                .m_path = entry.path().string(),
+            });
+        }
+        if (error)
+        {
+            LogE("Cannot list the folder '%s'", folder.string().c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    const size_t nb_sources = sources.size();
+    if (auto result = frametech::engine::AssetArchive::write(archive_path, std::move(sources), compress); result.IsError())
+    {
+        LogE("Cannot write the asset archive '%s': %s", archive_path, result.GetError());
+        return EXIT_FAILURE;
+    }
+    printf("%s: %zu files packed\n", archive_path, nb_sources);
+    return EXIT_SUCCESS;
+}